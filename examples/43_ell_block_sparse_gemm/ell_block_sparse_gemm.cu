@@ -80,12 +80,11 @@
 #include "cutlass/util/device_memory.h"
 #include "cutlass/util/tensor_view_io.h"
 #include "cutlass/util/host_tensor.h"
-#include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/ell_gemm.h"
 #include "cutlass/util/reference/host/tensor_compare.h"
 #include "cutlass/util/reference/host/tensor_copy.h"
 #include "cutlass/util/reference/host/tensor_fill.h"
 #include "cutlass/util/reference/host/tensor_norm.h"
-#include "cutlass/util/host_uncompress.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -250,7 +249,6 @@ private:
   cutlass::HostTensor<ElementC, LayoutC> tensor_c;
   cutlass::HostTensor<ElementC, LayoutC> tensor_d;
 
-  cutlass::HostTensor<ElementA, LayoutA> tensor_a_uncompressed;
   cutlass::HostTensor<ElementC, LayoutC> reference_d;
 
   cutlass::HostTensor<int32_t, LayoutA> tensor_ell_idx;
@@ -334,7 +332,6 @@ private:
     tensor_c.resize(cutlass::make_Coord(options.a_rows, options.n));
     tensor_d.resize(cutlass::make_Coord(options.a_rows, options.n));
 
-    tensor_a_uncompressed.resize(cutlass::make_Coord(options.a_rows, options.a_cols));
     reference_d.resize(cutlass::make_Coord(options.a_rows, options.n));
 
     tensor_ell_idx.resize(cutlass::make_Coord(options.a_rows / options.a_ell_blocksize,
@@ -377,28 +374,21 @@ private:
 
     tensor_d.sync_host();
 
-    cutlass::uncompress_ell_block_sparse(
-          tensor_a_uncompressed.host_ref(),
-          tensor_a.host_ref(),
-          tensor_ell_idx.host_ref(),
-          options.a_rows,
-          options.a_cols,
-          options.a_ell_num_columns,
-          options.a_ell_blocksize
-    );
-
-    cutlass::reference::host::Gemm<
-        typename Gemm::ElementA, typename Gemm::LayoutA,                                             
-        typename Gemm::ElementB, typename Gemm::LayoutB,                                             
-        typename Gemm::ElementC, typename Gemm::LayoutC,                                             
+    cutlass::reference::host::EllGemm<
+        typename Gemm::ElementA, typename Gemm::LayoutA,
+        typename Gemm::ElementB, typename Gemm::LayoutB,
+        typename Gemm::ElementC, typename Gemm::LayoutC,
         ElementCompute,
-        ElementAccumulator, typename Gemm::Operator>                                                 
-        reference_gemm;                                                                              
-    
-    reference_gemm(                                                                                  
+        ElementAccumulator, typename Gemm::Operator>
+        reference_gemm;
+
+    reference_gemm(
       {options.a_rows, options.n, options.a_cols},
-      options.alpha, 
-      tensor_a_uncompressed.host_ref(), 
+      options.alpha,
+      tensor_a.host_ref(),
+      tensor_ell_idx.host_ref(),
+      options.a_ell_num_columns,
+      options.a_ell_blocksize,
       tensor_b.host_ref(),
       options.beta,
       reference_d.host_ref(),
@@ -0,0 +1,1008 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Templates exposing x86 SIMD implementations of elementwise operators in host code
+
+    The Array specializations of the functional.h operators use these to process float, half_t,
+    bfloat16_t, int32_t and int8_t elements with AVX2 and AVX-512 in host code. Because the
+    operators are inlined into their callers, the instructions are selected at compile time from
+    the extensions targeted by the host compiler (e.g. -mavx2 -mf16c, or -march=native) and are
+    enabled by defining CUTLASS_ENABLE_HOST_SIMD=1. The Array<..., 4> NumericArrayConverter
+    specializations use them to encode float, half_t and bfloat16_t to float_e4m3_t and
+    float_e5m2_t.
+
+    Complex and quaternion elements of float and double are split into one AVX2 register per
+    component, so that multiply_add and conjugate operate on whole registers. These functions
+    carry a target attribute and are defined whenever CUTLASS_ENABLE_HOST_SIMD=1 on x86-64, as
+    the host GEMM reference in tools/util also calls them from kernels it selects at run time.
+
+    Each operation is rounded as written in the scalar operators: half_t and bfloat16_t operate in
+    float and round each intermediate result to nearest even, and the products of multiply_add
+    are rounded before they are added, even where the target has FMA. A host compiler contracting
+    the scalar expression a * b + c into a fused multiply-add (e.g. GCC, unless
+    -ffp-contract=off) may therefore compute a different result for the scalar operator. NaN
+    payloads of half_t results may differ from the software conversion, as with
+    CUTLASS_ENABLE_F16C.
+*/
+
+#pragma once
+
+#include "cutlass/cutlass.h"
+#include "cutlass/functional.h"
+#include "cutlass/numeric_types.h"
+
+#ifndef CUTLASS_ENABLE_HOST_SIMD
+#define CUTLASS_ENABLE_HOST_SIMD 0
+#endif
+
+#if CUTLASS_ENABLE_HOST_SIMD && !defined(__CUDA_ARCH__) && !defined(__CUDACC_RTC__) && \
+    (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define CUTLASS_ARCH_SIMD_X86_TARGETS 1
+#else
+#define CUTLASS_ARCH_SIMD_X86_TARGETS 0
+#endif
+
+#if CUTLASS_ARCH_SIMD_X86_TARGETS && defined(__AVX2__)
+#define CUTLASS_ARCH_SIMD_X86 1
+#else
+#define CUTLASS_ARCH_SIMD_X86 0
+#endif
+
+#if CUTLASS_ARCH_SIMD_X86_TARGETS
+
+#include <immintrin.h>
+
+// Functions shared with host code that selects AVX2 at run time carry a target attribute, so
+// they may be inlined into callers compiled for AVX2 either way.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CUTLASS_ARCH_SIMD_TARGET_AVX2
+#else
+#define CUTLASS_ARCH_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace cutlass {
+
+template <typename T>
+class complex;
+
+template <typename Element_>
+class Quaternion;
+
+namespace arch {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns a vector the compiler may not fold into subsequent arithmetic. GCC otherwise contracts
+/// a multiplication and an addition intrinsic into a fused multiply-add whenever the target has
+/// FMA. Without FMA there is nothing to prevent, and the barrier would only constrain register
+/// allocation.
+template <typename Vector>
+CUTLASS_ARCH_SIMD_TARGET_AVX2
+inline Vector host_simd_opaque(Vector x) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__FMA__) || defined(__AVX512F__))
+  __asm__("" : "+v"(x));
+#endif
+  return x;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Registers holding one component each of a group of complex or quaternion elements
+template <typename Register, int Components>
+struct HostSimdSplitVector {
+  Register component[Components];
+};
+
+/// AVX2 registers of float or double holding one component of kLanes complex or quaternion
+/// elements. Loads permute the lanes of the component registers identically for every operand
+/// and stores restore the original order, so elementwise arithmetic does not observe the order.
+template <typename T>
+struct HostSimdSplit {
+  static bool const kEnabled = false;
+};
+
+template <>
+struct HostSimdSplit<float> {
+
+  static bool const kEnabled = true;
+  static int const kLanes = 8;
+
+  using Register = __m256;
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register broadcast(float x) {
+    return _mm256_set1_ps(x);
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register add(Register a, Register b) {
+    return _mm256_add_ps(a, b);
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register sub(Register a, Register b) {
+    return _mm256_sub_ps(a, b);
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register neg(Register a) {
+    return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f));
+  }
+
+  /// Returns c + a * b with the product rounded
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register multiply_add(Register a, Register b, Register c) {
+    return _mm256_add_ps(c, host_simd_opaque(_mm256_mul_ps(a, b)));
+  }
+
+  /// Returns c - a * b with the product rounded
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register multiply_subtract(Register a, Register b, Register c) {
+    return _mm256_sub_ps(c, host_simd_opaque(_mm256_mul_ps(a, b)));
+  }
+
+  /// Splits complex elements into real and imaginary parts
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static HostSimdSplitVector<Register, 2> load(complex<float> const *ptr) {
+    Register v0 = _mm256_loadu_ps(reinterpret_cast<float const *>(ptr));
+    Register v1 = _mm256_loadu_ps(reinterpret_cast<float const *>(ptr) + 8);
+    return HostSimdSplitVector<Register, 2>{
+      {_mm256_shuffle_ps(v0, v1, 0x88), _mm256_shuffle_ps(v0, v1, 0xdd)}};
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static void store(complex<float> *ptr, HostSimdSplitVector<Register, 2> const &v) {
+    float *p = reinterpret_cast<float *>(ptr);
+    _mm256_storeu_ps(p, _mm256_unpacklo_ps(v.component[0], v.component[1]));
+    _mm256_storeu_ps(p + 8, _mm256_unpackhi_ps(v.component[0], v.component[1]));
+  }
+
+  /// Transposes the 4-by-4 blocks in each 128-bit half of four registers
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static HostSimdSplitVector<Register, 4> transpose(
+    Register r0, Register r1, Register r2, Register r3) {
+    Register t0 = _mm256_unpacklo_ps(r0, r1);
+    Register t1 = _mm256_unpacklo_ps(r2, r3);
+    Register t2 = _mm256_unpackhi_ps(r0, r1);
+    Register t3 = _mm256_unpackhi_ps(r2, r3);
+    return HostSimdSplitVector<Register, 4>{{
+      _mm256_shuffle_ps(t0, t1, 0x44),
+      _mm256_shuffle_ps(t0, t1, 0xee),
+      _mm256_shuffle_ps(t2, t3, 0x44),
+      _mm256_shuffle_ps(t2, t3, 0xee)}};
+  }
+
+  /// Splits quaternions into their x, y, z and w components
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static HostSimdSplitVector<Register, 4> load(Quaternion<float> const *ptr) {
+    float const *p = reinterpret_cast<float const *>(ptr);
+    return transpose(
+      _mm256_loadu_ps(p), _mm256_loadu_ps(p + 8), _mm256_loadu_ps(p + 16), _mm256_loadu_ps(p + 24));
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static void store(Quaternion<float> *ptr, HostSimdSplitVector<Register, 4> const &v) {
+    float *p = reinterpret_cast<float *>(ptr);
+    HostSimdSplitVector<Register, 4> r =
+      transpose(v.component[0], v.component[1], v.component[2], v.component[3]);
+    for (int i = 0; i < 4; ++i) {
+      _mm256_storeu_ps(p + 8 * i, r.component[i]);
+    }
+  }
+};
+
+template <>
+struct HostSimdSplit<double> {
+
+  static bool const kEnabled = true;
+  static int const kLanes = 4;
+
+  using Register = __m256d;
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register broadcast(double x) {
+    return _mm256_set1_pd(x);
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register add(Register a, Register b) {
+    return _mm256_add_pd(a, b);
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register sub(Register a, Register b) {
+    return _mm256_sub_pd(a, b);
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register neg(Register a) {
+    return _mm256_xor_pd(a, _mm256_set1_pd(-0.0));
+  }
+
+  /// Returns c + a * b with the product rounded
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register multiply_add(Register a, Register b, Register c) {
+    return _mm256_add_pd(c, host_simd_opaque(_mm256_mul_pd(a, b)));
+  }
+
+  /// Returns c - a * b with the product rounded
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static Register multiply_subtract(Register a, Register b, Register c) {
+    return _mm256_sub_pd(c, host_simd_opaque(_mm256_mul_pd(a, b)));
+  }
+
+  /// Splits complex elements into real and imaginary parts
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static HostSimdSplitVector<Register, 2> load(complex<double> const *ptr) {
+    Register v0 = _mm256_loadu_pd(reinterpret_cast<double const *>(ptr));
+    Register v1 = _mm256_loadu_pd(reinterpret_cast<double const *>(ptr) + 4);
+    return HostSimdSplitVector<Register, 2>{
+      {_mm256_unpacklo_pd(v0, v1), _mm256_unpackhi_pd(v0, v1)}};
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static void store(complex<double> *ptr, HostSimdSplitVector<Register, 2> const &v) {
+    double *p = reinterpret_cast<double *>(ptr);
+    _mm256_storeu_pd(p, _mm256_unpacklo_pd(v.component[0], v.component[1]));
+    _mm256_storeu_pd(p + 4, _mm256_unpackhi_pd(v.component[0], v.component[1]));
+  }
+
+  /// Transposes a 4-by-4 block held in four registers
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static HostSimdSplitVector<Register, 4> transpose(
+    Register r0, Register r1, Register r2, Register r3) {
+    Register t0 = _mm256_unpacklo_pd(r0, r1);
+    Register t1 = _mm256_unpackhi_pd(r0, r1);
+    Register t2 = _mm256_unpacklo_pd(r2, r3);
+    Register t3 = _mm256_unpackhi_pd(r2, r3);
+    return HostSimdSplitVector<Register, 4>{{
+      _mm256_permute2f128_pd(t0, t2, 0x20),
+      _mm256_permute2f128_pd(t1, t3, 0x20),
+      _mm256_permute2f128_pd(t0, t2, 0x31),
+      _mm256_permute2f128_pd(t1, t3, 0x31)}};
+  }
+
+  /// Splits quaternions into their x, y, z and w components
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static HostSimdSplitVector<Register, 4> load(Quaternion<double> const *ptr) {
+    double const *p = reinterpret_cast<double const *>(ptr);
+    return transpose(
+      _mm256_loadu_pd(p), _mm256_loadu_pd(p + 4), _mm256_loadu_pd(p + 8), _mm256_loadu_pd(p + 12));
+  }
+
+  CUTLASS_ARCH_SIMD_TARGET_AVX2
+  static void store(Quaternion<double> *ptr, HostSimdSplitVector<Register, 4> const &v) {
+    double *p = reinterpret_cast<double *>(ptr);
+    HostSimdSplitVector<Register, 4> r =
+      transpose(v.component[0], v.component[1], v.component[2], v.component[3]);
+    for (int i = 0; i < 4; ++i) {
+      _mm256_storeu_pd(p + 4 * i, r.component[i]);
+    }
+  }
+};
+
+/// Broadcasts the components of a complex element or quaternion of T
+template <typename T, typename Element, int Components = sizeof(Element) / sizeof(T)>
+CUTLASS_ARCH_SIMD_TARGET_AVX2
+inline HostSimdSplitVector<typename HostSimdSplit<T>::Register, Components>
+host_simd_split_broadcast(Element const &x) {
+
+  T const *components = reinterpret_cast<T const *>(&x);
+
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, Components> v;
+  for (int i = 0; i < Components; ++i) {
+    v.component[i] = HostSimdSplit<T>::broadcast(components[i]);
+  }
+  return v;
+}
+
+/// Accumulates the complex product a * b into c in the order of multiply_add<complex<T>>
+template <typename T>
+CUTLASS_ARCH_SIMD_TARGET_AVX2
+inline void host_simd_split_multiply_add(
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 2> const &a,
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 2> const &b,
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 2> &c) {
+
+  using V = HostSimdSplit<T>;
+
+  c.component[0] = V::multiply_add(a.component[0], b.component[0], c.component[0]);
+  c.component[0] = V::multiply_subtract(a.component[1], b.component[1], c.component[0]);
+  c.component[1] = V::multiply_add(a.component[0], b.component[1], c.component[1]);
+  c.component[1] = V::multiply_add(a.component[1], b.component[0], c.component[1]);
+}
+
+/// Accumulates the quaternion product a * b into c in the order of multiply_add<Quaternion<T>>.
+/// Components are ordered x, y, z, w.
+template <typename T>
+CUTLASS_ARCH_SIMD_TARGET_AVX2
+inline void host_simd_split_multiply_add(
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 4> const &a,
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 4> const &b,
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 4> &c) {
+
+  using V = HostSimdSplit<T>;
+
+  auto const &ax = a.component[0], &ay = a.component[1], &az = a.component[2], &aw = a.component[3];
+  auto const &bx = b.component[0], &by = b.component[1], &bz = b.component[2], &bw = b.component[3];
+
+  c.component[0] = V::multiply_add(aw, bx, c.component[0]);
+  c.component[0] = V::multiply_add(bw, ax, c.component[0]);
+  c.component[0] = V::multiply_add(ay, bz, c.component[0]);
+  c.component[0] = V::multiply_subtract(az, by, c.component[0]);
+
+  c.component[1] = V::multiply_add(aw, by, c.component[1]);
+  c.component[1] = V::multiply_add(bw, ay, c.component[1]);
+  c.component[1] = V::multiply_add(az, bx, c.component[1]);
+  c.component[1] = V::multiply_subtract(ax, bz, c.component[1]);
+
+  c.component[2] = V::multiply_add(aw, bz, c.component[2]);
+  c.component[2] = V::multiply_add(bw, az, c.component[2]);
+  c.component[2] = V::multiply_add(ax, by, c.component[2]);
+  c.component[2] = V::multiply_subtract(ay, bx, c.component[2]);
+
+  c.component[3] = V::multiply_add(aw, bw, c.component[3]);
+  c.component[3] = V::multiply_subtract(ax, bx, c.component[3]);
+  c.component[3] = V::multiply_subtract(ay, by, c.component[3]);
+  c.component[3] = V::multiply_subtract(az, bz, c.component[3]);
+}
+
+/// Returns the complex conjugates, negating the imaginary parts
+template <typename T>
+CUTLASS_ARCH_SIMD_TARGET_AVX2
+inline HostSimdSplitVector<typename HostSimdSplit<T>::Register, 2> host_simd_split_conjugate(
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 2> v) {
+
+  v.component[1] = HostSimdSplit<T>::neg(v.component[1]);
+  return v;
+}
+
+/// Returns the quaternion conjugates, negating x, y and z
+template <typename T>
+CUTLASS_ARCH_SIMD_TARGET_AVX2
+inline HostSimdSplitVector<typename HostSimdSplit<T>::Register, 4> host_simd_split_conjugate(
+  HostSimdSplitVector<typename HostSimdSplit<T>::Register, 4> v) {
+
+  for (int i = 0; i < 3; ++i) {
+    v.component[i] = HostSimdSplit<T>::neg(v.component[i]);
+  }
+  return v;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace arch
+} // namespace cutlass
+
+#endif // CUTLASS_ARCH_SIMD_X86_TARGETS
+
+#if CUTLASS_ARCH_SIMD_X86
+
+// MSVC does not define __F16C__, but /arch:AVX2 implies it
+#if defined(__F16C__) || defined(_MSC_VER)
+#define CUTLASS_ARCH_SIMD_X86_F16C 1
+#else
+#define CUTLASS_ARCH_SIMD_X86_F16C 0
+#endif
+
+#if defined(__AVX512F__)
+#define CUTLASS_ARCH_SIMD_X86_AVX512 1
+#else
+#define CUTLASS_ARCH_SIMD_X86_AVX512 0
+#endif
+
+namespace cutlass {
+namespace arch {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Loads, stores and arithmetic of elements held in x86 vector registers. Elements narrower
+/// than float are widened to float on load and rounded to the element type on store.
+template <typename T>
+struct HostSimdElement {
+  static bool const kEnabled = false;
+  static bool const kMultiplies = false;
+  static bool const kDivides = false;
+};
+
+/// AVX-512 counterpart of HostSimdElement, tried before it for arrays with at least kLanes elements
+template <typename T>
+struct HostSimdElementAvx512 {
+  static bool const kEnabled = false;
+};
+
+template <>
+struct HostSimdElement<float> {
+
+  static bool const kEnabled = true;
+  static bool const kMultiplies = true;
+  static bool const kDivides = true;
+  static int const kLanes = 8;
+
+  using Vector = __m256;
+
+  static Vector load(float const *ptr) { return _mm256_loadu_ps(ptr); }
+  static void store(float *ptr, Vector x) { _mm256_storeu_ps(ptr, x); }
+  static Vector broadcast(float x) { return _mm256_set1_ps(x); }
+  static Vector zero() { return _mm256_setzero_ps(); }
+
+  static Vector add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+  static Vector sub(Vector a, Vector b) { return _mm256_sub_ps(a, b); }
+  static Vector mul(Vector a, Vector b) { return host_simd_opaque(_mm256_mul_ps(a, b)); }
+  static Vector div(Vector a, Vector b) { return _mm256_div_ps(a, b); }
+  static Vector neg(Vector a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+
+  /// fmaxf() returns the other operand if one is NaN
+  static Vector max(Vector a, Vector b) {
+    return _mm256_blendv_ps(_mm256_max_ps(a, b), a, _mm256_cmp_ps(b, b, _CMP_UNORD_Q));
+  }
+
+  /// fminf() returns the other operand if one is NaN
+  static Vector min(Vector a, Vector b) {
+    return _mm256_blendv_ps(_mm256_min_ps(a, b), a, _mm256_cmp_ps(b, b, _CMP_UNORD_Q));
+  }
+};
+
+#if CUTLASS_ARCH_SIMD_X86_AVX512
+
+template <>
+struct HostSimdElementAvx512<float> {
+
+  static bool const kEnabled = true;
+  static int const kLanes = 16;
+
+  using Vector = __m512;
+
+  static Vector load(float const *ptr) { return _mm512_loadu_ps(ptr); }
+  static void store(float *ptr, Vector x) { _mm512_storeu_ps(ptr, x); }
+  static Vector broadcast(float x) { return _mm512_set1_ps(x); }
+  static Vector zero() { return _mm512_setzero_ps(); }
+
+  static Vector add(Vector a, Vector b) { return _mm512_add_ps(a, b); }
+  static Vector sub(Vector a, Vector b) { return _mm512_sub_ps(a, b); }
+  static Vector mul(Vector a, Vector b) { return host_simd_opaque(_mm512_mul_ps(a, b)); }
+  static Vector div(Vector a, Vector b) { return _mm512_div_ps(a, b); }
+
+  static Vector neg(Vector a) {
+    return _mm512_castsi512_ps(
+      _mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(int(0x80000000))));
+  }
+
+  static Vector max(Vector a, Vector b) {
+    return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(b, b, _CMP_UNORD_Q), _mm512_max_ps(a, b), a);
+  }
+
+  static Vector min(Vector a, Vector b) {
+    return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(b, b, _CMP_UNORD_Q), _mm512_min_ps(a, b), a);
+  }
+};
+
+#endif // CUTLASS_ARCH_SIMD_X86_AVX512
+
+/// Arithmetic on float vectors widened from an element type, with maximum and minimum selecting
+/// operands by comparison as the generic scalar operators do
+template <typename Derived>
+struct HostSimdWidenedElement {
+
+  static bool const kEnabled = true;
+  static bool const kMultiplies = true;
+  static bool const kDivides = true;
+  static int const kLanes = 8;
+
+  using Vector = __m256;
+
+  static Vector zero() { return _mm256_setzero_ps(); }
+
+  /// Results are rounded to the element type after each operation
+  static Vector add(Vector a, Vector b) { return Derived::round(_mm256_add_ps(a, b)); }
+  static Vector sub(Vector a, Vector b) { return Derived::round(_mm256_sub_ps(a, b)); }
+  static Vector mul(Vector a, Vector b) { return Derived::round(_mm256_mul_ps(a, b)); }
+  static Vector div(Vector a, Vector b) { return Derived::round(_mm256_div_ps(a, b)); }
+  static Vector neg(Vector a) { return Derived::round(_mm256_xor_ps(a, _mm256_set1_ps(-0.0f))); }
+
+  /// (a < b ? b : a)
+  static Vector max(Vector a, Vector b) {
+    return _mm256_blendv_ps(a, b, _mm256_cmp_ps(a, b, _CMP_LT_OQ));
+  }
+
+  /// (b < a ? b : a)
+  static Vector min(Vector a, Vector b) {
+    return _mm256_blendv_ps(a, b, _mm256_cmp_ps(b, a, _CMP_LT_OQ));
+  }
+};
+
+#if CUTLASS_ARCH_SIMD_X86_F16C
+
+template <>
+struct HostSimdElement<half_t> : public HostSimdWidenedElement<HostSimdElement<half_t>> {
+
+  static __m128i narrow(Vector x) {
+    return _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  static Vector load(half_t const *ptr) {
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr)));
+  }
+
+  static void store(half_t *ptr, Vector x) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), narrow(x));
+  }
+
+  static Vector broadcast(half_t x) { return _mm256_set1_ps(float(x)); }
+  static Vector round(Vector x) { return _mm256_cvtph_ps(narrow(x)); }
+};
+
+#endif // CUTLASS_ARCH_SIMD_X86_F16C
+
+template <>
+struct HostSimdElement<bfloat16_t> : public HostSimdWidenedElement<HostSimdElement<bfloat16_t>> {
+
+  /// Rounds to nearest even, leaving the result in the upper half of each 32-bit lane. NaN
+  /// becomes the canonical NaN 0x7fff.
+  static __m256i round_bits(Vector x) {
+    __m256i const exponent = _mm256_set1_epi32(0x7f800000);
+    __m256i const magnitude = _mm256_set1_epi32(0x7fffffff);
+
+    __m256i bits = _mm256_castps_si256(x);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff)));
+
+    __m256i non_finite = _mm256_cmpeq_epi32(_mm256_and_si256(bits, exponent), exponent);
+    __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, magnitude), exponent);
+    rounded = _mm256_blendv_epi8(rounded, bits, non_finite);
+    return _mm256_blendv_epi8(rounded, magnitude, nan);
+  }
+
+  static Vector load(bfloat16_t const *ptr) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+  }
+
+  static void store(bfloat16_t *ptr, Vector x) {
+    __m256i packed = _mm256_packus_epi32(_mm256_srli_epi32(round_bits(x), 16), _mm256_setzero_si256());
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(ptr),
+      _mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08)));
+  }
+
+  static Vector broadcast(bfloat16_t x) { return _mm256_set1_ps(float(x)); }
+
+  static Vector round(Vector x) {
+    return _mm256_castsi256_ps(_mm256_and_si256(round_bits(x), _mm256_set1_epi32(int(0xffff0000))));
+  }
+};
+
+template <>
+struct HostSimdElement<int32_t> {
+
+  static bool const kEnabled = true;
+  static bool const kMultiplies = true;
+  static bool const kDivides = false;
+  static int const kLanes = 8;
+
+  using Vector = __m256i;
+
+  static Vector load(int32_t const *ptr) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr));
+  }
+
+  static void store(int32_t *ptr, Vector x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), x);
+  }
+
+  static Vector broadcast(int32_t x) { return _mm256_set1_epi32(x); }
+  static Vector zero() { return _mm256_setzero_si256(); }
+
+  static Vector add(Vector a, Vector b) { return _mm256_add_epi32(a, b); }
+  static Vector sub(Vector a, Vector b) { return _mm256_sub_epi32(a, b); }
+  static Vector mul(Vector a, Vector b) { return _mm256_mullo_epi32(a, b); }
+  static Vector neg(Vector a) { return _mm256_sub_epi32(_mm256_setzero_si256(), a); }
+  static Vector max(Vector a, Vector b) { return _mm256_max_epi32(a, b); }
+  static Vector min(Vector a, Vector b) { return _mm256_min_epi32(a, b); }
+};
+
+template <>
+struct HostSimdElement<int8_t> {
+
+  static bool const kEnabled = true;
+  static bool const kMultiplies = false;
+  static bool const kDivides = false;
+  static int const kLanes = 32;
+
+  using Vector = __m256i;
+
+  static Vector load(int8_t const *ptr) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr));
+  }
+
+  static void store(int8_t *ptr, Vector x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), x);
+  }
+
+  static Vector broadcast(int8_t x) { return _mm256_set1_epi8(x); }
+  static Vector zero() { return _mm256_setzero_si256(); }
+
+  static Vector add(Vector a, Vector b) { return _mm256_add_epi8(a, b); }
+  static Vector sub(Vector a, Vector b) { return _mm256_sub_epi8(a, b); }
+  static Vector neg(Vector a) { return _mm256_sub_epi8(_mm256_setzero_si256(), a); }
+  static Vector max(Vector a, Vector b) { return _mm256_max_epi8(a, b); }
+  static Vector min(Vector a, Vector b) { return _mm256_min_epi8(a, b); }
+};
+
+/// Complex and quaternion elements of float or double held in one register per component.
+/// Their products are not elementwise, so multiply_add has its own HostSimdOp.
+template <typename Element, typename T, int Components, bool Enabled = HostSimdSplit<T>::kEnabled>
+struct HostSimdSplitElement {
+  static bool const kEnabled = false;
+  static bool const kMultiplies = false;
+  static bool const kDivides = false;
+};
+
+template <typename Element, typename T, int Components>
+struct HostSimdSplitElement<Element, T, Components, true> {
+
+  static bool const kEnabled = true;
+  static bool const kMultiplies = false;
+  static bool const kDivides = false;
+  static int const kLanes = HostSimdSplit<T>::kLanes;
+
+  using Split = HostSimdSplit<T>;
+  using Vector = HostSimdSplitVector<typename Split::Register, Components>;
+
+  static Vector load(Element const *ptr) { return Split::load(ptr); }
+  static void store(Element *ptr, Vector const &x) { Split::store(ptr, x); }
+  static Vector broadcast(Element const &x) { return host_simd_split_broadcast<T>(x); }
+
+  static Vector add(Vector a, Vector const &b) {
+    for (int i = 0; i < Components; ++i) {
+      a.component[i] = Split::add(a.component[i], b.component[i]);
+    }
+    return a;
+  }
+
+  static Vector sub(Vector a, Vector const &b) {
+    for (int i = 0; i < Components; ++i) {
+      a.component[i] = Split::sub(a.component[i], b.component[i]);
+    }
+    return a;
+  }
+
+  static Vector neg(Vector a) {
+    for (int i = 0; i < Components; ++i) {
+      a.component[i] = Split::neg(a.component[i]);
+    }
+    return a;
+  }
+};
+
+template <typename T>
+struct HostSimdElement<complex<T>> : public HostSimdSplitElement<complex<T>, T, 2> { };
+
+template <typename T>
+struct HostSimdElement<Quaternion<T>> : public HostSimdSplitElement<Quaternion<T>, T, 4> { };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Vector implementation of a scalar functor from functional.h
+template <typename Op>
+struct HostSimdOp {
+  static bool const kEnabled = false;
+};
+
+template <typename T>
+struct HostSimdOp<plus<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a, typename Element::Vector b) {
+    return Element::add(a, b);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<minus<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a, typename Element::Vector b) {
+    return Element::sub(a, b);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<multiplies<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled && HostSimdElement<T>::kMultiplies;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a, typename Element::Vector b) {
+    return Element::mul(a, b);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<divides<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled && HostSimdElement<T>::kDivides;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a, typename Element::Vector b) {
+    return Element::div(a, b);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<maximum<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a, typename Element::Vector b) {
+    return Element::max(a, b);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<minimum<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a, typename Element::Vector b) {
+    return Element::min(a, b);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<negate<T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a) {
+    return Element::neg(a);
+  }
+};
+
+/// The product is rounded to the element type before it is added
+template <typename T>
+struct HostSimdOp<multiply_add<T, T, T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled && HostSimdElement<T>::kMultiplies;
+
+  template <typename Element>
+  static typename Element::Vector apply(
+    typename Element::Vector a,
+    typename Element::Vector b,
+    typename Element::Vector c) {
+
+    return Element::add(Element::mul(a, b), c);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<multiply_add_relu0<T, T, T>> {
+  static bool const kEnabled = HostSimdElement<T>::kEnabled && HostSimdElement<T>::kMultiplies;
+
+  template <typename Element>
+  static typename Element::Vector apply(
+    typename Element::Vector a,
+    typename Element::Vector b,
+    typename Element::Vector c) {
+
+    return Element::max(Element::add(Element::mul(a, b), c), Element::zero());
+  }
+};
+
+/// Terms are accumulated in the order of multiply_add<complex<T>>, each product rounded
+template <typename T>
+struct HostSimdOp<multiply_add<complex<T>, complex<T>, complex<T>>> {
+  static bool const kEnabled = HostSimdElement<complex<T>>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(
+    typename Element::Vector a,
+    typename Element::Vector b,
+    typename Element::Vector c) {
+
+    host_simd_split_multiply_add<T>(a, b, c);
+    return c;
+  }
+};
+
+/// Terms are accumulated in the order of multiply_add<Quaternion<T>>, each product rounded
+template <typename T>
+struct HostSimdOp<multiply_add<Quaternion<T>, Quaternion<T>, Quaternion<T>>> {
+  static bool const kEnabled = HostSimdElement<Quaternion<T>>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(
+    typename Element::Vector a,
+    typename Element::Vector b,
+    typename Element::Vector c) {
+
+    host_simd_split_multiply_add<T>(a, b, c);
+    return c;
+  }
+};
+
+template <typename T>
+struct HostSimdOp<conjugate<complex<T>>> {
+  static bool const kEnabled = HostSimdElement<complex<T>>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a) {
+    return host_simd_split_conjugate<T>(a);
+  }
+};
+
+template <typename T>
+struct HostSimdOp<conjugate<Quaternion<T>>> {
+  static bool const kEnabled = HostSimdElement<Quaternion<T>>::kEnabled;
+
+  template <typename Element>
+  static typename Element::Vector apply(typename Element::Vector a) {
+    return host_simd_split_conjugate<T>(a);
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Array operand of host_simd_transform()
+template <typename T>
+struct HostSimdArrayOperand {
+
+  T const *ptr;
+
+  template <typename Element>
+  typename Element::Vector load(int idx) const {
+    return Element::load(ptr + idx);
+  }
+};
+
+/// Scalar operand of host_simd_transform() broadcast to all elements
+template <typename T>
+struct HostSimdScalarOperand {
+
+  T value;
+
+  template <typename Element>
+  typename Element::Vector load(int) const {
+    return Element::broadcast(value);
+  }
+};
+
+/// Processes whole vectors of an element type, returning the index of the first element left
+template <typename Element, bool Enabled = Element::kEnabled>
+struct HostSimdLoop {
+  template <int N, typename Op, typename T, typename... Operands>
+  static int run(int idx, T *, Operands const &...) {
+    return idx;
+  }
+};
+
+template <typename Element>
+struct HostSimdLoop<Element, true> {
+  template <int N, typename Op, typename T, typename... Operands>
+  static int run(int idx, T *result, Operands const &... operands) {
+    for (; idx + Element::kLanes <= N; idx += Element::kLanes) {
+      Element::store(
+        result + idx,
+        HostSimdOp<Op>::template apply<Element>(operands.template load<Element>(idx)...));
+    }
+    return idx;
+  }
+};
+
+/// Computes result[i] = Op()(operands[i]...) for as many of N elements as fill whole vectors,
+/// using the widest vectors available, and returns the number of elements computed. The caller
+/// computes the remainder with the scalar operator. HostSimdOp<Op>::kEnabled must be true.
+template <int N, typename Op, typename T, typename... Operands>
+int host_simd_transform(T *result, Operands const &... operands) {
+
+  int idx = 0;
+
+  #if CUTLASS_ARCH_SIMD_X86_AVX512
+  idx = HostSimdLoop<HostSimdElementAvx512<T>>::template run<N, Op>(idx, result, operands...);
+  #endif
+
+  return HostSimdLoop<HostSimdElement<T>>::template run<N, Op>(idx, result, operands...);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Rounds four floats, given as bits, to nearest even in the 8-bit floating point type Fp8,
+/// saturating out-of-range values and infinity to the largest finite value. NaN becomes 0x7f, as
+/// in float8_base::convert_float_to_fp8(). Returns the encodings with element 0 in the low byte.
+template <typename Fp8>
+inline uint32_t host_simd_convert_to_fp8(__m128i x) {
+  int const kMantissa = Fp8::FP8_NUM_MANTISSA_BITS;
+  int const kShift = 23 - kMantissa;
+
+  // Bias of the float exponent relative to the fp8 exponent
+  int const kRebias = (127 - Fp8::FP8_EXPONENT_BIAS) << kMantissa;
+
+  // Floats below the smallest normal fp8 value round to a multiple of the smallest subnormal
+  int const kSmallestNormal = (127 + Fp8::FP8_MIN_EXPONENT) << 23;
+  int const kSubnormalMagic = (127 + Fp8::FP8_MIN_EXPONENT - kMantissa + 23) << 23;
+
+  __m128i sign = _mm_and_si128(_mm_srli_epi32(x, 24), _mm_set1_epi32(0x80));
+  __m128i a = _mm_and_si128(x, _mm_set1_epi32(0x7fffffff));
+
+  // Normal results: round the float mantissa to nearest even and rebias the exponent
+  __m128i odd = _mm_and_si128(_mm_srli_epi32(a, kShift), _mm_set1_epi32(1));
+  __m128i rounded = _mm_add_epi32(a, _mm_add_epi32(odd, _mm_set1_epi32((1 << (kShift - 1)) - 1)));
+  __m128i normal = _mm_sub_epi32(_mm_srli_epi32(rounded, kShift), _mm_set1_epi32(kRebias));
+
+  // Subnormal results: the float addition aligns and rounds the mantissa to nearest even
+  __m128 magic = _mm_castsi128_ps(_mm_set1_epi32(kSubnormalMagic));
+  __m128i subnormal = _mm_sub_epi32(
+    _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), magic)), _mm_castps_si128(magic));
+
+  __m128i is_subnormal = _mm_cmpgt_epi32(_mm_set1_epi32(kSmallestNormal), a);
+  __m128i u = _mm_blendv_epi8(normal, subnormal, is_subnormal);
+
+  u = _mm_or_si128(_mm_min_epi32(u, _mm_set1_epi32(Fp8::FP8_MAX_FLT)), sign);
+
+  __m128i nan = _mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f800000));
+  u = _mm_blendv_epi8(u, _mm_set1_epi32(0x7f), nan);
+
+  __m128i u16 = _mm_packus_epi32(u, u);
+  return uint32_t(_mm_cvtsi128_si32(_mm_packus_epi16(u16, u16)));
+}
+
+/// Converts four floats to Fp8
+template <typename Fp8>
+inline uint32_t host_simd_convert_to_fp8(float const *ptr) {
+  return host_simd_convert_to_fp8<Fp8>(_mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr)));
+}
+
+/// Converts four bfloat16_t to Fp8 through float
+template <typename Fp8>
+inline uint32_t host_simd_convert_to_fp8(bfloat16_t const *ptr) {
+  __m128i h = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(ptr));
+  return host_simd_convert_to_fp8<Fp8>(_mm_slli_epi32(_mm_cvtepu16_epi32(h), 16));
+}
+
+#if CUTLASS_ARCH_SIMD_X86_F16C
+
+/// Converts four half_t to Fp8 through float
+template <typename Fp8>
+inline uint32_t host_simd_convert_to_fp8(half_t const *ptr) {
+  __m128i h = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(ptr));
+  return host_simd_convert_to_fp8<Fp8>(_mm_castps_si128(_mm_cvtph_ps(h)));
+}
+
+#endif // CUTLASS_ARCH_SIMD_X86_F16C
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace arch
+} // namespace cutlass
+
+#endif // CUTLASS_ARCH_SIMD_X86
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +38,7 @@
 #include "cutlass/functional.h"
 #include "cutlass/numeric_types.h"
 #include "cutlass/half.h"
+#include "cutlass/arch/simd_x86.h"
 
 namespace cutlass {
 
@@ -559,6 +560,70 @@ Array<Element, 4> make_Array(Element x, Element y, Element z, Element w) {
 }
 
 
+namespace detail {
+
+/// Element of an Array operand of array_transform(), or a scalar operand applying to all elements
+template <typename T, int N>
+CUTLASS_HOST_DEVICE
+T array_transform_element(Array<T, N> const &array, int idx) {
+  return array[idx];
+}
+
+template <typename T, int N>
+CUTLASS_HOST_DEVICE
+T const &array_transform_element(T const &scalar, int) {
+  return scalar;
+}
+
+#if CUTLASS_ARCH_SIMD_X86
+
+/// Vector operand of arch::host_simd_transform() reading an Array or broadcasting a scalar
+template <typename T, int N>
+arch::HostSimdArrayOperand<T> array_host_simd_operand(Array<T, N> const &array) {
+  return arch::HostSimdArrayOperand<T>{reinterpret_cast<T const *>(array.raw_data())};
+}
+
+template <typename T, int N>
+arch::HostSimdScalarOperand<T> array_host_simd_operand(T const &scalar) {
+  return arch::HostSimdScalarOperand<T>{scalar};
+}
+
+template <typename Op, typename T, int N, typename... Args>
+int array_host_simd(platform::false_type, Array<T, N> &, Args const &...) {
+  return 0;
+}
+
+/// Stores through the storage of the result, returning the number of elements computed
+template <typename Op, typename T, int N, typename... Args>
+int array_host_simd(platform::true_type, Array<T, N> &result, Args const &... args) {
+  return arch::host_simd_transform<N, Op>(
+    reinterpret_cast<T *>(result.raw_data()), array_host_simd_operand<T, N>(args)...);
+}
+
+#endif // CUTLASS_ARCH_SIMD_X86
+
+/// Computes result[i] = op(args[i]...) for Array and scalar operands. In host code, the elements
+/// are computed with x86 SIMD instructions if arch::HostSimdOp supports the operator and element
+/// type, and with the scalar operator otherwise.
+template <typename T, int N, typename Op, typename... Args>
+CUTLASS_HOST_DEVICE
+void array_transform(Array<T, N> &result, Op const &op, Args const &... args) {
+
+  int idx = 0;
+
+  #if CUTLASS_ARCH_SIMD_X86
+  idx = array_host_simd<Op>(
+    platform::integral_constant<bool, arch::HostSimdOp<Op>::kEnabled>(), result, args...);
+  #endif
+
+  CUTLASS_PRAGMA_UNROLL
+  for (int i = idx; i < N; ++i) {
+    result[i] = op(array_transform_element<T, N>(args, i)...);
+  }
+}
+
+} // namespace detail
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // functional.h numeric specializations
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -589,10 +654,7 @@ struct plus<Array<T, N>> {
     Array<T, N> result;
     plus<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs, rhs);
 
     return result;
   }
@@ -603,10 +665,7 @@ struct plus<Array<T, N>> {
     Array<T, N> result;
     plus<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], scalar);
-    }
+    detail::array_transform(result, scalar_op, lhs, scalar);
 
     return result;
   }
@@ -617,10 +676,7 @@ struct plus<Array<T, N>> {
     Array<T, N> result;
     plus<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, rhs);
 
     return result;
   }
@@ -634,10 +690,7 @@ struct minus<Array<T, N>> {
     Array<T, N> result;
     minus<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs, rhs);
 
     return result;
   }
@@ -648,10 +701,7 @@ struct minus<Array<T, N>> {
     Array<T, N> result;
     minus<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], scalar);
-    }
+    detail::array_transform(result, scalar_op, lhs, scalar);
 
     return result;
   }
@@ -662,10 +712,7 @@ struct minus<Array<T, N>> {
     Array<T, N> result;
     minus<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, rhs);
 
     return result;
   }
@@ -680,10 +727,7 @@ struct multiplies<Array<T, N>> {
     Array<T, N> result;
     multiplies<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs, rhs);
 
     return result;
   }
@@ -694,10 +738,7 @@ struct multiplies<Array<T, N>> {
     Array<T, N> result;
     multiplies<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], scalar);
-    }
+    detail::array_transform(result, scalar_op, lhs, scalar);
 
     return result;
   }
@@ -708,10 +749,7 @@ struct multiplies<Array<T, N>> {
     Array<T, N> result;
     multiplies<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, rhs);
 
     return result;
   }
@@ -726,10 +764,7 @@ struct divides<Array<T, N>> {
     Array<T, N> result;
     divides<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs, rhs);
 
     return result;
   }
@@ -740,10 +775,7 @@ struct divides<Array<T, N>> {
     Array<T, N> result;
     divides<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], scalar);
-    }
+    detail::array_transform(result, scalar_op, lhs, scalar);
 
     return result;
   }
@@ -754,10 +786,7 @@ struct divides<Array<T, N>> {
     Array<T, N> result;
     divides<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, rhs);
 
     return result;
   }
@@ -772,10 +801,7 @@ struct maximum<Array<T, N>> {
     Array<T, N> result;
     maximum<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs, rhs);
 
     return result;
   }
@@ -786,10 +812,7 @@ struct maximum<Array<T, N>> {
     Array<T, N> result;
     maximum<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], scalar);
-    }
+    detail::array_transform(result, scalar_op, lhs, scalar);
 
     return result;
   }
@@ -800,10 +823,7 @@ struct maximum<Array<T, N>> {
     Array<T, N> result;
     maximum<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, rhs);
 
     return result;
   }
@@ -823,10 +843,7 @@ struct minimum<Array<T, N>> {
     Array<T, N> result;
     minimum<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs, rhs);
 
     return result;
   }
@@ -837,10 +854,7 @@ struct minimum<Array<T, N>> {
     Array<T, N> result;
     minimum<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i], scalar);
-    }
+    detail::array_transform(result, scalar_op, lhs, scalar);
 
     return result;
   }
@@ -851,10 +865,7 @@ struct minimum<Array<T, N>> {
     Array<T, N> result;
     minimum<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, rhs[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, rhs);
 
     return result;
   }
@@ -869,10 +880,7 @@ struct negate<Array<T, N>> {
     Array<T, N> result;
     negate<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(lhs[i]);
-    }
+    detail::array_transform(result, scalar_op, lhs);
 
     return result;
   }
@@ -888,10 +896,7 @@ struct multiply_add<Array<T, N>, Array<T, N>, Array<T, N>> {
     Array<T, N> result;
     multiply_add<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(a[i], b[i], c[i]);
-    }
+    detail::array_transform(result, scalar_op, a, b, c);
 
     return result;
   }
@@ -902,10 +907,7 @@ struct multiply_add<Array<T, N>, Array<T, N>, Array<T, N>> {
     Array<T, N> result;
     multiply_add<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(a[i], scalar, c[i]);
-    }
+    detail::array_transform(result, scalar_op, a, scalar, c);
 
     return result;
   }
@@ -916,10 +918,7 @@ struct multiply_add<Array<T, N>, Array<T, N>, Array<T, N>> {
     Array<T, N> result;
     multiply_add<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = scalar_op(scalar, b[i], c[i]);
-    }
+    detail::array_transform(result, scalar_op, scalar, b, c);
 
     return result;
   }
@@ -933,13 +932,9 @@ struct multiply_add_relu0<Array<T, N>, Array<T, N>, Array<T, N>> {
   Array<T, N> operator()(Array<T, N> const &a, Array<T, N> const &b, Array<T, N> const &c) const {
 
     Array<T, N> result;
-    multiply_add<T> scalar_op;
-    maximum<T> mx;
+    multiply_add_relu0<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(scalar_op(a[i], b[i], c[i]), T(0));
-    }
+    detail::array_transform(result, scalar_op, a, b, c);
 
     return result;
   }
@@ -948,13 +943,9 @@ struct multiply_add_relu0<Array<T, N>, Array<T, N>, Array<T, N>> {
   Array<T, N> operator()(Array<T, N> const &a, T const &scalar, Array<T, N> const &c) const {
 
     Array<T, N> result;
-    multiply_add<T> scalar_op;
-    maximum<T> mx;
+    multiply_add_relu0<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(scalar_op(a[i], scalar, c[i]), T(0));
-    }
+    detail::array_transform(result, scalar_op, a, scalar, c);
 
     return result;
   }
@@ -963,13 +954,9 @@ struct multiply_add_relu0<Array<T, N>, Array<T, N>, Array<T, N>> {
   Array<T, N> operator()(T const &scalar, Array<T, N> const &b, Array<T, N> const &c) const {
 
     Array<T, N> result;
-    multiply_add<T> scalar_op;
-    maximum<T> mx;
+    multiply_add_relu0<T> scalar_op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(scalar_op(scalar, b[i], c[i]), T(0));
-    }
+    detail::array_transform(result, scalar_op, scalar, b, c);
 
     return result;
   }
@@ -984,10 +971,7 @@ struct conjugate<Array<T, N> >  {
     conjugate<T> conj_op;
 
     Array<T, N> ca;
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      ca[i] = conj_op(a[i]);
-    }
+    detail::array_transform(ca, conj_op, a);
     return ca;
   }
 };
@@ -1023,10 +1007,7 @@ struct plus<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] + rhs[i];
-    }
+    detail::array_transform(result, plus<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1055,10 +1036,7 @@ struct plus<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs + rhs[i];
-    }
+    detail::array_transform(result, plus<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1087,10 +1065,7 @@ struct plus<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] + rhs;
-    }
+    detail::array_transform(result, plus<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1123,10 +1098,7 @@ struct minus<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] - rhs[i];
-    }
+    detail::array_transform(result, minus<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1155,10 +1127,7 @@ struct minus<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs - rhs[i];
-    }
+    detail::array_transform(result, minus<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1187,10 +1156,7 @@ struct minus<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] - rhs;
-    }
+    detail::array_transform(result, minus<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1223,10 +1189,7 @@ struct multiplies<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] * rhs[i];
-    }
+    detail::array_transform(result, multiplies<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1258,10 +1221,7 @@ struct multiplies<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs * rhs[i];
-    }
+    detail::array_transform(result, multiplies<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1293,10 +1253,7 @@ struct multiplies<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] * rhs;
-    }
+    detail::array_transform(result, multiplies<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1332,10 +1289,7 @@ struct divides<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] / rhs[i];
-    }
+    detail::array_transform(result, divides<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1367,10 +1321,7 @@ struct divides<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs / rhs[i];
-    }
+    detail::array_transform(result, divides<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1402,10 +1353,7 @@ struct divides<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = lhs[i] / rhs;
-    }
+    detail::array_transform(result, divides<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1435,10 +1383,7 @@ struct negate<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = -lhs[i];
-    }
+    detail::array_transform(result, negate<half_t>(), lhs);
     #endif
 
     return result;
@@ -1486,10 +1431,7 @@ struct multiply_add<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>> {
 
     multiply_add<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a[i], b[i], c[i]);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1530,10 +1472,7 @@ struct multiply_add<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>> {
 
     multiply_add<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a, b[i], c[i]);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1575,10 +1514,7 @@ struct multiply_add<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>> {
 
     multiply_add<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a[i], b, c[i]);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1620,10 +1556,7 @@ struct multiply_add<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>> {
 
     multiply_add<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a[i], b[i], c);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1669,13 +1602,9 @@ struct multiply_add_relu0<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>>
 
     #else
 
-    multiply_add<half_t> op;
-    maximum<half_t> mx;
+    multiply_add_relu0<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(op(a[i], b[i], c[i]), (half_t)0);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1714,13 +1643,9 @@ struct multiply_add_relu0<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>>
 
     #else
 
-    multiply_add<half_t> op;
-    maximum<half_t> mx;
+    multiply_add_relu0<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(op(a, b[i], c[i]), half_t(0));
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1760,13 +1685,9 @@ struct multiply_add_relu0<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>>
 
     #else
 
-    multiply_add<half_t> op;
-    maximum<half_t> mx;
+    multiply_add_relu0<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(op(a[i], b, c[i]), half_t(0));
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1806,13 +1727,9 @@ struct multiply_add_relu0<Array<half_t, N>, Array<half_t, N>, Array<half_t, N>>
 
     #else
 
-    multiply_add<half_t> op;
-    maximum<half_t> mx;
+    multiply_add_relu0<half_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = mx(op(a[i], b[i], c), half_t(0));
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -1848,10 +1765,7 @@ struct minimum<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = (rhs[i] < lhs[i] ? rhs[i] : lhs[i]);
-    }
+    detail::array_transform(result, minimum<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1883,10 +1797,7 @@ struct minimum<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = (rhs[i] < lhs ? rhs[i] : lhs);
-    }
+    detail::array_transform(result, minimum<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1918,10 +1829,7 @@ struct minimum<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = (rhs < lhs[i] ? rhs : lhs[i]);
-    }
+    detail::array_transform(result, minimum<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1957,10 +1865,7 @@ struct maximum<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = (lhs[i] < rhs[i] ? rhs[i] : lhs[i]);
-    }
+    detail::array_transform(result, maximum<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -1992,10 +1897,7 @@ struct maximum<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = (lhs < rhs[i] ? rhs[i] : lhs);
-    }
+    detail::array_transform(result, maximum<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -2027,10 +1929,7 @@ struct maximum<Array<half_t, N>> {
 
     #else
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = (lhs[i] < rhs ? rhs : lhs[i]);
-    }
+    detail::array_transform(result, maximum<half_t>(), lhs, rhs);
     #endif
 
     return result;
@@ -2080,10 +1979,7 @@ struct multiply_add<Array<bfloat16_t, N>, Array<bfloat16_t, N>, Array<bfloat16_t
 
     multiply_add<bfloat16_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a[i], b[i], c[i]);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -2131,10 +2027,7 @@ struct multiply_add<Array<bfloat16_t, N>, Array<bfloat16_t, N>, Array<bfloat16_t
 
     multiply_add<bfloat16_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a, b[i], c[i]);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -2182,10 +2075,7 @@ struct multiply_add<Array<bfloat16_t, N>, Array<bfloat16_t, N>, Array<bfloat16_t
 
     multiply_add<bfloat16_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a[i], b, c[i]);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -2233,10 +2123,7 @@ struct multiply_add<Array<bfloat16_t, N>, Array<bfloat16_t, N>, Array<bfloat16_t
 
     multiply_add<bfloat16_t> op;
 
-    CUTLASS_PRAGMA_UNROLL
-    for (int i = 0; i < N; ++i) {
-      result[i] = op(a[i], b[i], c);
-    }
+    detail::array_transform(result, op, a, b, c);
     #endif
 
     return result;
@@ -342,6 +342,25 @@ struct alignas(1) float8_base {
         return flt;
         #endif
     }
+
+#if !defined(__CUDACC_RTC__)
+    /// Float values of all 256 encodings, computed by convert_fp8_to_float() on first use. Host
+    /// conversions from fp8 read this table.
+    static float const *float_table() {
+        struct Table {
+            float values[256];
+
+            Table() {
+                for (int i = 0; i < 256; ++i) {
+                    values[i] = convert_fp8_to_float(uint8_t(i));
+                }
+            }
+        };
+
+        static Table const table;
+        return table.values;
+    }
+#endif
 };
 
 
@@ -410,8 +429,10 @@ struct alignas(1) float_e4m3_t : float8_base<FloatEncoding::E4M3> {
         asm volatile("cvt.rn.f16x2.e4m3x2 %0, %1;\n" : "=r"(packed) : "h"(bits));
 
         return reinterpret_cast<half2 const &>(packed).x;
-    #else
+    #elif defined(__CUDA_ARCH__)
         return half(Base::convert_fp8_to_float(x.storage));
+    #else
+        return half(Base::float_table()[x.storage]);
     #endif
     }
 
@@ -424,8 +445,10 @@ struct alignas(1) float_e4m3_t : float8_base<FloatEncoding::E4M3> {
         asm volatile("cvt.rn.f16x2.e4m3x2 %0, %1;\n" : "=r"(packed) : "h"(bits));
 
         return float(reinterpret_cast<half2 const &>(packed).x);
-    #else
+    #elif defined(__CUDA_ARCH__)
         return Base::convert_fp8_to_float(x.storage);
+    #else
+        return Base::float_table()[x.storage];
     #endif
     }
 
@@ -620,8 +643,10 @@ struct alignas(1) float_e5m2_t : float8_base<FloatEncoding::E5M2> {
         asm volatile("cvt.rn.f16x2.e5m2x2 %0, %1;\n" : "=r"(packed) : "h"(bits));
 
         return reinterpret_cast<half2 const &>(packed).x;
-    #else
+    #elif defined(__CUDA_ARCH__)
         return half(Base::convert_fp8_to_float(x.storage));
+    #else
+        return half(Base::float_table()[x.storage]);
     #endif
     }
 
@@ -634,8 +659,10 @@ struct alignas(1) float_e5m2_t : float8_base<FloatEncoding::E5M2> {
         asm volatile("cvt.rn.f16x2.e5m2x2 %0, %1;\n" : "=r"(packed) : "h"(bits));
 
         return float(reinterpret_cast<half2 const &>(packed).x);
-    #else
+    #elif defined(__CUDA_ARCH__)
         return Base::convert_fp8_to_float(x.storage);
+    #else
+        return Base::float_table()[x.storage];
     #endif
     }
 
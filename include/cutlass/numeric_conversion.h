@@ -1289,7 +1289,7 @@ struct NumericArrayConverter<float, float_e4m3_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1344,7 +1344,7 @@ struct NumericArrayConverter<float_e4m3_t, float, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1360,6 +1360,9 @@ struct NumericArrayConverter<float_e4m3_t, float, 4, Round> {
         "}" \
         : "=r"(out) : "f"(source[0]), "f"(source[1]), "f"(source[2]), "f"(source[3]));
 
+    return reinterpret_cast<result_type const &>(out);
+  #elif CUTLASS_ARCH_SIMD_X86
+    uint32_t out = arch::host_simd_convert_to_fp8<result_element>(source.data());
     return reinterpret_cast<result_type const &>(out);
   #else
     result_type result;
@@ -1392,7 +1395,7 @@ struct NumericArrayConverter<float, float_e5m2_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1447,7 +1450,7 @@ struct NumericArrayConverter<float_e5m2_t, float, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1463,6 +1466,9 @@ struct NumericArrayConverter<float_e5m2_t, float, 4, Round> {
         "}" \
         : "=r"(out) : "f"(source[0]), "f"(source[1]), "f"(source[2]), "f"(source[3]));
 
+    return reinterpret_cast<result_type const &>(out);
+  #elif CUTLASS_ARCH_SIMD_X86
+    uint32_t out = arch::host_simd_convert_to_fp8<result_element>(source.data());
     return reinterpret_cast<result_type const &>(out);
   #else
     result_type result;
@@ -1501,7 +1507,7 @@ struct NumericArrayConverter<half_t, float_e4m3_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1546,7 +1552,7 @@ struct NumericArrayConverter<float_e4m3_t, half_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1563,6 +1569,9 @@ struct NumericArrayConverter<float_e4m3_t, half_t, 4, Round> {
         "}" \
         : "=r"(out) : "r"(src_packed[0]), "r"(src_packed[1]));
 
+    return reinterpret_cast<result_type const &>(out);
+  #elif CUTLASS_ARCH_SIMD_X86 && CUTLASS_ARCH_SIMD_X86_F16C
+    uint32_t out = arch::host_simd_convert_to_fp8<result_element>(source.data());
     return reinterpret_cast<result_type const &>(out);
   #else
     result_type result;
@@ -1595,7 +1604,7 @@ struct NumericArrayConverter<half_t, float_e5m2_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1640,7 +1649,7 @@ struct NumericArrayConverter<float_e5m2_t, half_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1657,6 +1666,9 @@ struct NumericArrayConverter<float_e5m2_t, half_t, 4, Round> {
         "}" \
         : "=r"(out) : "r"(src_packed[0]), "r"(src_packed[1]));
 
+    return reinterpret_cast<result_type const &>(out);
+  #elif CUTLASS_ARCH_SIMD_X86 && CUTLASS_ARCH_SIMD_X86_F16C
+    uint32_t out = arch::host_simd_convert_to_fp8<result_element>(source.data());
     return reinterpret_cast<result_type const &>(out);
   #else
     result_type result;
@@ -1695,7 +1707,7 @@ struct NumericArrayConverter<bfloat16_t, float_e4m3_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1743,7 +1755,7 @@ struct NumericArrayConverter<float_e4m3_t, bfloat16_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1758,6 +1770,9 @@ struct NumericArrayConverter<float_e4m3_t, bfloat16_t, 4, Round> {
     // Convert float to f8
     NumericArrayConverter<result_element, float, 4, Round> float2result;
     return float2result(tmp);
+  #elif CUTLASS_ARCH_SIMD_X86
+    uint32_t out = arch::host_simd_convert_to_fp8<result_element>(source.data());
+    return reinterpret_cast<result_type const &>(out);
   #else
     result_type result;
     NumericConverter<result_element, source_element, Round> converter;
@@ -1789,7 +1804,7 @@ struct NumericArrayConverter<bfloat16_t, float_e5m2_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1837,7 +1852,7 @@ struct NumericArrayConverter<float_e5m2_t, bfloat16_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
 
   #if defined(CUDA_PTX_FP8_CVT_ENABLED)
@@ -1852,6 +1867,9 @@ struct NumericArrayConverter<float_e5m2_t, bfloat16_t, 4, Round> {
     // Convert float to f8
     NumericArrayConverter<result_element, float, 4, Round> float2result;
     return float2result(tmp);
+  #elif CUTLASS_ARCH_SIMD_X86
+    uint32_t out = arch::host_simd_convert_to_fp8<result_element>(source.data());
+    return reinterpret_cast<result_type const &>(out);
   #else
     result_type result;
     NumericConverter<result_element, source_element, Round> converter;
@@ -1889,7 +1907,7 @@ struct NumericArrayConverter<float_e4m3_t, float_e5m2_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
     result_type result;
     NumericConverter<result_element, source_element, Round> converter;
@@ -1920,7 +1938,7 @@ struct NumericArrayConverter<float_e5m2_t, float_e4m3_t, 4, Round> {
   using source_type = Array<source_element, 4>;
   static FloatRoundStyle const round_style = Round;
 
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
     result_type result;
     NumericConverter<result_element, source_element, Round> converter;
@@ -2016,7 +2034,7 @@ private:
   using packed_source_type = Array<source_element, 4>;
 
 public:
-  CUTLASS_DEVICE
+  CUTLASS_HOST_DEVICE
   static result_type convert(source_type const & source) {
     result_type result;
     packed_result_type* packed_result = reinterpret_cast<packed_result_type*>(&result);
@@ -745,6 +745,15 @@ struct multiply_add<Quaternion<T>, Quaternion<T>, Quaternion<T>> {
   }
 };
 
+/// Conjugate
+template <typename T>
+struct conjugate<Quaternion<T>>  {
+  CUTLASS_HOST_DEVICE
+  Quaternion<T> operator()(Quaternion<T> const &a) const {
+    return conj(a);
+  }
+};
+
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -32,9 +32,13 @@
     \brief Unit tests for functional operators.
 */
 
+#include <random>
+
 #include "../common/cutlass_unit_test.h"
 
 #include "cutlass/functional.h"
+#include "cutlass/complex.h"
+#include "cutlass/quaternion.h"
 #include "cutlass/core_io.h"
 
 #include "cutlass/layout/matrix.h"
@@ -492,3 +496,223 @@ TEST(Functional, multiply_add_quaternion_f32) {
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Checks the Array specialization of a binary operator in host code against its scalar operator
+template <template <typename> class Operator, typename T, int kN>
+void Functional_host_binary_TxN(cutlass::Array<T, kN> const &a, cutlass::Array<T, kN> const &b, T s) {
+
+  Operator<cutlass::Array<T, kN>> array_op;
+  Operator<T> scalar_op;
+
+  cutlass::Array<T, kN> d0 = array_op(a, b);
+  cutlass::Array<T, kN> d1 = array_op(a, s);
+  cutlass::Array<T, kN> d2 = array_op(s, b);
+
+  for (int i = 0; i < kN; ++i) {
+    EXPECT_TRUE(T(d0[i]) == scalar_op(a[i], b[i]));
+    EXPECT_TRUE(T(d1[i]) == scalar_op(a[i], s));
+    EXPECT_TRUE(T(d2[i]) == scalar_op(s, b[i]));
+  }
+}
+
+/// Checks the Array specialization of a multiply-add operator in host code against its scalar
+/// operator
+template <template <typename, typename, typename> class Operator, typename T, int kN>
+void Functional_host_trinary_TxN(
+  cutlass::Array<T, kN> const &a,
+  cutlass::Array<T, kN> const &b,
+  cutlass::Array<T, kN> const &c,
+  T s) {
+
+  using Element = cutlass::Array<T, kN>;
+
+  Operator<Element, Element, Element> array_op;
+  Operator<T, T, T> scalar_op;
+
+  Element d0 = array_op(a, b, c);
+  Element d1 = array_op(a, s, c);
+  Element d2 = array_op(s, b, c);
+
+  for (int i = 0; i < kN; ++i) {
+    EXPECT_TRUE(T(d0[i]) == scalar_op(a[i], b[i], c[i]));
+    EXPECT_TRUE(T(d1[i]) == scalar_op(a[i], s, c[i]));
+    EXPECT_TRUE(T(d2[i]) == scalar_op(s, b[i], c[i]));
+  }
+}
+
+/// Checks the Array specializations of the arithmetic operators in host code, which are
+/// vectorized when CUTLASS_ENABLE_HOST_SIMD is set and the host compiler targets AVX2
+template <typename T, int kN>
+void Functional_host_array_operators_TxN(
+  cutlass::Array<T, kN> const &a,
+  cutlass::Array<T, kN> const &b,
+  cutlass::Array<T, kN> const &c,
+  T s) {
+
+  Functional_host_binary_TxN<cutlass::plus>(a, b, s);
+  Functional_host_binary_TxN<cutlass::minus>(a, b, s);
+  Functional_host_binary_TxN<cutlass::multiplies>(a, b, s);
+  Functional_host_binary_TxN<cutlass::divides>(a, b, s);
+  Functional_host_binary_TxN<cutlass::maximum>(a, b, s);
+  Functional_host_binary_TxN<cutlass::minimum>(a, b, s);
+
+  Functional_host_trinary_TxN<cutlass::multiply_add>(a, b, c, s);
+  Functional_host_trinary_TxN<cutlass::multiply_add_relu0>(a, b, c, s);
+
+  cutlass::negate<cutlass::Array<T, kN>> negate_op;
+  cutlass::Array<T, kN> d = negate_op(a);
+
+  for (int i = 0; i < kN; ++i) {
+    EXPECT_TRUE(T(d[i]) == cutlass::negate<T>()(a[i]));
+  }
+}
+
+/// Small integers, which most operators compute exactly. Sizes which are not a multiple of the
+/// vector width also exercise the elements left over after the last whole vector.
+template <typename T, int kN>
+void Functional_host_array_TxN() {
+
+  cutlass::Array<T, kN> a;
+  cutlass::Array<T, kN> b;
+  cutlass::Array<T, kN> c;
+
+  for (int i = 0; i < kN; ++i) {
+    a[i] = T((i * 2 + 1) % 5 - 2);
+    b[i] = T((i * 4 + 8) % 7 + 1);
+    c[i] = T((i * 3) % 11 - 5);
+  }
+
+  Functional_host_array_operators_TxN(a, b, c, T(-3));
+}
+
+/// Random fractions, whose sums and products are rounded. Divisors are bounded away from zero.
+template <typename T, int kN>
+void Functional_host_array_random_TxN() {
+
+  std::mt19937 generator(2023);
+  std::uniform_real_distribution<float> distribution(-4, 4);
+  std::uniform_real_distribution<float> divisor(0.25f, 4);
+
+  for (int iteration = 0; iteration < 100; ++iteration) {
+
+    cutlass::Array<T, kN> a;
+    cutlass::Array<T, kN> b;
+    cutlass::Array<T, kN> c;
+
+    for (int i = 0; i < kN; ++i) {
+      a[i] = T(distribution(generator));
+      b[i] = T((i % 2 ? -1 : 1) * divisor(generator));
+      c[i] = T(distribution(generator));
+    }
+
+    Functional_host_array_operators_TxN(a, b, c, T(-divisor(generator)));
+  }
+}
+
+TEST(Functional, host_array_f32x37) {
+  Functional_host_array_TxN<float, 37>();
+}
+
+TEST(Functional, host_array_f16x19) {
+  Functional_host_array_TxN<cutlass::half_t, 19>();
+}
+
+TEST(Functional, host_array_bf16x21) {
+  Functional_host_array_TxN<cutlass::bfloat16_t, 21>();
+}
+
+TEST(Functional, host_array_random_f32x37) {
+  Functional_host_array_random_TxN<float, 37>();
+}
+
+TEST(Functional, host_array_random_f32x5) {
+  Functional_host_array_random_TxN<float, 5>();
+}
+
+TEST(Functional, host_array_random_f16x19) {
+  Functional_host_array_random_TxN<cutlass::half_t, 19>();
+}
+
+TEST(Functional, host_array_random_bf16x21) {
+  Functional_host_array_random_TxN<cutlass::bfloat16_t, 21>();
+}
+
+TEST(Functional, host_array_s32x13) {
+  Functional_host_array_TxN<int32_t, 13>();
+}
+
+TEST(Functional, host_array_s8x70) {
+  Functional_host_array_TxN<int8_t, 70>();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Random fractions as the components of complex and quaternion elements
+template <typename T>
+void Functional_host_random_element(std::mt19937 &generator, cutlass::complex<T> &x) {
+  std::uniform_real_distribution<T> distribution(-4, 4);
+  T real = distribution(generator);
+  T imag = distribution(generator);
+  x = cutlass::complex<T>(real, imag);
+}
+
+template <typename T>
+void Functional_host_random_element(std::mt19937 &generator, cutlass::Quaternion<T> &x) {
+  std::uniform_real_distribution<T> distribution(-4, 4);
+  for (int i = 0; i < 4; ++i) {
+    x[i] = distribution(generator);
+  }
+}
+
+/// Checks the Array specializations of the operators supported for complex and quaternion
+/// elements in host code, which split the elements into one vector per component when
+/// CUTLASS_ENABLE_HOST_SIMD is set and the host compiler targets AVX2
+template <typename Element, int kN>
+void Functional_host_array_split_TxN() {
+
+  std::mt19937 generator(2023);
+
+  for (int iteration = 0; iteration < 100; ++iteration) {
+
+    cutlass::Array<Element, kN> a;
+    cutlass::Array<Element, kN> b;
+    cutlass::Array<Element, kN> c;
+    Element s;
+
+    for (int i = 0; i < kN; ++i) {
+      Functional_host_random_element(generator, a[i]);
+      Functional_host_random_element(generator, b[i]);
+      Functional_host_random_element(generator, c[i]);
+    }
+    Functional_host_random_element(generator, s);
+
+    Functional_host_binary_TxN<cutlass::plus>(a, b, s);
+    Functional_host_binary_TxN<cutlass::minus>(a, b, s);
+    Functional_host_trinary_TxN<cutlass::multiply_add>(a, b, c, s);
+
+    cutlass::conjugate<cutlass::Array<Element, kN>> conjugate_op;
+    cutlass::Array<Element, kN> d = conjugate_op(a);
+
+    for (int i = 0; i < kN; ++i) {
+      EXPECT_TRUE(d[i] == conj(a[i]));
+    }
+  }
+}
+
+TEST(Functional, host_array_complex_f32x19) {
+  Functional_host_array_split_TxN<cutlass::complex<float>, 19>();
+}
+
+TEST(Functional, host_array_complex_f64x11) {
+  Functional_host_array_split_TxN<cutlass::complex<double>, 11>();
+}
+
+TEST(Functional, host_array_quaternion_f32x13) {
+  Functional_host_array_split_TxN<cutlass::Quaternion<float>, 13>();
+}
+
+TEST(Functional, host_array_quaternion_f64x7) {
+  Functional_host_array_split_TxN<cutlass::Quaternion<double>, 7>();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
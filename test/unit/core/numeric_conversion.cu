@@ -32,6 +32,9 @@
     \brief Unit tests for conversion operators.
 */
 
+#include <cstring>
+#include <vector>
+
 #include "../common/cutlass_unit_test.h"
 
 #include "cutlass/numeric_conversion.h"
@@ -89,6 +92,71 @@ void run_test() {
 }
 
 } // namespace kernel
+
+namespace host {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Converts 'source' on the host with NumericArrayConverter, Count elements at a time, and
+/// compares the encodings with those of NumericConverter
+template <typename Destination, typename Source, int Count>
+void run_test(std::vector<Source> const &source) {
+
+  cutlass::NumericArrayConverter<Destination, Source, Count> convert_array;
+  cutlass::NumericConverter<Destination, Source> convert;
+
+  int mismatches = 0;
+
+  for (size_t i = 0; i + Count <= source.size(); i += Count) {
+    cutlass::Array<Source, Count> s;
+    for (int j = 0; j < Count; ++j) {
+      s[j] = source[i + j];
+    }
+
+    cutlass::Array<Destination, Count> d = convert_array(s);
+
+    for (int j = 0; j < Count; ++j) {
+      Destination result = d[j];
+      Destination expected = convert(s[j]);
+
+      if (result.storage != expected.storage) {
+        if (!mismatches) {
+          ADD_FAILURE() << "source[" << i + j << "] = " << float(s[j]) << " converted to "
+            << int(result.storage) << ", expected " << int(expected.storage);
+        }
+        ++mismatches;
+      }
+    }
+  }
+
+  EXPECT_EQ(mismatches, 0);
+}
+
+/// Returns all values of a 16-bit type
+template <typename T>
+std::vector<T> all_values() {
+  std::vector<T> values(1 << 16);
+  for (int i = 0; i < (1 << 16); ++i) {
+    values[i] = T::bitcast(uint16_t(i));
+  }
+  return values;
+}
+
+/// Returns floats with every combination of sign, exponent and the upper seven mantissa bits,
+/// which include the ties of both fp8 formats, along with their neighbors
+inline std::vector<float> float_values() {
+  std::vector<float> values;
+  for (uint32_t i = 0; i < (1u << 16); ++i) {
+    for (uint32_t bits : {(i << 16), (i << 16) | 1u, (i << 16) - 1u}) {
+      float x;
+      std::memcpy(&x, &bits, sizeof(x));
+      values.push_back(x);
+    }
+  }
+  return values;
+}
+
+} // namespace host
 } // namespace core
 } // namespace test
 
@@ -360,3 +428,43 @@ TEST(NumericConversion, f32x8_to_s8x8_rn) {
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(NumericConversion, host_f32_to_fe4m3_array) {
+  std::vector<float> source = test::core::host::float_values();
+  test::core::host::run_test<cutlass::float_e4m3_t, float, 4>(source);
+  test::core::host::run_test<cutlass::float_e4m3_t, float, 27>(source);
+}
+
+TEST(NumericConversion, host_f32_to_fe5m2_array) {
+  std::vector<float> source = test::core::host::float_values();
+  test::core::host::run_test<cutlass::float_e5m2_t, float, 4>(source);
+  test::core::host::run_test<cutlass::float_e5m2_t, float, 27>(source);
+}
+
+TEST(NumericConversion, host_f16_to_fe4m3_array) {
+  std::vector<cutlass::half_t> source = test::core::host::all_values<cutlass::half_t>();
+  test::core::host::run_test<cutlass::float_e4m3_t, cutlass::half_t, 4>(source);
+  test::core::host::run_test<cutlass::float_e4m3_t, cutlass::half_t, 27>(source);
+}
+
+TEST(NumericConversion, host_f16_to_fe5m2_array) {
+  std::vector<cutlass::half_t> source = test::core::host::all_values<cutlass::half_t>();
+  test::core::host::run_test<cutlass::float_e5m2_t, cutlass::half_t, 4>(source);
+  test::core::host::run_test<cutlass::float_e5m2_t, cutlass::half_t, 27>(source);
+}
+
+TEST(NumericConversion, host_bf16_to_fe4m3_array) {
+  std::vector<cutlass::bfloat16_t> source = test::core::host::all_values<cutlass::bfloat16_t>();
+  test::core::host::run_test<cutlass::float_e4m3_t, cutlass::bfloat16_t, 4>(source);
+  test::core::host::run_test<cutlass::float_e4m3_t, cutlass::bfloat16_t, 27>(source);
+}
+
+TEST(NumericConversion, host_bf16_to_fe5m2_array) {
+  std::vector<cutlass::bfloat16_t> source = test::core::host::all_values<cutlass::bfloat16_t>();
+  test::core::host::run_test<cutlass::float_e5m2_t, cutlass::bfloat16_t, 4>(source);
+  test::core::host::run_test<cutlass::float_e5m2_t, cutlass::bfloat16_t, 27>(source);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
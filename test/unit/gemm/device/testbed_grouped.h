@@ -47,7 +47,7 @@
 #include "cutlass/gemm/device/gemm_grouped.h"
 
 #include "cutlass/util/host_tensor.h"
-#include "cutlass/util/reference/host/gemm_complex.h"
+#include "cutlass/util/reference/host/gemm_grouped.h"
 #include "cutlass/util/reference/host/tensor_compare.h"
 #include "cutlass/util/reference/host/tensor_copy.h"
 #include "cutlass/util/reference/host/tensor_fill.h"
@@ -338,6 +338,53 @@ struct TestbedGrouped {
 
     bool passed = true;
 
+    std::vector<ElementA> host_A(block_A.size());
+    std::vector<ElementB> host_B(block_B.size());
+    std::vector<ElementC> host_C(block_C.size());
+    std::vector<ElementC> host_D(block_D.size());
+    std::vector<ElementC> host_Ref(block_D.size());
+
+    block_A.copy_to_host(host_A.data());
+    block_B.copy_to_host(host_B.data());
+    block_C.copy_to_host(host_C.data());
+    block_D.copy_to_host(host_D.data());
+
+    std::vector<ElementA *> ptr_A_host(problem_count);
+    std::vector<ElementB *> ptr_B_host(problem_count);
+    std::vector<ElementC *> ptr_C_host(problem_count);
+    std::vector<ElementC *> ptr_Ref_host(problem_count);
+
+    for (int32_t i = 0; i < problem_count; ++i) {
+      ptr_A_host.at(i) = host_A.data() + offset_A.at(i);
+      ptr_B_host.at(i) = host_B.data() + offset_B.at(i);
+      ptr_C_host.at(i) = host_C.data() + offset_C.at(i);
+      ptr_Ref_host.at(i) = host_Ref.data() + offset_D.at(i);
+    }
+
+    // Reference GEMM over the whole group
+    cutlass::reference::host::GemmGrouped<
+        ElementA, LayoutA,
+        ElementB, LayoutB,
+        ElementC, LayoutC, 
+        ElementCompute, ElementAccumulator
+    >(
+      problem_sizes_host.data(),
+      problem_count,
+      alpha, 
+      ptr_A_host.data(),
+      lda_host.data(),
+      Gemm::kTransformA,
+      ptr_B_host.data(),
+      ldb_host.data(),
+      Gemm::kTransformB,
+      beta, 
+      ptr_C_host.data(),
+      ldc_host.data(),
+      ptr_Ref_host.data(),
+      ldd_host.data(),
+      ElementAccumulator(0)
+    );
+
     for (int32_t i = 0; i < problem_count; ++i) {
       cutlass::gemm::GemmCoord problem = problem_sizes_host.at(i);
 
@@ -349,42 +396,12 @@ struct TestbedGrouped {
       MatrixCoord extent_A{problem.m(), problem.k()};
       MatrixCoord extent_B{problem.k(), problem.n()};
       MatrixCoord extent_C{problem.m(), problem.n()};
-      
-      std::vector<ElementA> matrix_A(layout_A.capacity(extent_A));
-      std::vector<ElementB> matrix_B(layout_B.capacity(extent_B));
-      std::vector<ElementC> matrix_C(layout_C.capacity(extent_C));
-      std::vector<ElementC> matrix_D(layout_D.capacity(extent_C));
-      std::vector<ElementC> matrix_Ref(layout_D.capacity(extent_C));
-
-      cutlass::device_memory::copy_to_host(matrix_A.data(), block_A.get() + offset_A.at(i), matrix_A.size());
-      cutlass::device_memory::copy_to_host(matrix_B.data(), block_B.get() + offset_B.at(i), matrix_B.size());
-      cutlass::device_memory::copy_to_host(matrix_C.data(), block_C.get() + offset_C.at(i), matrix_C.size());
-      cutlass::device_memory::copy_to_host(matrix_D.data(), block_D.get() + offset_D.at(i), matrix_D.size());
-
-      cutlass::TensorView<ElementA, LayoutA> view_A(matrix_A.data(), layout_A, extent_A);
-      cutlass::TensorView<ElementB, LayoutB> view_B(matrix_B.data(), layout_B, extent_B);
-      cutlass::TensorView<ElementC, LayoutC> view_C(matrix_C.data(), layout_C, extent_C);
-      cutlass::TensorView<ElementC, LayoutC> view_D(matrix_D.data(), layout_D, extent_C);
-      cutlass::TensorView<ElementC, LayoutC> view_Ref(matrix_Ref.data(), layout_D, extent_C);
-
-      // Reference GEMM
-      cutlass::reference::host::GemmComplex<
-          ElementA, LayoutA,
-          ElementB, LayoutB,
-          ElementC, LayoutC, 
-          ElementCompute, ElementAccumulator
-      >(
-        problem,
-        alpha, 
-        view_A,
-        Gemm::kTransformA,
-        view_B,
-        Gemm::kTransformB,
-        beta, 
-        view_C, 
-        view_Ref, 
-        ElementAccumulator(0)
-      );
+
+      cutlass::TensorView<ElementA, LayoutA> view_A(ptr_A_host.at(i), layout_A, extent_A);
+      cutlass::TensorView<ElementB, LayoutB> view_B(ptr_B_host.at(i), layout_B, extent_B);
+      cutlass::TensorView<ElementC, LayoutC> view_C(ptr_C_host.at(i), layout_C, extent_C);
+      cutlass::TensorView<ElementC, LayoutC> view_D(host_D.data() + offset_D.at(i), layout_D, extent_C);
+      cutlass::TensorView<ElementC, LayoutC> view_Ref(ptr_Ref_host.at(i), layout_D, extent_C);
 
       // Ensure that no input or output is entirely zero
       EXPECT_GT(cutlass::reference::host::TensorNorm(view_A), 0);
@@ -231,13 +231,16 @@ struct TestbedRank2KUniversal {
     EXPECT_GT(cutlass::reference::host::TensorNorm(tensor_B.host_view()), 0);
     EXPECT_GT(cutlass::reference::host::TensorNorm(tensor_C.host_view()), 0);
 
+    cutlass::reference::host::ErrorMetrics metrics =
+      cutlass::reference::host::TensorErrorMetrics(reference_D.host_view(), tensor_D.host_view());
+
     if (tensor_D.size() > 1)
-      EXPECT_GT(cutlass::reference::host::TensorNorm(tensor_D.host_view()), 0);
+      EXPECT_GT(metrics.reference_norm(), 0);
 
     if (reference_D.size() > 1)
-      EXPECT_GT(cutlass::reference::host::TensorNorm(reference_D.host_view()), 0);
+      EXPECT_GT(metrics.computed_norm(), 0);
 
-    double l2_norm = cutlass::reference::host::TensorRelativeErrorMetric(reference_D.host_view(), tensor_D.host_view());
+    double l2_norm = metrics.relative_error();
 
     bool passed = l2_norm < cutlass::MantissaInBits<typename Rank2K::ElementA>::error;
 
@@ -50,8 +50,8 @@
 #include "cutlass/util/reference/host/tensor_compare.h"
 #include "cutlass/util/reference/host/tensor_norm.h"
 #include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/gemm_sparse.h"
 #include "cutlass/util/host_reorder.h"
-#include "cutlass/util/host_uncompress.h"
 
 #include "testbed_utils.h"
 
@@ -84,7 +84,6 @@ struct SparseTestbed {
   uint64_t seed;
 
   cutlass::HostTensor<typename Gemm::ElementA, typename Gemm::LayoutA> tensor_A;
-  cutlass::HostTensor<typename Gemm::ElementA, typename Gemm::LayoutA> tensor_A_uncompressed;
   cutlass::HostTensor<typename Gemm::ElementB, typename Gemm::LayoutB> tensor_B;
   cutlass::HostTensor<typename Gemm::ElementC, typename Gemm::LayoutC> tensor_C;
   cutlass::HostTensor<typename Gemm::ElementC, typename Gemm::LayoutC> tensor_D;
@@ -166,7 +165,6 @@ struct SparseTestbed {
     // Allocate the GEMM workspace
     //
     tensor_A.resize(cutlass::make_Coord(problem_size.m(), problem_size.k() / kSparse));
-    tensor_A_uncompressed.resize(problem_size.mk());
     tensor_B.resize(problem_size.kn());
     tensor_C.resize(problem_size.mn());
     tensor_D.resize(problem_size.mn());
@@ -277,22 +275,21 @@ struct SparseTestbed {
     // Verify
     //
 
-    cutlass::uncompress(tensor_A_uncompressed.host_ref(), tensor_A.host_ref(),
-                        tensor_E.host_ref(), problem_size.m(), problem_size.k());
-
-    cutlass::reference::host::Gemm<
+    cutlass::reference::host::SparseGemm<
         typename Gemm::ElementA, typename Gemm::LayoutA,
         typename Gemm::ElementB, typename Gemm::LayoutB,
         typename Gemm::ElementC, typename Gemm::LayoutC, 
         ElementCompute,
-        ElementAccumulator, typename Gemm::Operator>
+        ElementAccumulator,
+        ElementE, ReorderedLayoutE, typename Gemm::Operator>
         reference_gemm;
 
     reference_gemm(
       problem_size,
       alpha, 
-      tensor_A_uncompressed.host_ref(), 
+      tensor_A.host_ref(), 
       tensor_B.host_ref(), 
+      tensor_E_reordered.host_ref(),
       beta, 
       reference_D.host_ref(),
       ElementAccumulator(0)
@@ -0,0 +1,218 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the host reference TRMM, SYMM and rank 2k update against a naive loop over
+      the full matrices.
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/blas3.h"
+#include "cutlass/layout/matrix.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/rank_2k.h"
+#include "cutlass/util/reference/host/symm.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+#include "cutlass/util/reference/host/trmm.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Returns element (row, col) of the matrix represented by the triangle of 'tensor'
+template <typename Element, typename Layout>
+float Blas3Element(
+  cutlass::HostTensor<Element, Layout> &tensor,
+  cutlass::FillMode fill_mode,
+  cutlass::DiagType diag_type,
+  bool symmetric,
+  int row,
+  int col) {
+
+  bool in_triangle = (fill_mode == cutlass::FillMode::kLower ? row >= col : row <= col);
+
+  if (row == col && diag_type == cutlass::DiagType::kUnit) {
+    return 1;
+  }
+  if (in_triangle) {
+    return float(tensor.at({row, col}));
+  }
+  return symmetric ? float(tensor.at({col, row})) : 0;
+}
+
+/// Verifies D = alpha * op(A) * B or D = alpha * B * op(A) for a TRMM (symmetric = false) or
+/// D = alpha * op(A) * B + beta * C or D = alpha * B * op(A) + beta * C for a SYMM
+template <cutlass::SideMode kSideMode, cutlass::FillMode kFillMode, cutlass::DiagType kDiagType, bool kSymmetric>
+bool TestHostBlas3(int M, int N) {
+
+  using Layout = cutlass::layout::ColumnMajor;
+
+  int const K = (kSideMode == cutlass::SideMode::kLeft ? M : N);
+
+  cutlass::HostTensor<float, Layout> tensor_A({K, K});
+  cutlass::HostTensor<float, Layout> tensor_B({M, N});
+  cutlass::HostTensor<float, Layout> tensor_C({M, N});
+  cutlass::HostTensor<float, Layout> tensor_D({M, N});
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, 0);
+
+  float alpha = 2;
+  float beta = (kSymmetric ? -1 : 0);
+
+  if (kSymmetric) {
+    cutlass::reference::host::compute_symm<
+      float, Layout, kSideMode, kFillMode,
+      float, Layout,
+      float, Layout,
+      float, float>(
+        {M, N, K}, alpha, tensor_A.host_ref(), tensor_B.host_ref(), beta,
+        tensor_C.host_ref(), tensor_D.host_ref(), 0.0f);
+  }
+  else {
+    cutlass::reference::host::compute_trmm<
+      float, Layout, kSideMode, kFillMode, kDiagType,
+      float, Layout,
+      float, Layout,
+      float, float>(
+        {M, N, K}, alpha, tensor_A.host_ref(), tensor_B.host_ref(), tensor_D.host_ref(), 0.0f);
+  }
+
+  for (int m = 0; m < M; ++m) {
+    for (int n = 0; n < N; ++n) {
+
+      float accum = 0;
+
+      for (int k = 0; k < K; ++k) {
+        if (kSideMode == cutlass::SideMode::kLeft) {
+          accum += Blas3Element(tensor_A, kFillMode, kDiagType, kSymmetric, m, k) * tensor_B.at({k, n});
+        }
+        else {
+          accum += tensor_B.at({m, k}) * Blas3Element(tensor_A, kFillMode, kDiagType, kSymmetric, k, n);
+        }
+      }
+
+      if (tensor_D.at({m, n}) != alpha * accum + beta * tensor_C.at({m, n})) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/// Verifies D = alpha * (A * B^T + B * A^T) + beta * C within the triangle of C and that elements
+/// of D outside the triangle are not written
+template <cutlass::FillMode kFillMode>
+bool TestHostRank2K(int N, int K) {
+
+  using Layout = cutlass::layout::RowMajor;
+
+  cutlass::HostTensor<float, Layout> tensor_A({N, K});
+  cutlass::HostTensor<float, Layout> tensor_B({N, K});
+  cutlass::HostTensor<float, Layout> tensor_C({N, N});
+  cutlass::HostTensor<float, Layout> tensor_D({N, N});
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, 0);
+  cutlass::reference::host::TensorFill(tensor_D.host_view(), 99.0f);
+
+  float alpha = 2;
+  float beta = -1;
+
+  cutlass::reference::host::compute_rank2k<
+    float, Layout,
+    float, Layout,
+    float, Layout, kFillMode,
+    float, float>(
+      {N, N, K}, alpha, tensor_A.host_ref(), tensor_B.host_ref(), beta,
+      tensor_C.host_ref(), tensor_D.host_ref(), 0.0f);
+
+  for (int m = 0; m < N; ++m) {
+    for (int n = 0; n < N; ++n) {
+
+      float expected = 99;
+
+      if (kFillMode == cutlass::FillMode::kLower ? m >= n : m <= n) {
+        float accum = 0;
+        for (int k = 0; k < K; ++k) {
+          accum += tensor_A.at({m, k}) * tensor_B.at({n, k}) + tensor_B.at({m, k}) * tensor_A.at({n, k});
+        }
+        expected = alpha * accum + beta * tensor_C.at({m, n});
+      }
+
+      if (tensor_D.at({m, n}) != expected) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostTrmm, left_lower_nonunit) {
+  EXPECT_TRUE((test::util::TestHostBlas3<
+    cutlass::SideMode::kLeft, cutlass::FillMode::kLower, cutlass::DiagType::kNonUnit, false>(131, 75)));
+}
+
+TEST(ReferenceHostTrmm, right_upper_unit) {
+  EXPECT_TRUE((test::util::TestHostBlas3<
+    cutlass::SideMode::kRight, cutlass::FillMode::kUpper, cutlass::DiagType::kUnit, false>(57, 140)));
+}
+
+TEST(ReferenceHostSymm, left_upper) {
+  EXPECT_TRUE((test::util::TestHostBlas3<
+    cutlass::SideMode::kLeft, cutlass::FillMode::kUpper, cutlass::DiagType::kNonUnit, true>(97, 64)));
+}
+
+TEST(ReferenceHostSymm, right_lower) {
+  EXPECT_TRUE((test::util::TestHostBlas3<
+    cutlass::SideMode::kRight, cutlass::FillMode::kLower, cutlass::DiagType::kNonUnit, true>(45, 118)));
+}
+
+TEST(ReferenceHostRank2K, lower) {
+  EXPECT_TRUE((test::util::TestHostRank2K<cutlass::FillMode::kLower>(150, 33)));
+}
+
+TEST(ReferenceHostRank2K, upper) {
+  EXPECT_TRUE((test::util::TestHostRank2K<cutlass::FillMode::kUpper>(67, 101)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,473 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the host reference convolutions against a direct loop nest.
+*/
+
+#include <limits>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/tensor.h"
+#include "cutlass/conv/conv2d_problem_size.h"
+#include "cutlass/conv/conv3d_problem_size.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/convolution.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Runs Fprop, Dgrad and Wgrad on the same problem and compares each against a single direct loop
+/// nest over (n, p, q, k, r, s, c) which scatters every product into y, dx and dw. If 'infinite'
+/// is true, operands hold positive values and the first elements of w and dy are infinite, so that
+/// exactly the outputs those elements contribute to are infinite.
+template <typename Element>
+bool TestHostConv2d(cutlass::conv::Conv2dProblemSize problem_size, bool infinite = false) {
+
+  using Layout = cutlass::layout::TensorNHWC;
+
+  cutlass::Tensor4DCoord extent_x(problem_size.N, problem_size.H, problem_size.W, problem_size.C);
+  cutlass::Tensor4DCoord extent_w(problem_size.K, problem_size.R, problem_size.S, problem_size.C);
+  cutlass::Tensor4DCoord extent_y(problem_size.N, problem_size.P, problem_size.Q, problem_size.K);
+
+  cutlass::HostTensor<Element, Layout> x(extent_x);
+  cutlass::HostTensor<Element, Layout> w(extent_w);
+  cutlass::HostTensor<Element, Layout> dy(extent_y);
+
+  double const min_value = (infinite ? 1 : -3);
+
+  cutlass::reference::host::TensorFillRandomUniform(x.host_view(), 2017, 3, min_value, 0);
+  cutlass::reference::host::TensorFillRandomUniform(w.host_view(), 2018, 3, min_value, 0);
+  cutlass::reference::host::TensorFillRandomUniform(dy.host_view(), 2019, 3, min_value, 0);
+
+  if (infinite) {
+    w.at({0, 0, 0, 0}) = std::numeric_limits<Element>::infinity();
+    dy.at({0, 0, 0, 0}) = std::numeric_limits<Element>::infinity();
+  }
+
+  cutlass::HostTensor<float, Layout> y_expected(extent_y);
+  cutlass::HostTensor<float, Layout> dx_expected(extent_x);
+  cutlass::HostTensor<float, Layout> dw_expected(extent_w);
+
+  cutlass::reference::host::TensorFill(y_expected.host_view());
+  cutlass::reference::host::TensorFill(dx_expected.host_view());
+  cutlass::reference::host::TensorFill(dw_expected.host_view());
+
+  for (int n = 0; n < problem_size.N; ++n) {
+    for (int p = 0; p < problem_size.P; ++p) {
+      for (int q = 0; q < problem_size.Q; ++q) {
+        for (int k = 0; k < problem_size.K; ++k) {
+          for (int r = 0; r < problem_size.R; ++r) {
+            for (int s = 0; s < problem_size.S; ++s) {
+
+              int filter_r = r;
+              int filter_s = s;
+
+              if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
+                filter_r = problem_size.R - 1 - r;
+                filter_s = problem_size.S - 1 - s;
+              }
+
+              int h = p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h;
+              int v = q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w;
+
+              if (h < 0 || h >= problem_size.H || v < 0 || v >= problem_size.W) {
+                continue;
+              }
+
+              for (int c = 0; c < problem_size.C; ++c) {
+                float x_val = float(x.at({n, h, v, c}));
+                float w_val = float(w.at({k, r, s, c}));
+                float dy_val = float(dy.at({n, p, q, k}));
+
+                y_expected.at({n, p, q, k}) += x_val * w_val;
+                dx_expected.at({n, h, v, c}) += dy_val * w_val;
+                dw_expected.at({k, r, s, c}) += dy_val * x_val;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  cutlass::HostTensor<float, Layout> y(extent_y);
+  cutlass::HostTensor<float, Layout> dx(extent_x);
+  cutlass::HostTensor<float, Layout> dw(extent_w);
+
+  cutlass::reference::host::Conv2dFprop<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, x.host_ref(), w.host_ref(), y.host_ref(), y.host_ref(), 1.0f, 0.0f);
+
+  cutlass::reference::host::Conv2dDgrad<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, dy.host_ref(), w.host_ref(), dx.host_ref(), dx.host_ref(), 1.0f, 0.0f);
+
+  cutlass::reference::host::Conv2dWgrad<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, dy.host_ref(), x.host_ref(), dw.host_ref(), dw.host_ref(), 1.0f, 0.0f);
+
+  return cutlass::reference::host::TensorEquals(y.host_view(), y_expected.host_view()) &&
+    cutlass::reference::host::TensorEquals(dx.host_view(), dx_expected.host_view()) &&
+    cutlass::reference::host::TensorEquals(dw.host_view(), dw_expected.host_view());
+}
+
+/// Runs Conv2dFprop with one group per channel and Depsep_Fprop on the same depthwise problem and
+/// compares both against a direct loop nest over (n, p, q, c, r, s).
+template <typename Element>
+bool TestHostConv2dDepthwise(cutlass::conv::Conv2dProblemSize problem_size) {
+
+  using Layout = cutlass::layout::TensorNHWC;
+
+  cutlass::Tensor4DCoord extent_x(problem_size.N, problem_size.H, problem_size.W, problem_size.C);
+  cutlass::Tensor4DCoord extent_w(problem_size.K, problem_size.R, problem_size.S, 1);
+  cutlass::Tensor4DCoord extent_y(problem_size.N, problem_size.P, problem_size.Q, problem_size.K);
+
+  cutlass::HostTensor<Element, Layout> x(extent_x);
+  cutlass::HostTensor<Element, Layout> w(extent_w);
+  cutlass::HostTensor<float, Layout> c(extent_y);
+
+  cutlass::reference::host::TensorFillRandomUniform(x.host_view(), 2020, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(w.host_view(), 2021, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(c.host_view(), 2022, 3, -3, 0);
+
+  float const alpha = 2.0f;
+  float const beta = -1.0f;
+
+  cutlass::HostTensor<float, Layout> y_expected(extent_y);
+  cutlass::HostTensor<float, Layout> d_expected(extent_y);
+
+  for (int n = 0; n < problem_size.N; ++n) {
+    for (int p = 0; p < problem_size.P; ++p) {
+      for (int q = 0; q < problem_size.Q; ++q) {
+        for (int k = 0; k < problem_size.K; ++k) {
+
+          // Conv2dFprop flips the activation window and Depsep_Fprop flips the filter
+          float y_acc = 0;
+          float d_acc = 0;
+
+          for (int r = 0; r < problem_size.R; ++r) {
+            for (int s = 0; s < problem_size.S; ++s) {
+
+              int filter_r = r;
+              int filter_s = s;
+
+              if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
+                filter_r = problem_size.R - 1 - r;
+                filter_s = problem_size.S - 1 - s;
+              }
+
+              int h = p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h;
+              int v = q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w;
+
+              if (h >= 0 && h < problem_size.H && v >= 0 && v < problem_size.W) {
+                y_acc += float(x.at({n, h, v, k})) * float(w.at({k, r, s, 0}));
+              }
+
+              h = p * problem_size.stride_h - problem_size.pad_h + r * problem_size.dilation_h;
+              v = q * problem_size.stride_w - problem_size.pad_w + s * problem_size.dilation_w;
+
+              if (h >= 0 && h < problem_size.H && v >= 0 && v < problem_size.W) {
+                d_acc += float(x.at({n, h, v, k})) * float(w.at({k, filter_r, filter_s, 0}));
+              }
+            }
+          }
+
+          y_expected.at({n, p, q, k}) = alpha * y_acc + beta * c.at({n, p, q, k});
+          d_expected.at({n, p, q, k}) = alpha * d_acc + beta * c.at({n, p, q, k});
+        }
+      }
+    }
+  }
+
+  cutlass::HostTensor<float, Layout> y(extent_y);
+  cutlass::HostTensor<float, Layout> d(extent_y);
+
+  cutlass::reference::host::Conv2dFprop<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, x.host_ref(), w.host_ref(), c.host_ref(), y.host_ref(), alpha, beta);
+
+  cutlass::reference::host::Depsep_Fprop<Element, Layout, Element, Layout, float, Layout, float>(
+    x.host_view(), w.host_view(), c.host_view(), d.host_view(), alpha, beta,
+    cutlass::Tensor4DCoord(problem_size.pad_h, 0, problem_size.pad_w, 0),
+    cutlass::make_Coord(problem_size.stride_h, problem_size.stride_w),
+    cutlass::make_Coord(problem_size.dilation_h, problem_size.dilation_w),
+    problem_size.mode);
+
+  return cutlass::reference::host::TensorEquals(y.host_view(), y_expected.host_view()) &&
+    cutlass::reference::host::TensorEquals(d.host_view(), d_expected.host_view());
+}
+
+/// Runs Conv3dFprop, Conv3dDgrad and Conv3dWgrad on the same problem and compares each against a
+/// direct loop nest over (n, z, p, q, k, t, r, s, c). 'infinite' is as for TestHostConv2d.
+template <typename Element>
+bool TestHostConv3d(cutlass::conv::Conv3dProblemSize problem_size, bool infinite = false) {
+
+  using Layout = cutlass::layout::TensorNDHWC;
+
+  cutlass::Tensor5DCoord extent_x(
+    problem_size.N, problem_size.D, problem_size.H, problem_size.W, problem_size.C);
+  cutlass::Tensor5DCoord extent_w(
+    problem_size.K, problem_size.T, problem_size.R, problem_size.S, problem_size.C);
+  cutlass::Tensor5DCoord extent_y(
+    problem_size.N, problem_size.Z, problem_size.P, problem_size.Q, problem_size.K);
+
+  cutlass::HostTensor<Element, Layout> x(extent_x);
+  cutlass::HostTensor<Element, Layout> w(extent_w);
+  cutlass::HostTensor<Element, Layout> dy(extent_y);
+
+  double const min_value = (infinite ? 1 : -3);
+
+  cutlass::reference::host::TensorFillRandomUniform(x.host_view(), 2017, 3, min_value, 0);
+  cutlass::reference::host::TensorFillRandomUniform(w.host_view(), 2018, 3, min_value, 0);
+  cutlass::reference::host::TensorFillRandomUniform(dy.host_view(), 2019, 3, min_value, 0);
+
+  if (infinite) {
+    w.at({0, 0, 0, 0, 0}) = std::numeric_limits<Element>::infinity();
+    dy.at({0, 0, 0, 0, 0}) = std::numeric_limits<Element>::infinity();
+  }
+
+  cutlass::HostTensor<float, Layout> y_expected(extent_y);
+  cutlass::HostTensor<float, Layout> dx_expected(extent_x);
+  cutlass::HostTensor<float, Layout> dw_expected(extent_w);
+
+  cutlass::reference::host::TensorFill(y_expected.host_view());
+  cutlass::reference::host::TensorFill(dx_expected.host_view());
+  cutlass::reference::host::TensorFill(dw_expected.host_view());
+
+  for (int n = 0; n < problem_size.N; ++n) {
+    for (int z = 0; z < problem_size.Z; ++z) {
+      for (int p = 0; p < problem_size.P; ++p) {
+        for (int q = 0; q < problem_size.Q; ++q) {
+          for (int k = 0; k < problem_size.K; ++k) {
+            for (int t = 0; t < problem_size.T; ++t) {
+              for (int r = 0; r < problem_size.R; ++r) {
+                for (int s = 0; s < problem_size.S; ++s) {
+
+                  int filter_t = t;
+                  int filter_r = r;
+                  int filter_s = s;
+
+                  if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
+                    filter_t = problem_size.T - 1 - t;
+                    filter_r = problem_size.R - 1 - r;
+                    filter_s = problem_size.S - 1 - s;
+                  }
+
+                  int d = z * problem_size.stride_d - problem_size.pad_d + filter_t * problem_size.dilation_d;
+                  int h = p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h;
+                  int v = q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w;
+
+                  if (d < 0 || d >= problem_size.D ||
+                      h < 0 || h >= problem_size.H ||
+                      v < 0 || v >= problem_size.W) {
+                    continue;
+                  }
+
+                  for (int c = 0; c < problem_size.C; ++c) {
+                    float x_val = float(x.at({n, d, h, v, c}));
+                    float w_val = float(w.at({k, t, r, s, c}));
+                    float dy_val = float(dy.at({n, z, p, q, k}));
+
+                    y_expected.at({n, z, p, q, k}) += x_val * w_val;
+                    dx_expected.at({n, d, h, v, c}) += dy_val * w_val;
+                    dw_expected.at({k, t, r, s, c}) += dy_val * x_val;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  cutlass::HostTensor<float, Layout> y(extent_y);
+  cutlass::HostTensor<float, Layout> dx(extent_x);
+  cutlass::HostTensor<float, Layout> dw(extent_w);
+
+  cutlass::reference::host::Conv3dFprop<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, x.host_ref(), w.host_ref(), y.host_ref(), y.host_ref(), 1.0f, 0.0f);
+
+  cutlass::reference::host::Conv3dDgrad<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, dy.host_ref(), w.host_ref(), dx.host_ref(), dx.host_ref(), 1.0f, 0.0f);
+
+  cutlass::reference::host::Conv3dWgrad<Element, Layout, Element, Layout, float, Layout, float>(
+    problem_size, dy.host_ref(), x.host_ref(), dw.host_ref(), dw.host_ref(), 1.0f, 0.0f);
+
+  return cutlass::reference::host::TensorEquals(y.host_view(), y_expected.host_view()) &&
+    cutlass::reference::host::TensorEquals(dx.host_view(), dx_expected.host_view()) &&
+    cutlass::reference::host::TensorEquals(dw.host_view(), dw_expected.host_view());
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostConv2d, f32_3x3_pad1) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {2, 15, 13, 24},                              // input size (NHWC)
+    {40, 3, 3, 24},                               // filter size (KRSC)
+    {1, 1, 1, 1},                                 // padding (pad_h, _, pad_w, _)
+    {1, 1},                                       // stride (stride_h, stride_w)
+    {1, 1},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kCrossCorrelation);
+
+  EXPECT_TRUE(test::util::TestHostConv2d<float>(problem_size));
+}
+
+TEST(ReferenceHostConv2d, f16_strided_dilated_convolution) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {1, 17, 19, 16},                              // input size (NHWC)
+    {24, 3, 2, 16},                               // filter size (KRSC)
+    {2, 0, 1, 0},                                 // padding (pad_h, _, pad_w, _)
+    {2, 3},                                       // stride (stride_h, stride_w)
+    {2, 1},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kConvolution);
+
+  EXPECT_TRUE(test::util::TestHostConv2d<cutlass::half_t>(problem_size));
+}
+
+TEST(ReferenceHostConv2d, f32_3x3_pad1_infinite) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {2, 15, 13, 24},                              // input size (NHWC)
+    {40, 3, 3, 24},                               // filter size (KRSC)
+    {1, 1, 1, 1},                                 // padding (pad_h, _, pad_w, _)
+    {1, 1},                                       // stride (stride_h, stride_w)
+    {1, 1},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kCrossCorrelation);
+
+  EXPECT_TRUE(test::util::TestHostConv2d<float>(problem_size, true));
+}
+
+TEST(ReferenceHostConv2d, f32_strided_infinite) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {2, 19, 17, 16},                              // input size (NHWC)
+    {24, 3, 3, 16},                               // filter size (KRSC)
+    {1, 1, 2, 2},                                 // padding (pad_h, _, pad_w, _)
+    {2, 2},                                       // stride (stride_h, stride_w)
+    {1, 2},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kConvolution);
+
+  EXPECT_TRUE(test::util::TestHostConv2d<float>(problem_size, true));
+}
+
+TEST(ReferenceHostConv2d, f32_strided_infinite_small) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {1, 7, 6, 3},                                 // input size (NHWC)
+    {4, 3, 3, 3},                                 // filter size (KRSC)
+    {1, 1, 1, 1},                                 // padding (pad_h, _, pad_w, _)
+    {2, 2},                                       // stride (stride_h, stride_w)
+    {1, 1},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kCrossCorrelation);
+
+  EXPECT_TRUE(test::util::TestHostConv2d<float>(problem_size, true));
+}
+
+TEST(ReferenceHostConv2d, f32_depthwise_strided_dilated) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {2, 21, 18, 40},                              // input size (NHWC)
+    {40, 5, 3, 1},                                // filter size (KRSC)
+    {2, 0, 3, 0},                                 // padding (pad_h, _, pad_w, _)
+    {2, 1},                                       // stride (stride_h, stride_w)
+    {1, 3},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kCrossCorrelation,
+    1,                                            // split-k slices
+    40);                                          // groups
+
+  EXPECT_TRUE(test::util::TestHostConv2dDepthwise<float>(problem_size));
+}
+
+TEST(ReferenceHostConv2d, f16_depthwise_convolution) {
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {1, 14, 15, 21},                              // input size (NHWC)
+    {21, 3, 3, 1},                                // filter size (KRSC)
+    {1, 0, 1, 0},                                 // padding (pad_h, _, pad_w, _)
+    {1, 2},                                       // stride (stride_h, stride_w)
+    {2, 1},                                       // dilation (dilation_h, dilation_w)
+    cutlass::conv::Mode::kConvolution,
+    1,                                            // split-k slices
+    21);                                          // groups
+
+  EXPECT_TRUE(test::util::TestHostConv2dDepthwise<cutlass::half_t>(problem_size));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostConv3d, f32_strided_dilated_convolution) {
+
+  cutlass::conv::Conv3dProblemSize problem_size(
+    {2, 7, 9, 8, 12},                             // input size (NDHWC)
+    {16, 3, 2, 3, 12},                            // filter size (KTRSC)
+    cutlass::Coord<3>({1, 0, 1}),                 // padding (pad_d, pad_h, pad_w)
+    cutlass::Coord<3>({2, 1, 2}),                 // stride (stride_d, stride_h, stride_w)
+    cutlass::Coord<3>({1, 2, 1}),                 // dilation (dilation_d, dilation_h, dilation_w)
+    cutlass::conv::Mode::kConvolution);
+
+  EXPECT_TRUE(test::util::TestHostConv3d<float>(problem_size));
+}
+
+TEST(ReferenceHostConv3d, f32_strided_dilated_infinite) {
+
+  cutlass::conv::Conv3dProblemSize problem_size(
+    {2, 7, 9, 8, 12},                             // input size (NDHWC)
+    {16, 3, 2, 3, 12},                            // filter size (KTRSC)
+    cutlass::Coord<3>({1, 0, 1}),                 // padding (pad_d, pad_h, pad_w)
+    cutlass::Coord<3>({2, 1, 2}),                 // stride (stride_d, stride_h, stride_w)
+    cutlass::Coord<3>({1, 2, 1}),                 // dilation (dilation_d, dilation_h, dilation_w)
+    cutlass::conv::Mode::kConvolution);
+
+  EXPECT_TRUE(test::util::TestHostConv3d<float>(problem_size, true));
+}
+
+TEST(ReferenceHostConv3d, f32_strided_infinite_small) {
+
+  cutlass::conv::Conv3dProblemSize problem_size(
+    {1, 5, 6, 5, 3},                              // input size (NDHWC)
+    {4, 3, 3, 3, 3},                              // filter size (KTRSC)
+    cutlass::Coord<3>({1, 1, 1}),                 // padding (pad_d, pad_h, pad_w)
+    cutlass::Coord<3>({2, 2, 2}),                 // stride (stride_d, stride_h, stride_w)
+    cutlass::Coord<3>({1, 1, 1}),                 // dilation (dilation_d, dilation_h, dilation_w)
+    cutlass::conv::Mode::kCrossCorrelation);
+
+  EXPECT_TRUE(test::util::TestHostConv3d<float>(problem_size, true));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
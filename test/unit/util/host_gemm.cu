@@ -0,0 +1,1043 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the host reference GEMM against a naive triple loop.
+*/
+
+#include <cmath>
+#include <limits>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/complex.h"
+#include "cutlass/functional.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/quaternion.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/host_tensor_planar_complex.h"
+#include "cutlass/util/host_reorder.h"
+#include "cutlass/util/host_uncompress.h"
+#include "cutlass/util/reference/host/ell_gemm.h"
+#include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/gemm_complex.h"
+#include "cutlass/util/reference/host/gemm_grouped.h"
+#include "cutlass/util/reference/host/gemm_planar_complex.h"
+#include "cutlass/util/reference/host/gemm_sparse.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_copy.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Computes D = alpha * A * B + beta * C with an unblocked loop of multiply_add and compares
+/// against the host reference GEMM. Operands hold small integers unless 'bits' is negative, in
+/// which case the engine must still match the unblocked loop bit for bit.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ComputeType
+>
+bool TestHostGemm(
+  cutlass::gemm::GemmCoord problem_size,
+  ComputeType alpha,
+  ComputeType beta,
+  int bits = 0) {
+
+  cutlass::HostTensor<ElementA, LayoutA> tensor_A(problem_size.mk());
+  cutlass::HostTensor<ElementB, LayoutB> tensor_B(problem_size.kn());
+  cutlass::HostTensor<ElementC, LayoutC> tensor_C(problem_size.mn());
+  cutlass::HostTensor<ElementC, LayoutC> tensor_D(problem_size.mn());
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, bits);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, bits);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, bits);
+
+  cutlass::reference::host::Gemm<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ComputeType, ComputeType> gemm;
+
+  gemm(
+    problem_size,
+    alpha,
+    tensor_A.host_ref(),
+    tensor_B.host_ref(),
+    beta,
+    tensor_C.host_ref(),
+    tensor_D.host_ref());
+
+  for (int m = 0; m < problem_size.m(); ++m) {
+    for (int n = 0; n < problem_size.n(); ++n) {
+
+      ComputeType accum = ComputeType(0);
+
+      for (int k = 0; k < problem_size.k(); ++k) {
+        accum = cutlass::multiply_add<ComputeType>()(
+          ComputeType(tensor_A.at({m, k})), ComputeType(tensor_B.at({k, n})), accum);
+      }
+
+      ElementC expected = ElementC(alpha * accum + beta * ComputeType(tensor_C.at({m, n})));
+
+      if (!(tensor_D.at({m, n}) == expected)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/// Computes a batch of complex GEMMs with conjugated operands using an unblocked loop and compares
+/// against the host reference GemmComplex.
+template <typename Element, typename LayoutA, typename LayoutB>
+bool TestHostGemmComplex(
+  cutlass::gemm::GemmCoord problem_size,
+  int batch_count,
+  cutlass::ComplexTransform transform_a,
+  cutlass::ComplexTransform transform_b) {
+
+  using LayoutC = cutlass::layout::ColumnMajor;
+
+  int const M = problem_size.m();
+  int const N = problem_size.n();
+  int const K = problem_size.k();
+
+  // Problems of the batch are stored side by side along the columns of each tensor
+  cutlass::HostTensor<Element, LayoutA> tensor_A({M, K * batch_count});
+  cutlass::HostTensor<Element, LayoutB> tensor_B({K, N * batch_count});
+  cutlass::HostTensor<Element, LayoutC> tensor_C({M, N * batch_count});
+  cutlass::HostTensor<Element, LayoutC> tensor_D({M, N * batch_count});
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, 0);
+
+  int64_t batch_stride_A = tensor_A.layout()({0, K});
+  int64_t batch_stride_B = tensor_B.layout()({0, N});
+  int64_t batch_stride_C = tensor_C.layout()({0, N});
+
+  Element alpha(2, -1);
+  Element beta(-1, 1);
+
+  cutlass::reference::host::GemmComplex<
+    Element, LayoutA,
+    Element, LayoutB,
+    Element, LayoutC,
+    Element, Element>(
+      problem_size,
+      alpha,
+      tensor_A.host_ref(),
+      transform_a,
+      tensor_B.host_ref(),
+      transform_b,
+      beta,
+      tensor_C.host_ref(),
+      tensor_D.host_ref(),
+      Element(),
+      batch_count,
+      batch_stride_A,
+      batch_stride_B,
+      batch_stride_C,
+      batch_stride_C);
+
+  for (int batch_idx = 0; batch_idx < batch_count; ++batch_idx) {
+    for (int m = 0; m < M; ++m) {
+      for (int n = 0; n < N; ++n) {
+
+        Element accum = Element();
+
+        for (int k = 0; k < K; ++k) {
+          Element a = tensor_A.at({m, batch_idx * K + k});
+          Element b = tensor_B.at({k, batch_idx * N + n});
+
+          if (transform_a == cutlass::ComplexTransform::kConjugate) {
+            a = cutlass::conj(a);
+          }
+          if (transform_b == cutlass::ComplexTransform::kConjugate) {
+            b = cutlass::conj(b);
+          }
+
+          accum += a * b;
+        }
+
+        Element expected = alpha * accum + beta * tensor_C.at({m, batch_idx * N + n});
+
+        if (!(tensor_D.at({m, batch_idx * N + n}) == expected)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+/// Computes a batch of GEMMs stored at constant strides using an unblocked loop and compares
+/// against the strided host reference BatchedGemm.
+template <typename Element, typename LayoutA, typename LayoutB, typename ComputeType>
+bool TestHostBatchedGemm(cutlass::gemm::GemmCoord problem_size, int batch_count) {
+
+  using LayoutC = cutlass::layout::ColumnMajor;
+
+  int const M = problem_size.m();
+  int const N = problem_size.n();
+  int const K = problem_size.k();
+
+  // Problems of the batch are stored side by side along the columns of each tensor
+  cutlass::HostTensor<Element, LayoutA> tensor_A({M, K * batch_count});
+  cutlass::HostTensor<Element, LayoutB> tensor_B({K, N * batch_count});
+  cutlass::HostTensor<Element, LayoutC> tensor_C({M, N * batch_count});
+  cutlass::HostTensor<Element, LayoutC> tensor_D({M, N * batch_count});
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, 0);
+
+  int64_t batch_stride_A = tensor_A.layout()({0, K});
+  int64_t batch_stride_B = tensor_B.layout()({0, N});
+  int64_t batch_stride_C = tensor_C.layout()({0, N});
+
+  ComputeType alpha = ComputeType(2);
+  ComputeType beta = ComputeType(-1);
+
+  cutlass::reference::host::BatchedGemm(
+    problem_size,
+    batch_count,
+    alpha,
+    tensor_A.host_ref(),
+    batch_stride_A,
+    tensor_B.host_ref(),
+    batch_stride_B,
+    beta,
+    tensor_C.host_ref(),
+    batch_stride_C,
+    tensor_D.host_ref(),
+    batch_stride_C,
+    ComputeType(0));
+
+  for (int batch_idx = 0; batch_idx < batch_count; ++batch_idx) {
+    for (int m = 0; m < M; ++m) {
+      for (int n = 0; n < N; ++n) {
+
+        ComputeType accum = ComputeType(0);
+
+        for (int k = 0; k < K; ++k) {
+          accum += ComputeType(tensor_A.at({m, batch_idx * K + k})) *
+                   ComputeType(tensor_B.at({k, batch_idx * N + n}));
+        }
+
+        Element expected = Element(alpha * accum + beta * ComputeType(tensor_C.at({m, batch_idx * N + n})));
+
+        if (!(tensor_D.at({m, batch_idx * N + n}) == expected)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+/// Computes a group of GEMMs of skewed sizes with the host reference GemmGrouped and compares each
+/// problem against GemmComplex. Operands hold arbitrary values, for which the results must be
+/// identical.
+template <typename Element, typename LayoutA, typename LayoutB>
+bool TestHostGemmGrouped(
+  std::vector<cutlass::gemm::GemmCoord> const &problem_sizes,
+  cutlass::ComplexTransform transform_a,
+  cutlass::ComplexTransform transform_b) {
+
+  using LayoutC = cutlass::layout::ColumnMajor;
+
+  int const problem_count = int(problem_sizes.size());
+
+  std::vector<cutlass::HostTensor<Element, LayoutA>> tensor_A(problem_count);
+  std::vector<cutlass::HostTensor<Element, LayoutB>> tensor_B(problem_count);
+  std::vector<cutlass::HostTensor<Element, LayoutC>> tensor_C(problem_count);
+  std::vector<cutlass::HostTensor<Element, LayoutC>> tensor_D(problem_count);
+
+  std::vector<Element *> ptr_A(problem_count), ptr_B(problem_count);
+  std::vector<Element *> ptr_C(problem_count), ptr_D(problem_count);
+  std::vector<int64_t> lda(problem_count), ldb(problem_count), ldc(problem_count);
+
+  for (int i = 0; i < problem_count; ++i) {
+    cutlass::gemm::GemmCoord problem = problem_sizes[i];
+
+    tensor_A[i].reset({problem.m(), problem.k()});
+    tensor_B[i].reset({problem.k(), problem.n()});
+    tensor_C[i].reset({problem.m(), problem.n()});
+    tensor_D[i].reset({problem.m(), problem.n()});
+
+    cutlass::reference::host::TensorFillRandomUniform(tensor_A[i].host_view(), 2019 + i, 3, -3, -1);
+    cutlass::reference::host::TensorFillRandomUniform(tensor_B[i].host_view(), 2119 + i, 3, -3, -1);
+    cutlass::reference::host::TensorFillRandomUniform(tensor_C[i].host_view(), 2219 + i, 3, -3, -1);
+
+    ptr_A[i] = tensor_A[i].host_data();
+    ptr_B[i] = tensor_B[i].host_data();
+    ptr_C[i] = tensor_C[i].host_data();
+    ptr_D[i] = tensor_D[i].host_data();
+
+    lda[i] = tensor_A[i].stride(0);
+    ldb[i] = tensor_B[i].stride(0);
+    ldc[i] = tensor_C[i].stride(0);
+  }
+
+  Element alpha(2);
+  Element beta(-1);
+
+  cutlass::reference::host::GemmGrouped<
+    Element, LayoutA,
+    Element, LayoutB,
+    Element, LayoutC,
+    Element, Element>(
+      problem_sizes.data(),
+      problem_count,
+      alpha,
+      ptr_A.data(),
+      lda.data(),
+      transform_a,
+      ptr_B.data(),
+      ldb.data(),
+      transform_b,
+      beta,
+      ptr_C.data(),
+      ldc.data(),
+      ptr_D.data(),
+      ldc.data(),
+      Element());
+
+  for (int i = 0; i < problem_count; ++i) {
+
+    cutlass::HostTensor<Element, LayoutC> tensor_Ref(tensor_C[i].extent());
+
+    cutlass::reference::host::GemmComplex(
+      problem_sizes[i],
+      alpha,
+      tensor_A[i].host_ref(),
+      transform_a,
+      tensor_B[i].host_ref(),
+      transform_b,
+      beta,
+      tensor_C[i].host_ref(),
+      tensor_Ref.host_ref(),
+      Element());
+
+    if (!cutlass::reference::host::TensorEquals(tensor_D[i].host_view(), tensor_Ref.host_view())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Computes a structured sparse GEMM from compressed A and reordered metadata and compares
+/// against a dense GEMM of the uncompressed operand. Operands hold arbitrary values, for which
+/// the results must be identical.
+template <
+  typename ElementA,
+  typename ElementB,
+  typename ElementC,
+  typename ElementE,
+  typename ComputeType,
+  int kMetaSizeInBits
+>
+bool TestHostSparseGemm(cutlass::gemm::GemmCoord problem_size) {
+
+  using LayoutA = cutlass::layout::RowMajor;
+  using LayoutB = cutlass::layout::ColumnMajor;
+  using LayoutC = cutlass::layout::RowMajor;
+  using LayoutE = cutlass::layout::RowMajor;
+  using ReorderedLayoutE = cutlass::layout::ColumnMajorInterleaved<2>;
+
+  // Each element of metadata describes 256 bits of uncompressed A
+  int const kElementsPerElementE = 256 / cutlass::sizeof_bits<ElementA>::value;
+
+  cutlass::gemm::GemmCoord meta_size(
+    problem_size.m(), problem_size.n(), problem_size.k() / kElementsPerElementE);
+
+  cutlass::HostTensor<ElementA, LayoutA> tensor_A({problem_size.m(), problem_size.k() / 2});
+  cutlass::HostTensor<ElementA, LayoutA> tensor_A_uncompressed(problem_size.mk());
+  cutlass::HostTensor<ElementB, LayoutB> tensor_B(problem_size.kn());
+  cutlass::HostTensor<ElementC, LayoutC> tensor_C(problem_size.mn());
+  cutlass::HostTensor<ElementC, LayoutC> tensor_D(problem_size.mn());
+  cutlass::HostTensor<ElementC, LayoutC> reference_D(problem_size.mn());
+  cutlass::HostTensor<ElementE, LayoutE> tensor_E(meta_size.mk());
+  cutlass::HostTensor<ElementE, ReorderedLayoutE> tensor_E_reordered(meta_size.mk());
+
+  int bits = (cutlass::sizeof_bits<ElementA>::value <= 8 ? 0 : -1);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, bits);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, bits);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, bits);
+  cutlass::reference::host::TensorFillRandomSparseMeta(tensor_E.host_view(), 7, kMetaSizeInBits);
+
+  cutlass::reorder_meta(tensor_E_reordered.host_ref(), tensor_E.host_ref(), meta_size);
+
+  cutlass::uncompress(tensor_A_uncompressed.host_ref(), tensor_A.host_ref(),
+                      tensor_E.host_ref(), problem_size.m(), problem_size.k());
+
+  ComputeType alpha = ComputeType(2);
+  ComputeType beta = ComputeType(-1);
+
+  cutlass::reference::host::SparseGemm<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ComputeType, ComputeType,
+    ElementE, ReorderedLayoutE> sparse_gemm;
+
+  sparse_gemm(
+    problem_size,
+    alpha,
+    tensor_A.host_ref(),
+    tensor_B.host_ref(),
+    tensor_E_reordered.host_ref(),
+    beta,
+    tensor_C.host_ref(),
+    tensor_D.host_ref());
+
+  cutlass::reference::host::Gemm<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ComputeType, ComputeType> gemm;
+
+  gemm(
+    problem_size,
+    alpha,
+    tensor_A_uncompressed.host_ref(),
+    tensor_B.host_ref(),
+    beta,
+    tensor_C.host_ref(),
+    reference_D.host_ref());
+
+  return cutlass::reference::host::TensorEquals(tensor_D.host_view(), reference_D.host_view());
+}
+
+/// Computes a structured sparse GEMM whose operand B holds Inf and NaN. A dense GEMM of the
+/// uncompressed operand multiplies them by the pruned zeros of A, producing NaN, whereas pruned
+/// elements do not contribute to the sparse GEMM. Its results are those of a dense GEMM in which
+/// such products are zero.
+bool TestHostSparseGemmNonfinite(cutlass::gemm::GemmCoord problem_size) {
+
+  using Element = float;
+  using ElementE = uint16_t;
+  using Layout = cutlass::layout::RowMajor;
+  using LayoutB = cutlass::layout::ColumnMajor;
+  using ReorderedLayoutE = cutlass::layout::ColumnMajorInterleaved<2>;
+
+  int const kElementsPerElementE = 256 / cutlass::sizeof_bits<Element>::value;
+
+  cutlass::gemm::GemmCoord meta_size(
+    problem_size.m(), problem_size.n(), problem_size.k() / kElementsPerElementE);
+
+  cutlass::HostTensor<Element, Layout> tensor_A({problem_size.m(), problem_size.k() / 2});
+  cutlass::HostTensor<Element, Layout> tensor_A_uncompressed(problem_size.mk());
+  cutlass::HostTensor<Element, LayoutB> tensor_B(problem_size.kn());
+  cutlass::HostTensor<Element, LayoutB> tensor_B_zeroed(problem_size.kn());
+  cutlass::HostTensor<Element, Layout> tensor_C(problem_size.mn());
+  cutlass::HostTensor<Element, Layout> tensor_D(problem_size.mn());
+  cutlass::HostTensor<Element, Layout> dense_D(problem_size.mn());
+  cutlass::HostTensor<Element, Layout> zeroed_D(problem_size.mn());
+  cutlass::HostTensor<ElementE, Layout> tensor_E(meta_size.mk());
+  cutlass::HostTensor<ElementE, ReorderedLayoutE> tensor_E_reordered(meta_size.mk());
+
+  // Nonzero elements of A are kept away from zero, so that zeros of uncompressed A are pruned
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, 1, -1);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, -1);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, -1);
+  cutlass::reference::host::TensorFillRandomSparseMeta(tensor_E.host_view(), 7, 4);
+
+  cutlass::reorder_meta(tensor_E_reordered.host_ref(), tensor_E.host_ref(), meta_size);
+
+  cutlass::uncompress(tensor_A_uncompressed.host_ref(), tensor_A.host_ref(),
+                      tensor_E.host_ref(), problem_size.m(), problem_size.k());
+
+  cutlass::MatrixCoord const kInf(3, 1);
+  cutlass::MatrixCoord const kNaN(problem_size.k() - 2, problem_size.n() - 1);
+
+  cutlass::reference::host::TensorCopy(tensor_B_zeroed.host_view(), tensor_B.host_view());
+
+  tensor_B.at(kInf) = std::numeric_limits<Element>::infinity();
+  tensor_B.at(kNaN) = std::numeric_limits<Element>::quiet_NaN();
+  tensor_B_zeroed.at(kInf) = Element(0);
+  tensor_B_zeroed.at(kNaN) = Element(0);
+
+  Element alpha = Element(2);
+  Element beta = Element(-1);
+
+  cutlass::reference::host::SparseGemm<
+    Element, Layout, Element, LayoutB, Element, Layout, Element, Element,
+    ElementE, ReorderedLayoutE> sparse_gemm;
+
+  sparse_gemm(problem_size, alpha, tensor_A.host_ref(), tensor_B.host_ref(),
+    tensor_E_reordered.host_ref(), beta, tensor_C.host_ref(), tensor_D.host_ref());
+
+  cutlass::reference::host::Gemm<
+    Element, Layout, Element, LayoutB, Element, Layout, Element, Element> gemm;
+
+  gemm(problem_size, alpha, tensor_A_uncompressed.host_ref(), tensor_B.host_ref(),
+    beta, tensor_C.host_ref(), dense_D.host_ref());
+
+  gemm(problem_size, alpha, tensor_A_uncompressed.host_ref(), tensor_B_zeroed.host_ref(),
+    beta, tensor_C.host_ref(), zeroed_D.host_ref());
+
+  int pruned = 0;
+
+  for (int m = 0; m < problem_size.m(); ++m) {
+    for (int n = 0; n < problem_size.n(); ++n) {
+
+      Element got = tensor_D.at({m, n});
+      Element dense = dense_D.at({m, n});
+
+      bool pruned_inf = (n == kInf.column() && tensor_A_uncompressed.at({m, kInf.row()}) == 0);
+      bool pruned_nan = (n == kNaN.column() && tensor_A_uncompressed.at({m, kNaN.row()}) == 0);
+
+      if (pruned_inf || pruned_nan) {
+
+        // Only the dense GEMM multiplies the nonfinite element of B
+        ++pruned;
+        if (!std::isnan(dense) || !(got == zeroed_D.at({m, n}))) {
+          return false;
+        }
+      }
+      else if (!(got == dense || (std::isnan(got) && std::isnan(dense)))) {
+        return false;
+      }
+    }
+  }
+
+  // Both nonfinite elements are multiplied by pruned zeros in some rows and by nonzeros in others
+  return pruned > 0 && pruned < 2 * problem_size.m();
+}
+
+/// Reorders the columns of an interleaved operand, checks each element against
+/// reorder_column_index() and restores the original operand with unreorder_column().
+template <int Interleaved, typename Element, typename Layout>
+bool TestHostReorderColumn(cutlass::gemm::GemmCoord problem_size) {
+
+  cutlass::HostTensor<Element, Layout> tensor_B(problem_size.kn());
+  cutlass::HostTensor<Element, Layout> tensor_B_reordered(problem_size.kn());
+  cutlass::HostTensor<Element, Layout> tensor_B_restored(problem_size.kn());
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2019, 7, -8, 0);
+
+  cutlass::reorder_column<Interleaved>(
+    tensor_B_reordered.host_ref(), tensor_B.host_ref(), problem_size);
+
+  for (int k = 0; k < problem_size.k(); ++k) {
+    for (int n = 0; n < problem_size.n(); ++n) {
+      Element expected = tensor_B.at({k, n});
+      Element got = tensor_B_reordered.at({k, cutlass::reorder_column_index<Interleaved>(n)});
+      if (!(expected == got)) {
+        return false;
+      }
+    }
+  }
+
+  cutlass::unreorder_column<Interleaved>(
+    tensor_B_restored.host_ref(), tensor_B_reordered.host_ref(), problem_size);
+
+  return cutlass::reference::host::TensorEquals(tensor_B_restored.host_view(), tensor_B.host_view());
+}
+
+/// Reorders sparse metadata, checks each element against reorder_meta_coord() and restores the
+/// original metadata with unreorder_meta().
+template <typename ElementE>
+bool TestHostReorderMeta(cutlass::gemm::GemmCoord meta_size) {
+
+  using LayoutE = cutlass::layout::RowMajor;
+  using ReorderedLayoutE = cutlass::layout::ColumnMajorInterleaved<2>;
+
+  cutlass::HostTensor<ElementE, LayoutE> tensor_E(meta_size.mk());
+  cutlass::HostTensor<ElementE, ReorderedLayoutE> tensor_E_reordered(meta_size.mk());
+  cutlass::HostTensor<ElementE, LayoutE> tensor_E_restored(meta_size.mk());
+
+  cutlass::reference::host::TensorFillRandomSparseMeta(tensor_E.host_view(), 7, 2);
+
+  cutlass::reorder_meta(tensor_E_reordered.host_ref(), tensor_E.host_ref(), meta_size);
+
+  for (int m = 0; m < meta_size.m(); ++m) {
+    for (int k = 0; k < meta_size.k(); ++k) {
+      if (tensor_E.at({m, k}) != tensor_E_reordered.at(cutlass::reorder_meta_coord<ElementE>(m, k))) {
+        return false;
+      }
+    }
+  }
+
+  cutlass::unreorder_meta(tensor_E_restored.host_ref(), tensor_E_reordered.host_ref(), meta_size);
+
+  return cutlass::reference::host::TensorEquals(tensor_E_restored.host_view(), tensor_E.host_view());
+}
+
+/// Computes a GEMM whose operand A is stored in the Blocked-ELL format and compares against a
+/// dense GEMM of the uncompressed operand. Operands hold arbitrary values, for which the results
+/// must be identical.
+template <typename Element, typename ComputeType>
+bool TestHostEllGemm(
+  cutlass::gemm::GemmCoord problem_size,
+  int ell_num_columns,
+  int ell_blocksize) {
+
+  using LayoutA = cutlass::layout::RowMajor;
+  using LayoutB = cutlass::layout::ColumnMajor;
+  using LayoutC = cutlass::layout::ColumnMajor;
+
+  int const block_rows = problem_size.m() / ell_blocksize;
+  int const block_columns = ell_num_columns / ell_blocksize;
+
+  cutlass::HostTensor<Element, LayoutA> tensor_A({problem_size.m(), ell_num_columns});
+  cutlass::HostTensor<Element, LayoutA> tensor_A_uncompressed(problem_size.mk());
+  cutlass::HostTensor<int32_t, LayoutA> tensor_ell_idx({block_rows, block_columns});
+  cutlass::HostTensor<Element, LayoutB> tensor_B(problem_size.kn());
+  cutlass::HostTensor<Element, LayoutC> tensor_C(problem_size.mn());
+  cutlass::HostTensor<Element, LayoutC> tensor_D(problem_size.mn());
+  cutlass::HostTensor<Element, LayoutC> reference_D(problem_size.mn());
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, -1);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, -1);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, -1);
+  cutlass::reference::host::TensorFillRandomEllIdx(
+    tensor_ell_idx.host_view(), 2022, block_rows, block_columns,
+    problem_size.k() / ell_blocksize);
+
+  cutlass::reference::host::TensorFill(tensor_A_uncompressed.host_view());
+  cutlass::uncompress_ell_block_sparse(
+    tensor_A_uncompressed.host_ref(), tensor_A.host_ref(), tensor_ell_idx.host_ref(),
+    problem_size.m(), problem_size.k(), ell_num_columns, ell_blocksize);
+
+  ComputeType alpha = ComputeType(2);
+  ComputeType beta = ComputeType(-1);
+
+  cutlass::reference::host::EllGemm<
+    Element, LayoutA,
+    Element, LayoutB,
+    Element, LayoutC,
+    ComputeType, ComputeType> ell_gemm;
+
+  ell_gemm(
+    problem_size,
+    alpha,
+    tensor_A.host_ref(),
+    tensor_ell_idx.host_ref(),
+    ell_num_columns,
+    ell_blocksize,
+    tensor_B.host_ref(),
+    beta,
+    tensor_C.host_ref(),
+    tensor_D.host_ref());
+
+  cutlass::reference::host::Gemm<
+    Element, LayoutA,
+    Element, LayoutB,
+    Element, LayoutC,
+    ComputeType, ComputeType> gemm;
+
+  gemm(
+    problem_size,
+    alpha,
+    tensor_A_uncompressed.host_ref(),
+    tensor_B.host_ref(),
+    beta,
+    tensor_C.host_ref(),
+    reference_D.host_ref());
+
+  return cutlass::reference::host::TensorEquals(tensor_D.host_view(), reference_D.host_view());
+}
+
+/// Computes a planar complex GEMM with the conventional and the 3M (Gaussian) methods. Operands
+/// hold small integers, for which both methods are exact.
+template <typename ElementA, typename LayoutA, typename ElementB, typename LayoutB>
+bool TestHostGemmPlanarComplexGaussian(
+  cutlass::gemm::GemmCoord problem_size,
+  cutlass::ComplexTransform transform_a,
+  cutlass::ComplexTransform transform_b) {
+
+  using LayoutC = cutlass::layout::ColumnMajor;
+
+  cutlass::HostTensorPlanarComplex<ElementA, LayoutA> tensor_A(problem_size.mk());
+  cutlass::HostTensorPlanarComplex<ElementB, LayoutB> tensor_B(problem_size.kn());
+  cutlass::HostTensorPlanarComplex<float, LayoutC> tensor_C(problem_size.mn());
+  cutlass::HostTensorPlanarComplex<float, LayoutC> tensor_D(problem_size.mn());
+  cutlass::HostTensorPlanarComplex<float, LayoutC> tensor_D_gaussian(problem_size.mn());
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_A.host_view(), 2019, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2020, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_C.host_view(), 2021, 3, -3, 0);
+
+  cutlass::complex<float> alpha(2, -1);
+  cutlass::complex<float> beta(-1, 1);
+
+  cutlass::reference::host::GemmPlanarComplex<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    float, LayoutC,
+    float>(
+      problem_size,
+      alpha,
+      tensor_A.host_ref(),
+      transform_a,
+      tensor_B.host_ref(),
+      transform_b,
+      beta,
+      tensor_C.host_ref(),
+      tensor_D.host_ref());
+
+  cutlass::reference::host::GemmPlanarComplex<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    float, LayoutC,
+    float>(
+      problem_size,
+      alpha,
+      tensor_A.host_ref(),
+      transform_a,
+      tensor_B.host_ref(),
+      transform_b,
+      beta,
+      tensor_C.host_ref(),
+      tensor_D_gaussian.host_ref(),
+      cutlass::arch::OpMultiplyAddGaussianComplex());
+
+  return cutlass::reference::host::TensorEquals(tensor_D.host_view(), tensor_D_gaussian.host_view());
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostGemm, f32n_f32t_f32n) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({259, 137, 301}, 2.0f, -1.0f)));
+}
+
+TEST(ReferenceHostGemm, f32t_f32n_f32t) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float>({1, 517, 33}, 1.0f, 0.0f)));
+}
+
+TEST(ReferenceHostGemm, f16n_f16n_f32t) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    cutlass::half_t, cutlass::layout::ColumnMajor,
+    cutlass::half_t, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float>({128, 96, 513}, 1.0f, 1.0f)));
+}
+
+TEST(ReferenceHostGemm, bf16t_bf16n_f32n) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    cutlass::bfloat16_t, cutlass::layout::RowMajor,
+    cutlass::bfloat16_t, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({145, 67, 283}, 1.0f, -2.0f)));
+}
+
+TEST(ReferenceHostGemm, tf32n_tf32t_f32t) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    cutlass::tfloat32_t, cutlass::layout::ColumnMajor,
+    cutlass::tfloat32_t, cutlass::layout::RowMajor,
+    float, cutlass::layout::RowMajor,
+    float>({99, 101, 257}, 1.0f, 1.0f)));
+}
+
+TEST(ReferenceHostGemm, f64n_f64t_f64t) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    double, cutlass::layout::ColumnMajor,
+    double, cutlass::layout::RowMajor,
+    double, cutlass::layout::RowMajor,
+    double>({77, 300, 129}, 1.0, 2.0)));
+}
+
+TEST(ReferenceHostGemm, s8t_s8n_s32t) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    int8_t, cutlass::layout::RowMajor,
+    int8_t, cutlass::layout::ColumnMajor,
+    int32_t, cutlass::layout::RowMajor,
+    int32_t>({200, 300, 260}, 1, 1)));
+}
+
+TEST(ReferenceHostGemm, s4t_s4n_s32t) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    cutlass::int4b_t, cutlass::layout::RowMajor,
+    cutlass::int4b_t, cutlass::layout::ColumnMajor,
+    int32_t, cutlass::layout::RowMajor,
+    int32_t>({64, 72, 128}, 1, 0)));
+}
+
+TEST(ReferenceHostGemm, qf32n_qf32t_qf32n) {
+
+  using Element = cutlass::Quaternion<float>;
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    Element, cutlass::layout::ColumnMajor,
+    Element, cutlass::layout::RowMajor,
+    Element, cutlass::layout::ColumnMajor,
+    Element>({45, 37, 67}, Element(1, -1, 0, 2), Element(0, 1, -1, 1))));
+}
+
+TEST(ReferenceHostGemm, qf64t_qf64n_qf64t) {
+
+  using Element = cutlass::Quaternion<double>;
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    Element, cutlass::layout::RowMajor,
+    Element, cutlass::layout::ColumnMajor,
+    Element, cutlass::layout::RowMajor,
+    Element>({23, 29, 51}, Element(0, 2, 1, -1), Element(1, 0, 0, 1))));
+}
+
+TEST(ReferenceHostGemm, f32n_f32t_f32n_fraction) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({131, 97, 203}, 1.25f, -0.75f, -1)));
+}
+
+TEST(ReferenceHostGemm, f32n_f32t_f32n_fraction_small) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({13, 17, 29}, 1.25f, -0.75f, -1)));
+}
+
+TEST(ReferenceHostGemm, f64t_f64n_f64t_fraction) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    double, cutlass::layout::RowMajor,
+    double, cutlass::layout::ColumnMajor,
+    double, cutlass::layout::RowMajor,
+    double>({67, 120, 151}, 0.5, 1.5, -1)));
+}
+
+TEST(ReferenceHostGemm, qf32t_qf32n_qf32t_fraction) {
+
+  using Element = cutlass::Quaternion<float>;
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    Element, cutlass::layout::RowMajor,
+    Element, cutlass::layout::ColumnMajor,
+    Element, cutlass::layout::RowMajor,
+    Element>({37, 41, 53}, Element(0.5f, -1, 0, 2), Element(0, 1, -1.5f, 1), -1)));
+}
+
+TEST(ReferenceHostGemm, empty_k) {
+
+  EXPECT_TRUE((test::util::TestHostGemm<
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({31, 17, 0}, 1.0f, 3.0f)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostBatchedGemm, f32n_f32t_small) {
+
+  EXPECT_TRUE((test::util::TestHostBatchedGemm<
+    float, cutlass::layout::ColumnMajor, cutlass::layout::RowMajor, float>({7, 5, 9}, 37)));
+}
+
+TEST(ReferenceHostBatchedGemm, f64t_f64n) {
+
+  EXPECT_TRUE((test::util::TestHostBatchedGemm<
+    double, cutlass::layout::RowMajor, cutlass::layout::ColumnMajor, double>({101, 67, 83}, 3)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostGemmComplex, cf32n_cf32t_batched_conjugate) {
+
+  EXPECT_TRUE((test::util::TestHostGemmComplex<
+    cutlass::complex<float>, cutlass::layout::ColumnMajor, cutlass::layout::RowMajor>(
+      {67, 45, 93}, 3, cutlass::ComplexTransform::kConjugate, cutlass::ComplexTransform::kNone)));
+}
+
+TEST(ReferenceHostGemmComplex, cf64t_cf64n_conjugate) {
+
+  EXPECT_TRUE((test::util::TestHostGemmComplex<
+    cutlass::complex<double>, cutlass::layout::RowMajor, cutlass::layout::ColumnMajor>(
+      {33, 70, 41}, 1, cutlass::ComplexTransform::kNone, cutlass::ComplexTransform::kConjugate)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostGemmGrouped, f32n_f32t_skewed) {
+
+  std::vector<cutlass::gemm::GemmCoord> problem_sizes = {
+    {256, 192, 160}, {7, 5, 9}, {1, 1, 1}, {64, 300, 33}, {0, 8, 8}, {17, 3, 0}, {129, 65, 257}
+  };
+
+  EXPECT_TRUE((test::util::TestHostGemmGrouped<
+    float, cutlass::layout::ColumnMajor, cutlass::layout::RowMajor>(
+      problem_sizes, cutlass::ComplexTransform::kNone, cutlass::ComplexTransform::kNone)));
+}
+
+TEST(ReferenceHostGemmGrouped, cf64t_cf64n_conjugate) {
+
+  std::vector<cutlass::gemm::GemmCoord> problem_sizes = {
+    {3, 4, 5}, {96, 40, 72}, {12, 80, 6}
+  };
+
+  EXPECT_TRUE((test::util::TestHostGemmGrouped<
+    cutlass::complex<double>, cutlass::layout::RowMajor, cutlass::layout::ColumnMajor>(
+      problem_sizes, cutlass::ComplexTransform::kConjugate, cutlass::ComplexTransform::kNone)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostSparseGemm, f16t_f16n_f32t) {
+
+  EXPECT_TRUE((test::util::TestHostSparseGemm<
+    cutlass::half_t, cutlass::half_t, float, uint16_t, float, 2>({128, 96, 256})));
+}
+
+TEST(ReferenceHostSparseGemm, f32t_f32n_f32t) {
+
+  EXPECT_TRUE((test::util::TestHostSparseGemm<
+    float, float, float, uint16_t, float, 4>({64, 48, 128})));
+}
+
+TEST(ReferenceHostSparseGemm, s8t_s8n_s32t) {
+
+  EXPECT_TRUE((test::util::TestHostSparseGemm<
+    int8_t, int8_t, int32_t, uint32_t, int32_t, 2>({64, 72, 128})));
+}
+
+TEST(ReferenceHostSparseGemm, s4t_s4n_s32t_small) {
+
+  EXPECT_TRUE((test::util::TestHostSparseGemm<
+    cutlass::int4b_t, cutlass::int4b_t, int32_t, uint32_t, int32_t, 2>({16, 8, 64})));
+}
+
+TEST(ReferenceHostSparseGemm, f32t_f32n_f32t_nonfinite) {
+
+  EXPECT_TRUE(test::util::TestHostSparseGemmNonfinite({64, 48, 128}));
+}
+
+TEST(ReferenceHostSparseGemm, f32t_f32n_f32t_nonfinite_small) {
+
+  EXPECT_TRUE(test::util::TestHostSparseGemmNonfinite({32, 8, 32}));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostReorder, column_s8_interleaved32) {
+
+  EXPECT_TRUE((test::util::TestHostReorderColumn<
+    32, int8_t, cutlass::layout::ColumnMajorInterleaved<32>>({0, 256, 520})));
+}
+
+TEST(HostReorder, column_s4_interleaved64) {
+
+  EXPECT_TRUE((test::util::TestHostReorderColumn<
+    64, cutlass::int4b_t, cutlass::layout::ColumnMajorInterleaved<64>>({0, 128, 136})));
+}
+
+TEST(HostReorder, convK_s8_interleaved32) {
+
+  cutlass::gemm::GemmCoord problem_size(0, 96, 288);
+
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorCxRSKx<32>> tensor_B({96, 1, 1, 288});
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorCxRSKx<32>> tensor_B_reordered({96, 1, 1, 288});
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorCxRSKx<32>> tensor_B_restored({96, 1, 1, 288});
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_B.host_view(), 2019, 7, -8, 0);
+
+  cutlass::reorder_convK<32>(tensor_B_reordered.host_ref(), tensor_B.host_ref(), problem_size);
+  cutlass::unreorder_convK<32>(tensor_B_restored.host_ref(), tensor_B_reordered.host_ref(), problem_size);
+
+  EXPECT_FALSE(cutlass::reference::host::TensorEquals(tensor_B_reordered.host_view(), tensor_B.host_view()));
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(tensor_B_restored.host_view(), tensor_B.host_view()));
+}
+
+TEST(HostReorder, meta_u16) {
+
+  EXPECT_TRUE((test::util::TestHostReorderMeta<uint16_t>({256, 0, 48})));
+}
+
+TEST(HostReorder, meta_u32) {
+
+  EXPECT_TRUE((test::util::TestHostReorderMeta<uint32_t>({144, 0, 20})));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostEllGemm, f32t_f32n_f32n) {
+
+  EXPECT_TRUE((test::util::TestHostEllGemm<float, float>({256, 72, 512}, 96, 32)));
+}
+
+TEST(ReferenceHostEllGemm, f64t_f64n_f64n_small) {
+
+  EXPECT_TRUE((test::util::TestHostEllGemm<double, double>({16, 12, 32}, 8, 4)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostGemmPlanarComplex, f16t_f16n_gaussian_conjugate) {
+
+  EXPECT_TRUE((test::util::TestHostGemmPlanarComplexGaussian<
+    cutlass::half_t, cutlass::layout::RowMajor,
+    cutlass::half_t, cutlass::layout::ColumnMajor>(
+      {71, 38, 129}, cutlass::ComplexTransform::kConjugate, cutlass::ComplexTransform::kConjugate)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,947 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the host-side tensor utilities against direct loops.
+*/
+
+#include <cstring>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/numeric_conversion.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/error_metrics.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_copy.h"
+#include "cutlass/util/reference/host/tensor_elementwise.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
+#include "cutlass/util/reference/host/tensor_reduce.h"
+#include "cutlass/util/reference/host/detail/philox.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Records the number of visits of each point of an index space
+template <int Rank>
+struct TensorForEachCountFunc {
+
+  cutlass::Coord<Rank> extent;
+  int *visits;
+
+  void operator()(cutlass::Coord<Rank> const &coord) const {
+    int64_t idx = 0;
+    for (int rank = 0; rank < Rank; ++rank) {
+      idx = idx * extent[rank] + coord[rank];
+    }
+    ++visits[idx];
+  }
+};
+
+/// Visits an index space with the parallel policy and verifies that every point is visited once
+template <int Rank>
+bool TestTensorForEachParallel(cutlass::Coord<Rank> extent) {
+
+  int64_t volume = 1;
+  for (int rank = 0; rank < Rank; ++rank) {
+    volume *= extent[rank];
+  }
+
+  std::vector<int> visits(size_t(volume), 0);
+
+  TensorForEachCountFunc<Rank> func{extent, visits.data()};
+
+  cutlass::reference::host::TensorForEach(
+    extent, func, cutlass::reference::host::TensorForEachPolicy::kParallel);
+
+  for (int count : visits) {
+    if (count != 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Compares copies of a tensor after changing single elements
+template <typename Element>
+void TestTensorEqualsSingleMismatch(Element value, Element other) {
+
+  int const kM = 389;
+  int const kN = 521;
+
+  cutlass::HostTensor<Element, cutlass::layout::RowMajor> a({kM, kN});
+  cutlass::HostTensor<Element, cutlass::layout::RowMajor> b({kM, kN});
+
+  cutlass::reference::host::TensorFill(a.host_view(), value);
+  cutlass::reference::host::TensorFill(b.host_view(), value);
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+
+  int const kOffsets[] = {0, 31, kM * kN / 2 + 7, kM * kN - 1};
+
+  for (int offset : kOffsets) {
+
+    b.host_data()[offset] = other;
+
+    EXPECT_FALSE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+    EXPECT_TRUE(cutlass::reference::host::TensorNotEquals(a.host_view(), b.host_view()));
+
+    b.host_data()[offset] = value;
+  }
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+}
+
+/// Copies between layouts and verifies each element against the source, or against its initial
+/// value outside the source's extent
+template <typename DstElement, typename DstLayout, typename SrcElement, typename SrcLayout>
+bool TestTensorCopyLayouts(
+  typename DstLayout::TensorCoord dst_extent,
+  typename SrcLayout::TensorCoord src_extent) {
+
+  cutlass::HostTensor<DstElement, DstLayout> dst(dst_extent);
+  cutlass::HostTensor<SrcElement, SrcLayout> src(src_extent);
+
+  cutlass::reference::host::TensorFillRandomUniform(src.host_view(), 17, 100, -100, 0);
+  cutlass::reference::host::TensorFill(dst.host_view(), DstElement(-128));
+
+  cutlass::reference::host::TensorCopy(dst.host_view(), src.host_view());
+
+  bool passed = true;
+
+  cutlass::reference::host::TensorForEachLambda(dst_extent, [&](cutlass::Coord<DstLayout::kRank> const &coord) {
+    DstElement expected = src.host_view().contains(coord) ? DstElement(src.at(coord)) : DstElement(-128);
+    if (dst.at(coord) != expected) {
+      passed = false;
+    }
+  });
+
+  return passed;
+}
+
+/// Fills, copies and compares tensors of sub-byte integers, including a view whose rows are
+/// padded, and verifies each element against the scalar reference
+template <typename Element>
+bool TestTensorSubbyte(int rows, int columns, int ldm) {
+
+  using Layout = cutlass::layout::RowMajor;
+
+  cutlass::HostTensor<Element, Layout> a({rows, columns}, Layout(ldm), false);
+  cutlass::HostTensor<Element, Layout> b({rows, columns}, false);
+  cutlass::HostTensor<int8_t, Layout> bytes({rows, columns}, false);
+
+  // Values representable by every sub-byte integer type of the same signedness
+  int const kMax = 1;
+  int const kMin = Element::kSigned ? -2 : 0;
+
+  cutlass::reference::host::TensorFill(a.host_view(), Element(1));
+  cutlass::reference::host::TensorFillRandomUniform(a.host_view(), 23, kMax, kMin, 0);
+  cutlass::reference::host::TensorCopy(bytes.host_view(), a.host_view());
+  cutlass::reference::host::TensorFill(b.host_view(), Element(0));
+  cutlass::reference::host::TensorCopy(b.host_view(), bytes.host_view());
+
+  cutlass::reference::host::detail::RandomUniformFunc<Element> random_func(23, kMax, kMin, 0);
+
+  bool passed = true;
+
+  for (int m = 0; m < rows; ++m) {
+    for (int n = 0; n < columns; ++n) {
+      Element expected = random_func(uint64_t(m) * columns + n);
+      if (Element(a.at({m, n})) != expected || int(bytes.at({m, n})) != int(expected)) {
+        passed = false;
+      }
+    }
+  }
+
+  passed = passed && cutlass::reference::host::TensorEquals(a.host_view(), b.host_view());
+
+  // Mismatches in the first and last elements are found
+  Element first = b.at({0, 0});
+  b.at({0, 0}) = Element(int(first) == 0 ? 1 : 0);
+  passed = passed && !cutlass::reference::host::TensorEquals(a.host_view(), b.host_view());
+  b.at({0, 0}) = first;
+
+  Element last = b.at({rows - 1, columns - 1});
+  b.at({rows - 1, columns - 1}) = Element(int(last) == 0 ? 1 : 0);
+  passed = passed && !cutlass::reference::host::TensorEquals(a.host_view(), b.host_view());
+
+  return passed;
+}
+
+/// Converts float values including rounding ties, overflows, subnormals and non-finite values
+/// in bulk and verifies each result bitwise against the scalar conversion
+template <typename DstElement, typename SrcElement, cutlass::FloatRoundStyle Round>
+bool TestBlockConvert() {
+
+  uint32_t const kSpecial[] = {
+    0x00000000, 0x80000000, 0x7f800000, 0xff800000, 0x7fc00000, 0xffc00001, 0x7f800001,
+    0x00000001, 0x477fe000, 0x477ff000, 0x47800000, 0xc7800000, 0x33000000, 0x387fc000,
+    0x7f7fffff, 0x3f808000, 0x3f818000, 0x3f817fff
+  };
+
+  std::vector<float> values;
+  for (uint32_t bits : kSpecial) {
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    values.push_back(x);
+  }
+
+  // Random bit patterns, half of them with exponents near the range of half_t
+  cutlass::reference::host::detail::PhiloxStream stream(2022, 0);
+  while (values.size() < 100003) {
+    uint32_t bits = stream();
+    if (values.size() & 1) {
+      bits = (bits & 0x87ffffff) | 0x30000000;
+    }
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    values.push_back(x);
+  }
+
+  std::vector<SrcElement> src;
+  for (float x : values) {
+    src.push_back(SrcElement(x));
+  }
+
+  std::vector<DstElement> dst(src.size());
+  cutlass::reference::host::BlockConvert<Round>(dst.data(), src.data(), src.size());
+
+  cutlass::NumericConverter<DstElement, SrcElement, Round> convert;
+
+  for (size_t i = 0; i < src.size(); ++i) {
+    DstElement expected = convert(src[i]);
+    if (std::memcmp(&expected, &dst[i], sizeof(DstElement))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Bitwise comparison of a bulk conversion against the scalar conversion
+template <typename DstElement, typename SrcElement>
+bool TestBlockConvertArray(std::vector<SrcElement> const &src) {
+
+  std::vector<DstElement> dst(src.size());
+  cutlass::reference::host::BlockConvert(dst.data(), src.data(), src.size());
+
+  cutlass::NumericConverter<DstElement, SrcElement> convert;
+
+  for (size_t i = 0; i < src.size(); ++i) {
+    DstElement expected = convert(src[i]);
+    if (std::memcmp(&expected, &dst[i], sizeof(DstElement))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Converts every half_t value, saturating and non-finite floats to an 8-bit floating point type
+/// and every encoding of it back to wider types, verifying each result against the scalar path
+template <typename Fp8>
+bool TestBlockConvertFp8() {
+
+  uint32_t const kSpecial[] = {
+    0x7f800000, 0xff800000, 0x7fc00000, 0xffc00001, 0x7f800001, 0x7f7fffff, 0xff7fffff,
+    0x00000001, 0x80000001, 0x43e00000, 0x43e80000, 0x43f00000, 0x47600000, 0x47700000
+  };
+
+  std::vector<float> values;
+  for (uint32_t bits : kSpecial) {
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    values.push_back(x);
+  }
+
+  // Every half_t value includes every rounding tie of both 8-bit formats
+  std::vector<cutlass::half_t> halves;
+  std::vector<cutlass::bfloat16_t> bfloats;
+  for (int i = 0; i < 65536; ++i) {
+    halves.push_back(cutlass::half_t::bitcast(uint16_t(i)));
+    bfloats.push_back(cutlass::bfloat16_t::bitcast(uint16_t(i)));
+    values.push_back(float(halves.back()));
+  }
+
+  std::vector<Fp8> codes;
+  for (int i = 0; i < 256; ++i) {
+    codes.push_back(Fp8::bitcast(uint8_t(i)));
+  }
+
+  return TestBlockConvertArray<Fp8>(values) &&
+    TestBlockConvertArray<Fp8>(halves) &&
+    TestBlockConvertArray<Fp8>(bfloats) &&
+    TestBlockConvertArray<float>(codes) &&
+    TestBlockConvertArray<cutlass::half_t>(codes) &&
+    TestBlockConvertArray<cutlass::bfloat16_t>(codes);
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostTensorForEach, parallel_rank1) {
+  EXPECT_TRUE(test::util::TestTensorForEachParallel(cutlass::make_Coord(100003)));
+}
+
+TEST(ReferenceHostTensorForEach, parallel_rank4) {
+  EXPECT_TRUE(test::util::TestTensorForEachParallel(cutlass::make_Coord(3, 37, 29, 23)));
+}
+
+TEST(ReferenceHostTensorForEach, parallel_empty) {
+  EXPECT_TRUE(test::util::TestTensorForEachParallel(cutlass::make_Coord(0, 4096, 8)));
+}
+
+TEST(ReferenceHostTensorForEach, parallel_copy_s4) {
+
+  cutlass::HostTensor<int8_t, cutlass::layout::RowMajor> src({129, 255});
+  cutlass::HostTensor<cutlass::int4b_t, cutlass::layout::RowMajor> s4({129, 255});
+  cutlass::HostTensor<int8_t, cutlass::layout::RowMajor> dst({129, 255});
+
+  for (int m = 0; m < 129; ++m) {
+    for (int n = 0; n < 255; ++n) {
+      src.at({m, n}) = int8_t((m * 7 + n) % 16 - 8);
+    }
+  }
+
+  // Sub-byte destinations are packed a range of whole bytes at a time
+  cutlass::reference::host::TensorCopy(s4.host_view(), src.host_view());
+  cutlass::reference::host::TensorCopy(dst.host_view(), s4.host_view());
+
+  for (int m = 0; m < 129; ++m) {
+    for (int n = 0; n < 255; ++n) {
+      EXPECT_EQ(dst.at({m, n}), src.at({m, n}));
+    }
+  }
+}
+
+TEST(ReferenceHostTensorForEach, parallel_fill_add_nhwc_f32) {
+
+  cutlass::HostTensor<float, cutlass::layout::TensorNHWC> x({3, 17, 19, 64});
+  cutlass::HostTensor<float, cutlass::layout::TensorNHWC> y({3, 17, 19, 64});
+
+  cutlass::Array<float, 4> v;
+  v[0] = 1000000;
+  v[1] = 10000;
+  v[2] = 100;
+  v[3] = 1;
+
+  cutlass::reference::host::TensorFillLinear(x.host_view(), v, 0.0f);
+  cutlass::reference::host::TensorFill(y.host_view(), 0.5f);
+  cutlass::reference::host::TensorAdd(y.host_view(), x.host_ref());
+
+  for (int n = 0; n < 3; ++n) {
+    for (int h = 0; h < 17; ++h) {
+      for (int w = 0; w < 19; ++w) {
+        for (int c = 0; c < 64; ++c) {
+          float expected = float(n * 1000000 + h * 10000 + w * 100 + c);
+          EXPECT_EQ(x.at({n, h, w, c}), expected);
+          EXPECT_EQ(y.at({n, h, w, c}), expected + 0.5f);
+        }
+      }
+    }
+  }
+}
+
+////////
+
+TEST(ReferenceHostTensorFill, philox_known_answers) {
+
+  // Known-answer tests of Random123 for Philox-4x32-10
+  uint32_t const ctr_in[3][4] = {
+    {0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u},
+    {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+    {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}
+  };
+  uint32_t const key[3][2] = {
+    {0x00000000u, 0x00000000u},
+    {0xffffffffu, 0xffffffffu},
+    {0xa4093822u, 0x299f31d0u}
+  };
+  uint32_t const expected[3][4] = {
+    {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+    {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu},
+    {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}
+  };
+
+  for (int t = 0; t < 3; ++t) {
+    uint32_t ctr[4] = {ctr_in[t][0], ctr_in[t][1], ctr_in[t][2], ctr_in[t][3]};
+    cutlass::reference::host::detail::Philox4x32::apply(ctr, key[t]);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_EQ(ctr[i], expected[t][i]);
+    }
+  }
+}
+
+TEST(ReferenceHostTensorFill, random_uniform_order_independent) {
+
+  int const kM = 257;
+  int const kN = 263;
+
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> x({kM, kN});
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> y({kM, kN});
+
+  cutlass::reference::host::TensorFillRandomUniform(x.host_view(), 2021, 3, -2);
+
+  // Visit the elements serially in the reverse order
+  cutlass::reference::host::detail::TensorFillRandomUniformFunc<float, cutlass::layout::ColumnMajor> func(
+    y.host_view(),
+    cutlass::reference::host::detail::RandomUniformFunc<float>(2021, 3, -2));
+
+  for (int m = kM - 1; m >= 0; --m) {
+    for (int n = kN - 1; n >= 0; --n) {
+      func(cutlass::make_Coord(m, n));
+    }
+  }
+
+  for (int m = 0; m < kM; ++m) {
+    for (int n = 0; n < kN; ++n) {
+      EXPECT_EQ(x.at({m, n}), y.at({m, n}));
+      EXPECT_GE(x.at({m, n}), -2.0f);
+      EXPECT_LE(x.at({m, n}), 3.0f);
+    }
+  }
+}
+
+TEST(ReferenceHostTensorFill, random_gaussian_block_matches_tensor) {
+
+  int const kM = 311;
+  int const kN = 199;
+
+  cutlass::HostTensor<double, cutlass::layout::RowMajor> x({kM, kN});
+  std::vector<double> block(size_t(kM) * kN);
+
+  cutlass::reference::host::TensorFillRandomGaussian(x.host_view(), 7, 1.5, 2.0);
+  cutlass::reference::host::BlockFillRandomGaussian(block.data(), block.size(), 7, 1.5, 2.0);
+
+  // Each element is drawn from the stream of its row-major index
+  double sum = 0;
+  double sum_squares = 0;
+
+  for (int m = 0; m < kM; ++m) {
+    for (int n = 0; n < kN; ++n) {
+      double value = x.at({m, n});
+      EXPECT_EQ(value, block[size_t(m) * kN + n]);
+      sum += value;
+      sum_squares += value * value;
+    }
+  }
+
+  double count = double(kM) * kN;
+  double mean = sum / count;
+  double stddev = std::sqrt(sum_squares / count - mean * mean);
+
+  EXPECT_NEAR(mean, 1.5, 0.05);
+  EXPECT_NEAR(stddev, 2.0, 0.05);
+}
+
+TEST(ReferenceHostTensorFill, random_block_narrow_matches_tensor) {
+
+  int const kM = 173;
+  int const kN = 211;
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> x({kM, kN});
+  cutlass::HostTensor<cutlass::bfloat16_t, cutlass::layout::RowMajor> y({kM, kN});
+  std::vector<cutlass::half_t> x_block(size_t(kM) * kN);
+  std::vector<cutlass::bfloat16_t> y_block(size_t(kM) * kN);
+
+  cutlass::reference::host::TensorFillRandomUniform(x.host_view(), 5, 4, -4, -1);
+  cutlass::reference::host::BlockFillRandomUniform(x_block.data(), x_block.size(), 5, 4, -4, -1);
+  cutlass::reference::host::TensorFillRandomGaussian(y.host_view(), 6, 0, 3, -1);
+  cutlass::reference::host::BlockFillRandomGaussian(y_block.data(), y_block.size(), 6, 0, 3, -1);
+
+  for (size_t i = 0; i < x_block.size(); ++i) {
+    EXPECT_EQ(x.host_data()[i].raw(), x_block[i].raw());
+    EXPECT_EQ(y.host_data()[i].raw(), y_block[i].raw());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostTensorReduce, sum_f32_compensated) {
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> x({1000, 1003});
+  cutlass::reference::host::TensorFill(x.host_view(), 0.1f);
+
+  double expected = double(0.1f) * 1000 * 1003;
+
+  float sum = cutlass::reference::host::TensorSum(x.host_view());
+  float serial = cutlass::reference::host::TensorTransformReduce(
+    x.host_view(), 0.0f, cutlass::plus<float>(), cutlass::NumericConverter<float, float>());
+
+  // A single float accumulator loses several digits over a million terms
+  EXPECT_NEAR(double(sum), expected, expected * 1e-7);
+  EXPECT_GT(std::abs(double(serial) - expected), expected * 1e-4);
+}
+
+TEST(ReferenceHostTensorReduce, sum_compensated_infinite) {
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> x({1000, 1003});
+  cutlass::reference::host::TensorFill(x.host_view(), 0.1f);
+
+  // The compensated sum remains infinite for the terms following an infinite element
+  x.at({0, 0}) = std::numeric_limits<float>::infinity();
+
+  EXPECT_TRUE(std::isinf(cutlass::reference::host::TensorSum(x.host_view())));
+  EXPECT_TRUE(std::isinf(cutlass::reference::host::TensorNorm(x.host_view(), double())));
+
+  // Sums overflowing partway through a block are infinite as well
+  cutlass::HostTensor<double, cutlass::layout::RowMajor> y({100, 100});
+  cutlass::reference::host::TensorFill(y.host_view(), 0.75 * std::numeric_limits<double>::max());
+
+  double sum = cutlass::reference::host::TensorSum(y.host_view());
+
+  EXPECT_TRUE(std::isinf(sum));
+  EXPECT_GT(sum, 0);
+}
+
+TEST(ReferenceHostTensorReduce, strided_matches_packed) {
+
+  int const kM = 301;
+  int const kN = 257;
+
+  cutlass::HostTensor<double, cutlass::layout::RowMajor> a({kM, kN + 7});
+  cutlass::HostTensor<double, cutlass::layout::RowMajor> b({kM, kN});
+
+  cutlass::reference::host::TensorFillRandomUniform(a.host_view(), 1, 4, -4);
+  cutlass::reference::host::TensorFillRandomUniform(b.host_view(), 2, 4, -4);
+
+  // A view of the first kN columns of 'a' is not packed
+  cutlass::TensorView<double, cutlass::layout::RowMajor> a_view(a.host_ref(), {kM, kN});
+
+  double sum_sq_diff = 0;
+  double max = -1;
+
+  for (int m = 0; m < kM; ++m) {
+    for (int n = 0; n < kN; ++n) {
+      double d = a.at({m, n}) - b.at({m, n});
+      sum_sq_diff += d * d;
+      max = std::max(max, b.at({m, n}));
+    }
+  }
+
+  double norm_diff = cutlass::reference::host::TensorNormDiff(a_view, b.host_view());
+
+  EXPECT_NEAR(norm_diff, std::sqrt(sum_sq_diff), std::sqrt(sum_sq_diff) * 1e-14);
+
+  for (auto policy : {cutlass::reference::host::TensorReducePolicy::kSerial,
+                      cutlass::reference::host::TensorReducePolicy::kPairwise}) {
+
+    double reduced_max = cutlass::reference::host::TensorTransformReduce(
+      b.host_view(), -1.0, cutlass::maximum<double>(), cutlass::NumericConverter<double, double>(), policy);
+
+    EXPECT_EQ(reduced_max, max);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostTensorCompare, equals_single_mismatch) {
+  test::util::TestTensorEqualsSingleMismatch<float>(1.5f, 1.25f);
+  test::util::TestTensorEqualsSingleMismatch<double>(-2.0, 2.0);
+  test::util::TestTensorEqualsSingleMismatch<cutlass::half_t>(cutlass::half_t(3), cutlass::half_t(3.5f));
+  test::util::TestTensorEqualsSingleMismatch<cutlass::bfloat16_t>(cutlass::bfloat16_t(3), cutlass::bfloat16_t(-3));
+  test::util::TestTensorEqualsSingleMismatch<int8_t>(int8_t(5), int8_t(-5));
+  test::util::TestTensorEqualsSingleMismatch<int32_t>(7, 1 << 24);
+}
+
+TEST(ReferenceHostTensorCompare, equals_signed_zero_nan) {
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> a({64, 130});
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> b({64, 130});
+
+  cutlass::reference::host::TensorFill(a.host_view(), 0.0f);
+  cutlass::reference::host::TensorFill(b.host_view(), -0.0f);
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+
+  a.at({40, 100}) = std::nanf("");
+  b.at({40, 100}) = std::nanf("");
+
+  EXPECT_FALSE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+}
+
+TEST(ReferenceHostTensorCompare, report_mismatches) {
+
+  int const kM = 300;
+  int const kN = 410;
+
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> a({kM, kN + 5});
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> b({kM, kN});
+
+  cutlass::reference::host::TensorFill(a.host_view(), 2.0f);
+  cutlass::reference::host::TensorFill(b.host_view(), 2.0f);
+
+  // A view of the first kN columns of 'a' is packed. The transposed comparison is not.
+  cutlass::TensorView<float, cutlass::layout::ColumnMajor> a_view(a.host_ref(), {kM, kN});
+
+  for (int i = 0; i < 20; ++i) {
+    b.at({(i * 37) % kM, (i * 53 + 11) % kN}) = 2.0f + 0.125f * float(i);
+  }
+
+  b.at({kM - 1, kN - 1}) = 2.0f + 1e-6f;
+
+  auto result = cutlass::reference::host::TensorCompare(a_view, b.host_view(), 8);
+
+  EXPECT_FALSE(result.equal());
+  EXPECT_EQ(result.mismatch_count, 20);
+  EXPECT_EQ(result.max_error, 0.125 * 19);
+  ASSERT_EQ(result.mismatches.size(), size_t(8));
+
+  for (size_t i = 1; i < result.mismatches.size(); ++i) {
+    cutlass::Coord<2> prev = result.mismatches[i - 1];
+    cutlass::Coord<2> coord = result.mismatches[i];
+    EXPECT_TRUE(prev[0] < coord[0] || (prev[0] == coord[0] && prev[1] < coord[1]));
+    EXPECT_NE(a_view.at(coord), b.at(coord));
+  }
+
+  EXPECT_FALSE(cutlass::reference::host::TensorRelativelyEquals(a_view, b.host_view(), 1e-5f, 1e-5f));
+
+  auto relative = cutlass::reference::host::TensorCompareRelatively(a_view, b.host_view(), 1e-5f, 1e-7f);
+
+  // The smallest difference is within the tolerance
+  EXPECT_EQ(relative.mismatch_count, 19);
+  EXPECT_EQ(cutlass::reference::host::TensorCompare(b.host_view(), b.host_view()).mismatch_count, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostErrorMetrics, f32_single_pass) {
+
+  int const kM = 263;
+  int const kN = 301;
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> computed({kM, kN});
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> reference({kM, kN});
+
+  cutlass::reference::host::TensorFillRandomUniform(reference.host_view(), 5, 4, -4);
+  cutlass::reference::host::TensorCopy(computed.host_view(), reference.host_view());
+
+  // Perturb elements by 1, 2 and 1000 ULPs, and insert non-finite values
+  for (int n = 0; n < 10; ++n) {
+    float &x = computed.at({3, n});
+    x = std::nextafter(x, 8.0f);
+  }
+
+  for (int n = 0; n < 4; ++n) {
+    float &x = computed.at({100, n});
+    x = std::nextafter(std::nextafter(x, -8.0f), -8.0f);
+  }
+
+  computed.at({200, 7}) = reference.at({200, 7}) * (1.0f + 1000 * std::numeric_limits<float>::epsilon());
+  computed.at({kM - 1, kN - 1}) = std::numeric_limits<float>::infinity();
+  reference.at({0, 0}) = std::nanf("");
+
+  cutlass::reference::host::ErrorMetrics metrics =
+    cutlass::reference::host::TensorErrorMetrics(computed.host_view(), reference.host_view());
+
+  EXPECT_EQ(metrics.count, int64_t(kM) * kN);
+  EXPECT_TRUE(std::isinf(metrics.computed_sum_squares));
+  EXPECT_TRUE(std::isnan(metrics.reference_sum_squares));
+  EXPECT_TRUE(std::isnan(metrics.max_abs_error));
+  EXPECT_TRUE(std::isinf(metrics.max_rel_error));
+
+  EXPECT_EQ(metrics.ulp_histogram[0], int64_t(kM) * kN - 17);
+  EXPECT_EQ(metrics.ulp_histogram[1], 10);
+  EXPECT_EQ(metrics.ulp_histogram[2], 4);
+  EXPECT_EQ(metrics.ulp_histogram[10] + metrics.ulp_histogram[11], 1);
+  EXPECT_EQ(metrics.ulp_histogram[cutlass::reference::host::ErrorMetrics::kUlpBins - 1], 2);
+
+  EXPECT_EQ(metrics.computed_nan_count, 0);
+  EXPECT_EQ(metrics.computed_inf_count, 1);
+  EXPECT_EQ(metrics.reference_nan_count, 1);
+  EXPECT_EQ(metrics.reference_inf_count, 0);
+
+  // Without the non-finite elements, norms match direct sums
+  computed.at({kM - 1, kN - 1}) = reference.at({kM - 1, kN - 1});
+  reference.at({0, 0}) = computed.at({0, 0});
+
+  metrics = cutlass::reference::host::TensorErrorMetrics(computed.host_view(), reference.host_view());
+
+  double diff_sum_squares = 0;
+  double reference_sum_squares = 0;
+  double max_rel_error = 0;
+
+  for (int m = 0; m < kM; ++m) {
+    for (int n = 0; n < kN; ++n) {
+      double c = computed.at({m, n});
+      double r = reference.at({m, n});
+      diff_sum_squares += (c - r) * (c - r);
+      reference_sum_squares += r * r;
+      if (r != 0) {
+        max_rel_error = std::max(max_rel_error, std::abs(c - r) / std::abs(r));
+      }
+    }
+  }
+
+  EXPECT_NEAR(metrics.max_rel_error, max_rel_error, max_rel_error * 1e-12);
+  EXPECT_NEAR(metrics.diff_sum_squares, diff_sum_squares, diff_sum_squares * 1e-12);
+  EXPECT_NEAR(metrics.reference_sum_squares, reference_sum_squares, reference_sum_squares * 1e-12);
+  EXPECT_EQ(
+    cutlass::reference::host::TensorRelativeErrorMetric(computed.host_view(), reference.host_view()),
+    metrics.relative_error());
+}
+
+TEST(ReferenceHostErrorMetrics, f64_overflow) {
+
+  cutlass::HostTensor<double, cutlass::layout::RowMajor> computed({64, 100});
+  cutlass::HostTensor<double, cutlass::layout::RowMajor> reference({64, 100});
+
+  cutlass::reference::host::TensorFill(computed.host_view(), 0.5);
+  cutlass::reference::host::TensorFill(reference.host_view(), 0.5);
+
+  // Squares of the leading elements overflow, and every following term is finite
+  computed.at({0, 0}) = 1e200;
+  computed.at({0, 1}) = -std::numeric_limits<double>::infinity();
+
+  cutlass::reference::host::ErrorMetrics metrics =
+    cutlass::reference::host::TensorErrorMetrics(computed.host_view(), reference.host_view());
+
+  EXPECT_TRUE(std::isinf(metrics.computed_sum_squares));
+  EXPECT_TRUE(std::isinf(metrics.diff_sum_squares));
+  EXPECT_EQ(metrics.reference_sum_squares, 0.25 * 64 * 100);
+  EXPECT_TRUE(std::isinf(metrics.max_abs_error));
+  EXPECT_EQ(metrics.computed_inf_count, 1);
+  EXPECT_EQ(metrics.computed_nan_count, 0);
+}
+
+TEST(ReferenceHostErrorMetrics, f16_strided_complex) {
+
+  int const kM = 130;
+  int const kN = 75;
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::ColumnMajor> a({kM + 3, kN});
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::ColumnMajor> b({kM, kN});
+
+  cutlass::reference::host::TensorFill(a.host_view(), cutlass::half_t(1));
+  cutlass::reference::host::TensorFill(b.host_view(), cutlass::half_t(1));
+
+  cutlass::TensorView<cutlass::half_t, cutlass::layout::ColumnMajor> a_view(a.host_ref(), {kM, kN});
+
+  // 1 + 2^-10 is the successor of 1, and 1 + 2^-8 is 4 ULPs away
+  a_view.at({5, 6}) = cutlass::half_t(1.0f + 1.0f / 1024);
+  a_view.at({kM - 1, 0}) = cutlass::half_t(1.0f + 1.0f / 256);
+
+  cutlass::reference::host::ErrorMetrics metrics =
+    cutlass::reference::host::TensorErrorMetrics(a_view, b.host_view());
+
+  EXPECT_EQ(metrics.ulp_histogram[1], 1);
+  EXPECT_EQ(metrics.ulp_histogram[3], 1);
+  EXPECT_EQ(metrics.max_abs_error, 1.0 / 256);
+  EXPECT_EQ(metrics.reference_sum_squares, double(kM) * kN);
+
+  cutlass::HostTensor<cutlass::complex<float>, cutlass::layout::RowMajor> x({3, 4});
+  cutlass::HostTensor<cutlass::complex<float>, cutlass::layout::RowMajor> y({3, 4});
+
+  cutlass::reference::host::TensorFill(x.host_view(), cutlass::complex<float>(0, 0));
+  cutlass::reference::host::TensorFill(y.host_view(), cutlass::complex<float>(0, 0));
+
+  x.at({1, 2}) = cutlass::complex<float>(3, 4);
+  y.at({1, 2}) = cutlass::complex<float>(0, 4);
+
+  metrics = cutlass::reference::host::TensorErrorMetrics(x.host_view(), y.host_view());
+
+  EXPECT_EQ(metrics.max_abs_error, 3.0);
+  EXPECT_EQ(metrics.max_rel_error, 0.75);
+  EXPECT_EQ(metrics.computed_sum_squares, 25.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostTensorCopy, transpose_matrix) {
+
+  using cutlass::layout::ColumnMajor;
+  using cutlass::layout::RowMajor;
+
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<float, ColumnMajor, float, RowMajor>({203, 117}, {203, 117})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<float, RowMajor, float, ColumnMajor>({64, 256}, {64, 256})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<cutlass::half_t, ColumnMajor, cutlass::half_t, RowMajor>({77, 301}, {77, 301})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<int8_t, ColumnMajor, int8_t, RowMajor>({100, 90}, {100, 90})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<double, RowMajor, float, ColumnMajor>({129, 65}, {129, 65})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<double, ColumnMajor, double, ColumnMajor>({1000, 33}, {1000, 33})));
+}
+
+TEST(ReferenceHostTensorCopy, partial_extent) {
+
+  using cutlass::layout::ColumnMajor;
+  using cutlass::layout::RowMajor;
+
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<float, ColumnMajor, float, RowMajor>({150, 90}, {120, 200})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<int32_t, RowMajor, int32_t, RowMajor>({7, 5000}, {9, 4000})));
+}
+
+TEST(ReferenceHostTensorCopy, permute_activations) {
+
+  using cutlass::layout::TensorNCHW;
+  using cutlass::layout::TensorNHWC;
+
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<float, TensorNCHW, float, TensorNHWC>({3, 17, 19, 37}, {3, 17, 19, 37})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<cutlass::half_t, TensorNHWC, float, TensorNCHW>({2, 9, 31, 64}, {2, 9, 31, 64})));
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<int8_t, TensorNHWC, int8_t, TensorNHWC>({4, 7, 7, 3}, {4, 7, 7, 3})));
+}
+
+TEST(ReferenceHostTensorCopy, interleaved) {
+
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<
+    int8_t, cutlass::layout::ColumnMajorInterleaved<32>,
+    int8_t, cutlass::layout::RowMajor>({128, 96}, {128, 96})));
+
+  EXPECT_TRUE((test::util::TestTensorCopyLayouts<
+    float, cutlass::layout::TensorNHWC,
+    float, cutlass::layout::TensorNCxHWx<4> >({2, 5, 6, 16}, {2, 5, 6, 16})));
+}
+
+TEST(ReferenceHostTensorCopy, block_convert_rounding) {
+
+  using cutlass::FloatRoundStyle;
+  using cutlass::bfloat16_t;
+  using cutlass::half_t;
+
+  EXPECT_TRUE((test::util::TestBlockConvert<half_t, float, FloatRoundStyle::round_to_nearest>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<half_t, float, FloatRoundStyle::round_toward_zero>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<bfloat16_t, float, FloatRoundStyle::round_to_nearest>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<bfloat16_t, float, FloatRoundStyle::round_toward_zero>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<bfloat16_t, float, FloatRoundStyle::round_half_ulp_truncate>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<bfloat16_t, half_t, FloatRoundStyle::round_to_nearest>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<half_t, bfloat16_t, FloatRoundStyle::round_to_nearest>()));
+}
+
+TEST(ReferenceHostTensorCopy, block_convert_tf32) {
+
+  using cutlass::FloatRoundStyle;
+  using cutlass::tfloat32_t;
+
+  EXPECT_TRUE((test::util::TestBlockConvert<tfloat32_t, float, FloatRoundStyle::round_to_nearest>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<tfloat32_t, float, FloatRoundStyle::round_toward_zero>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<tfloat32_t, float, FloatRoundStyle::round_half_ulp_truncate>()));
+  EXPECT_TRUE((test::util::TestBlockConvert<tfloat32_t, float, FloatRoundStyle::round_half_ulp_trunc_dntz>()));
+}
+
+TEST(ReferenceHostTensorCopy, convert_fast_f32) {
+
+  using Layout = cutlass::layout::RowMajor;
+  using Convert = cutlass::NumericConverterFastF32<>;
+
+  cutlass::HostTensor<float, Layout> src({257, 131});
+  cutlass::HostTensor<cutlass::tfloat32_t, Layout> big({257, 131});
+  cutlass::HostTensor<cutlass::tfloat32_t, Layout> small({257, 131});
+  cutlass::HostTensor<cutlass::tfloat32_t, Layout> big_padded({257, 131}, Layout(136));
+
+  cutlass::reference::host::TensorFillRandomGaussian(src.host_view(), 29, 0, 4);
+
+  // Packed views are split as blocks and padded views one element at a time
+  cutlass::reference::host::TensorConvertFastF32(big.host_view(), small.host_view(), src.host_view());
+
+  for (int m = 0; m < 257; ++m) {
+    for (int n = 0; n < 131; ++n) {
+      Convert::result_type expected = Convert::convert(src.at({m, n}));
+      EXPECT_EQ(expected[0].raw(), big.at({m, n}).raw());
+      EXPECT_EQ(expected[1].raw(), small.at({m, n}).raw());
+    }
+  }
+
+  cutlass::reference::host::TensorConvertFastF32(big_padded.host_view(), small.host_view(), src.host_view());
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(big_padded.host_view(), big.host_view()));
+}
+
+TEST(ReferenceHostTensorCopy, block_convert_fp8) {
+  EXPECT_TRUE(test::util::TestBlockConvertFp8<cutlass::float_e4m3_t>());
+  EXPECT_TRUE(test::util::TestBlockConvertFp8<cutlass::float_e5m2_t>());
+}
+
+TEST(ReferenceHostTensorCopy, subbyte) {
+  EXPECT_TRUE(test::util::TestTensorSubbyte<cutlass::int4b_t>(131, 259, 264));
+  EXPECT_TRUE(test::util::TestTensorSubbyte<cutlass::uint4b_t>(131, 259, 259));
+  EXPECT_TRUE(test::util::TestTensorSubbyte<cutlass::int2b_t>(67, 129, 136));
+  EXPECT_TRUE(test::util::TestTensorSubbyte<cutlass::uint1b_t>(67, 129, 129));
+  EXPECT_TRUE(test::util::TestTensorSubbyte<cutlass::uint1b_t>(3, 5, 7));
+}
+
+TEST(ReferenceHostTensorCopy, subbyte_saturate) {
+
+  cutlass::HostTensor<int8_t, cutlass::layout::RowMajor> src({77, 301});
+  cutlass::HostTensor<cutlass::int4b_t, cutlass::layout::RowMajor> dst({77, 301});
+  cutlass::HostTensor<cutlass::int4b_t, cutlass::layout::RowMajor> wrapped({77, 301});
+
+  for (int m = 0; m < 77; ++m) {
+    for (int n = 0; n < 301; ++n) {
+      src.at({m, n}) = int8_t(m * 31 + n * 7);
+    }
+  }
+
+  cutlass::reference::host::TensorCopy(
+    dst.host_view(), src.host_view(), cutlass::NumericConverterClamp<cutlass::int4b_t, int8_t>());
+
+  // Numeric conversions to sub-byte integers keep the low bits
+  cutlass::reference::host::TensorCopy(wrapped.host_view(), src.host_view());
+
+  for (int m = 0; m < 77; ++m) {
+    for (int n = 0; n < 301; ++n) {
+      int value = src.at({m, n});
+      EXPECT_EQ(int(cutlass::int4b_t(dst.at({m, n}))), std::min(std::max(value, -8), 7));
+      EXPECT_EQ(int(cutlass::int4b_t(wrapped.at({m, n}))), int(cutlass::int4b_t(value)));
+    }
+  }
+}
+
+TEST(ReferenceHostTensorCopy, convert_transposed_toward_zero) {
+
+  using Convert = cutlass::NumericConverter<
+    cutlass::half_t, float, cutlass::FloatRoundStyle::round_toward_zero>;
+
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> src({301, 77});
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> dst({301, 77});
+
+  // Values beyond the range of half_t overflow to infinity
+  cutlass::reference::host::TensorFillRandomUniform(src.host_view(), 19, 80000, -80000, -1);
+  cutlass::reference::host::TensorCopy(dst.host_view(), src.host_view(), Convert());
+
+  Convert convert;
+
+  for (int m = 0; m < 301; ++m) {
+    for (int n = 0; n < 77; ++n) {
+      cutlass::half_t expected = convert(src.at({m, n}));
+      EXPECT_EQ(expected.raw(), dst.at({m, n}).raw());
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
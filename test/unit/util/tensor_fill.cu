@@ -0,0 +1,191 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests that host and device random fills with the same seed produce the same tensors.
+
+    Both draw the element with linear index i from the Philox-4x32-10 subsequence i of the seed.
+    Uniform fills and sparse metadata are computed with correctly rounded operations and agree
+    exactly. Gaussian fills also evaluate log, sqrt, cos and sin, whose device implementations may
+    differ from the host's by an ulp, so host and device elements agree to within one unit in the
+    last place of the element type.
+*/
+
+#include <cmath>
+#include <cstdint>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/complex.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/device/tensor_fill.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Fills a tensor with uniform random values on the host and on the device and compares them
+template <typename Element, typename Layout>
+bool TestTensorFillRandomUniform(
+  typename Layout::TensorCoord extent,
+  uint64_t seed,
+  double max,
+  double min,
+  int bits) {
+
+  cutlass::HostTensor<Element, Layout> host(extent);
+  cutlass::HostTensor<Element, Layout> device(extent);
+
+  cutlass::reference::host::TensorFillRandomUniform(host.host_view(), seed, max, min, bits);
+  cutlass::reference::device::TensorFillRandomUniform(
+    device.device_view(), seed, Element(max), Element(min), bits);
+
+  device.sync_host();
+
+  return cutlass::reference::host::TensorEquals(host.host_view(), device.host_view());
+}
+
+/// Fills a block with uniform random values on the host and on the device and compares them
+template <typename Element>
+bool TestBlockFillRandomUniform(size_t capacity, uint64_t seed, double max, double min, int bits) {
+
+  using Real = typename cutlass::RealType<Element>::Type;
+
+  cutlass::HostTensor<Element, cutlass::layout::PackedVectorLayout> host({int(capacity)});
+  cutlass::HostTensor<Element, cutlass::layout::PackedVectorLayout> device({int(capacity)});
+
+  cutlass::reference::host::BlockFillRandomUniform(
+    host.host_data(), capacity, seed, max, min, bits);
+  cutlass::reference::device::BlockFillRandomUniform(
+    device.device_data(), capacity, seed, Real(max), Real(min), bits);
+
+  device.sync_host();
+
+  return cutlass::reference::host::TensorEquals(host.host_view(), device.host_view());
+}
+
+/// Fills a tensor with Gaussian random values on the host and on the device and compares them
+/// to within one unit in the last place of Element, which is 'ulp' relative to the element
+template <typename Element, typename Layout>
+bool TestTensorFillRandomGaussian(
+  typename Layout::TensorCoord extent,
+  uint64_t seed,
+  double mean,
+  double stddev,
+  double ulp) {
+
+  cutlass::HostTensor<Element, Layout> host(extent);
+  cutlass::HostTensor<Element, Layout> device(extent);
+
+  cutlass::reference::host::TensorFillRandomGaussian(host.host_view(), seed, mean, stddev);
+  cutlass::reference::device::TensorFillRandomGaussian(
+    device.device_view(), seed, Element(mean), Element(stddev));
+
+  device.sync_host();
+
+  for (int64_t i = 0; i < int64_t(host.size()); ++i) {
+    double h = double(host.host_data()[i]);
+    double d = double(device.host_data()[i]);
+
+    if (!(std::abs(h - d) <= ulp * std::abs(h))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TensorFillRandom, uniform_rowmajor_f32) {
+
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<float, cutlass::layout::RowMajor>(
+    {129, 91}, 2019, 3, -2, -1)));
+}
+
+TEST(TensorFillRandom, uniform_nhwc_f16_bits) {
+
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<cutlass::half_t, cutlass::layout::TensorNHWC>(
+    {3, 17, 19, 24}, 2020, 4, -4, 2)));
+}
+
+TEST(TensorFillRandom, uniform_columnmajor_s8) {
+
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<int8_t, cutlass::layout::ColumnMajor>(
+    {64, 71}, 2021, 8, -8, 0)));
+}
+
+TEST(TensorFillRandom, uniform_block_f64) {
+
+  EXPECT_TRUE((test::util::TestBlockFillRandomUniform<double>(100003, 2022, 1, -1, -1)));
+}
+
+TEST(TensorFillRandom, uniform_block_complex_f32) {
+
+  EXPECT_TRUE((test::util::TestBlockFillRandomUniform<cutlass::complex<float>>(
+    4099, 2023, 2, -2, 1)));
+}
+
+TEST(TensorFillRandom, sparse_meta_u16) {
+
+  cutlass::HostTensor<uint16_t, cutlass::layout::RowMajor> host({64, 16});
+  cutlass::HostTensor<uint16_t, cutlass::layout::RowMajor> device({64, 16});
+
+  cutlass::reference::host::TensorFillRandomSparseMeta(host.host_view(), 7, 2);
+  cutlass::reference::device::TensorFillRandomSparseMeta(device.device_view(), 7, 2);
+
+  device.sync_host();
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(host.host_view(), device.host_view()));
+}
+
+TEST(TensorFillRandom, gaussian_rowmajor_f32) {
+
+  EXPECT_TRUE((test::util::TestTensorFillRandomGaussian<float, cutlass::layout::RowMajor>(
+    {257, 65}, 2024, 1, 2, std::ldexp(1.0, -23))));
+}
+
+TEST(TensorFillRandom, gaussian_nhwc_f16) {
+
+  EXPECT_TRUE((test::util::TestTensorFillRandomGaussian<cutlass::half_t, cutlass::layout::TensorNHWC>(
+    {2, 9, 11, 32}, 2025, 0, 1, std::ldexp(1.0, -10))));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -31,24 +31,31 @@
 
 /*! \file
     \brief reorder data from the host side 
+
+    Reorders visit the source in tiles of whole interleaved groups and are distributed over the
+    host thread pool. Destination positions come from index maps computed once per call, so the
+    inner loops perform no division. Each reorder has an unreorder_*() inverse restoring the
+    original arrangement.
 */
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+
 #include "cutlass/coord.h"
+#include "cutlass/numeric_types.h"
 #include "cutlass/util/host_tensor.h"
 #include "cutlass/tensor_view.h"
 #include "cutlass/util/tensor_view_io.h"
 #include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/detail/thread_pool.h"
 
 namespace cutlass {
 
-/// This is needed for the interleaved integer tensor core kernels.  The purpose
-/// is to use skip the shared memory part in the epilogue.
-template <int Interleaved, typename Element, typename Layout>
-void reorder_column(TensorRef<Element, Layout> dest,
-                    TensorRef<Element, Layout> src,
-                    cutlass::gemm::GemmCoord problem_size) {
+/// Column at which reorder_column() stores column n of the source
+template <int Interleaved>
+int reorder_column_index(int n) {
   const int InstructionShapeCol = 8;
   // 4 threads per Quad
   const int ElementsPerThread = InstructionShapeCol / 4;
@@ -56,18 +63,163 @@ void reorder_column(TensorRef<Element, Layout> dest,
   const int ReorderedElementsPerThread =
       Interleaved / 4;
 
-  for (int n = 0; n < problem_size.n(); n++) {
-    for (int k = 0; k < problem_size.k(); k++) {
-      dest.at({k, (n / Interleaved) * Interleaved +
-                      ((n % ReorderedElementsPerThread) / ElementsPerThread) *
-                          InstructionShapeCol +
-                      ((n % Interleaved) / ReorderedElementsPerThread) *
-                          ElementsPerThread +
-                      (n % ElementsPerThread)}) = src.at({k, n});
+  return (n / Interleaved) * Interleaved +
+         ((n % ReorderedElementsPerThread) / ElementsPerThread) *
+             InstructionShapeCol +
+         ((n % Interleaved) / ReorderedElementsPerThread) *
+             ElementsPerThread +
+         (n % ElementsPerThread);
+}
+
+/// Coordinate at which reorder_meta() stores element (m, k) of the sparse metadata
+template <typename Element>
+MatrixCoord reorder_meta_coord(int m, int k) {
+  // First reorder the rows.
+  int group = (sizeof(Element) == 2) ? 32 : 16;
+  int interweave = (sizeof(Element) == 2) ? 4 : 2;
+
+  int dest_row = m / group * group + (m % 8) * interweave + (m % group) / 8;
+  int dest_col = k;
+
+  // Next swizzle the 2x2 blocks from Z to N.
+  if (((dest_row % 2) == 0) && ((dest_col % 2) == 1)) {
+    ++dest_row;
+    --dest_col;
+  } else if (((dest_row % 2) == 1) && ((dest_col % 2) == 0)) {
+    --dest_row;
+    ++dest_col;
+  }
+
+  return MatrixCoord(dest_row, dest_col);
+}
+
+namespace detail {
+
+/// Number of rows of one column group visited by a reorder tile
+int const kHostReorderTileRows = 128;
+
+/// Minimum number of elements reordered by one thread
+int64_t const kHostReorderMinElements = 1 << 14;
+
+/// Offsets within a group of Interleaved columns at which reorder_column() stores each column
+template <int Interleaved>
+struct ReorderColumnMap {
+
+  int column[Interleaved];
+
+  ReorderColumnMap() {
+    for (int j = 0; j < Interleaved; ++j) {
+      column[j] = reorder_column_index<Interleaved>(j);
+    }
+  }
+};
+
+/// Offsets within a group of rows at which reorder_meta() stores each row, before the 2x2 swizzle
+template <typename Element>
+struct ReorderMetaMap {
+
+  static int const kGroup = (sizeof(Element) == 2) ? 32 : 16;
+  static int const kInterweave = (sizeof(Element) == 2) ? 4 : 2;
+
+  int row[kGroup];
+
+  ReorderMetaMap() {
+    for (int m = 0; m < kGroup; ++m) {
+      row[m] = (m % 8) * kInterweave + m / 8;
+    }
+  }
+};
+
+/// Visits a rows-by-columns index space in tiles of tile_rows-by-group_columns and calls
+/// func(row_begin, row_end, column_begin, column_end) for each tile. Tiles are processed by the
+/// host thread pool unless elements are narrower than a byte, in which case concurrent writes to
+/// neighbouring elements would race.
+template <typename Element, typename Func>
+void host_reorder_tiles(int rows, int columns, int tile_rows, int group_columns, Func func) {
+
+  if (rows <= 0 || columns <= 0) {
+    return;
+  }
+
+  int64_t row_tiles = (rows + tile_rows - 1) / tile_rows;
+  int64_t column_tiles = (columns + group_columns - 1) / group_columns;
+
+  auto tile_range = [&](int64_t begin, int64_t end) {
+    for (int64_t tile = begin; tile < end; ++tile) {
+      int row_begin = int(tile % row_tiles) * tile_rows;
+      int column_begin = int(tile / row_tiles) * group_columns;
+
+      func(
+        row_begin, std::min(row_begin + tile_rows, rows),
+        column_begin, std::min(column_begin + group_columns, columns));
     }
+  };
+
+  int64_t tiles = row_tiles * column_tiles;
+
+  if (sizeof_bits<Element>::value < 8) {
+    tile_range(0, tiles);
+  }
+  else {
+    int64_t tile_elements = int64_t(std::min(tile_rows, rows)) * std::min(group_columns, columns);
+    reference::host::detail::parallel_for_range(
+      tiles,
+      (kHostReorderMinElements + tile_elements - 1) / tile_elements,
+      tile_range);
   }
 }
 
+} // namespace detail
+
+/// This is needed for the interleaved integer tensor core kernels.  The purpose
+/// is to use skip the shared memory part in the epilogue.
+template <int Interleaved, typename Element, typename Layout>
+void reorder_column(TensorRef<Element, Layout> dest,
+                    TensorRef<Element, Layout> src,
+                    cutlass::gemm::GemmCoord problem_size) {
+
+  detail::ReorderColumnMap<Interleaved> map;
+
+  detail::host_reorder_tiles<Element>(
+    problem_size.k(), problem_size.n(), detail::kHostReorderTileRows, Interleaved,
+    [&](int k_begin, int k_end, int n_begin, int n_end) {
+      // Byte-sized stores may alias anything reached through the closure, so the references
+      // are copied to locals the compiler can keep in registers.
+      TensorRef<Element, Layout> local_dest(dest);
+      TensorRef<Element, Layout> local_src(src);
+
+      for (int n = n_begin; n < n_end; ++n) {
+        int dest_n = n_begin + map.column[n - n_begin];
+        for (int k = k_begin; k < k_end; ++k) {
+          local_dest.at({k, dest_n}) = local_src.at({k, n});
+        }
+      }
+    });
+}
+
+/// Inverse of reorder_column(): restores the original column order of src into dest
+template <int Interleaved, typename Element, typename Layout>
+void unreorder_column(TensorRef<Element, Layout> dest,
+                      TensorRef<Element, Layout> src,
+                      cutlass::gemm::GemmCoord problem_size) {
+
+  detail::ReorderColumnMap<Interleaved> map;
+
+  detail::host_reorder_tiles<Element>(
+    problem_size.k(), problem_size.n(), detail::kHostReorderTileRows, Interleaved,
+    [&](int k_begin, int k_end, int n_begin, int n_end) {
+      TensorRef<Element, Layout> local_dest(dest);
+      TensorRef<Element, Layout> local_src(src);
+
+      for (int n = n_begin; n < n_end; ++n) {
+        int src_n = n_begin + map.column[n - n_begin];
+        for (int k = k_begin; k < k_end; ++k) {
+          local_dest.at({k, n}) = local_src.at({k, src_n});
+        }
+      }
+    });
+}
+
 template <int ColumnInterleaved, int LayoutInterleaved = ColumnInterleaved, typename Element, typename Layout>
 void reorder_convK(TensorRef<Element, Layout> dest,
                     TensorRef<Element, Layout> src,
@@ -80,32 +232,71 @@ void reorder_convK(TensorRef<Element, Layout> dest,
         mappedDest, mappedSrc, problem_size);
 }
 
+/// Inverse of reorder_convK()
+template <int ColumnInterleaved, int LayoutInterleaved = ColumnInterleaved, typename Element, typename Layout>
+void unreorder_convK(TensorRef<Element, Layout> dest,
+                     TensorRef<Element, Layout> src,
+                     cutlass::gemm::GemmCoord problem_size) {
+
+    TensorRef<Element, layout::RowMajorInterleaved<LayoutInterleaved>> mappedDest(dest.data(), dest.stride(0));
+    TensorRef<Element, layout::RowMajorInterleaved<LayoutInterleaved>> mappedSrc(src.data(), src.stride(0));
+
+    unreorder_column<ColumnInterleaved>(
+        mappedDest, mappedSrc, problem_size);
+}
+
 /// This is needed for the sparse tensor core kernels.  The purpose
 /// is to use ldmatrix to load from shared memory to the register file.
 template <typename Element, typename LayoutDest, typename LayoutSrc>
 void reorder_meta(TensorRef<Element, LayoutDest> dest,
                   TensorRef<Element, LayoutSrc> src,
                   cutlass::gemm::GemmCoord problem_size) {
-  for (int m = 0; m < problem_size.m(); m++) {
-    for (int k = 0; k < problem_size.k(); k++) {
-      // First reorder the rows.
-      int group = (sizeof(Element) == 2) ? 32 : 16;
-      int interweave = (sizeof(Element) == 2) ? 4 : 2;
-
-      int dest_row = m / group * group + (m % 8) * interweave + (m % group) / 8;
-      int dest_col = k;
-
-      // Next swizzle the 2x2 blocks from Z to N.
-      if (((dest_row % 2) == 0) && ((dest_col % 2) == 1)) {
-        ++dest_row;
-        --dest_col;
-      } else if (((dest_row % 2) == 1) && ((dest_col % 2) == 0)) {
-        --dest_row;
-        ++dest_col;
+
+  using Map = detail::ReorderMetaMap<Element>;
+  Map map;
+
+  detail::host_reorder_tiles<Element>(
+    problem_size.m(), problem_size.k(), Map::kGroup, detail::kHostReorderTileRows,
+    [&](int m_begin, int m_end, int k_begin, int k_end) {
+      // Copied to locals for the same reason as in reorder_column()
+      TensorRef<Element, LayoutDest> local_dest(dest);
+      TensorRef<Element, LayoutSrc> local_src(src);
+
+      for (int m = m_begin; m < m_end; ++m) {
+        int row = m_begin + map.row[m - m_begin];
+        for (int k = k_begin; k < k_end; ++k) {
+          // Swizzling the 2x2 blocks from Z to N exchanges the low bits of row and column
+          // whenever they differ.
+          int swizzle = (row ^ k) & 1;
+          local_dest.at({row ^ swizzle, k ^ swizzle}) = local_src.at({m, k});
+        }
       }
+    });
+}
 
-      dest.at({dest_row, dest_col}) = src.at({m, k});
-    }
-  }
+/// Inverse of reorder_meta(): restores the original arrangement of src into dest
+template <typename Element, typename LayoutDest, typename LayoutSrc>
+void unreorder_meta(TensorRef<Element, LayoutDest> dest,
+                    TensorRef<Element, LayoutSrc> src,
+                    cutlass::gemm::GemmCoord problem_size) {
+
+  using Map = detail::ReorderMetaMap<Element>;
+  Map map;
+
+  detail::host_reorder_tiles<Element>(
+    problem_size.m(), problem_size.k(), Map::kGroup, detail::kHostReorderTileRows,
+    [&](int m_begin, int m_end, int k_begin, int k_end) {
+      TensorRef<Element, LayoutDest> local_dest(dest);
+      TensorRef<Element, LayoutSrc> local_src(src);
+
+      for (int m = m_begin; m < m_end; ++m) {
+        int row = m_begin + map.row[m - m_begin];
+        for (int k = k_begin; k < k_end; ++k) {
+          int swizzle = (row ^ k) & 1;
+          local_dest.at({m, k}) = local_src.at({row ^ swizzle, k ^ swizzle});
+        }
+      }
+    });
 }
+
 } // namespace cutlass
@@ -170,7 +170,8 @@ public:
     device_.reset();
     host_.clear();
 
-    count /= kElementsPerStoredItem;
+    // Sub-byte elements of a final partial item are stored in a whole item
+    count = (count + kElementsPerStoredItem - 1) / kElementsPerStoredItem;
 
     host_.resize(count);
 
@@ -135,6 +135,7 @@ __global__ void TensorDiagonalForEach(Coord<Rank> size, Params params, int start
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Kernel storing func(index) to the element of each index in a block
 template <typename Element, typename Func>
 __global__ void BlockForEach(
   Element *ptr, 
@@ -146,7 +147,7 @@ __global__ void BlockForEach(
   size_t index = threadIdx.x + blockIdx.x * blockDim.x;
 
   for (; index < capacity; index += blockDim.x * gridDim.x) {
-    ReferenceFactory<Element>::get(ptr, index) = func();
+    ReferenceFactory<Element>::get(ptr, index) = func(uint64_t(index));
   }
 }
 
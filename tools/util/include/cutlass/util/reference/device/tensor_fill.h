@@ -55,6 +55,7 @@
 #include "cutlass/cutlass.h"
 #include "cutlass/array.h"
 #include "cutlass/complex.h"
+#include "cutlass/fast_math.h"
 #include "cutlass/tensor_view.h"
 #include "cutlass/blas3.h"
 
@@ -72,36 +73,67 @@ namespace device {
 
 namespace detail {
 
-template <typename FloatType>
+/// Returns the Philox generator of the element with the given linear index. Host reference fills
+/// draw each element from the same stream (see reference/host/detail/philox.h), so host and device
+/// fills with the same seed produce the same values regardless of the launch configuration.
 CUTLASS_DEVICE
-FloatType random_normal_float(curandState_t *state) {
-  return curand_normal(state);
+curandStatePhilox4_32_10_t random_stream(uint64_t seed, uint64_t index) {
+  curandStatePhilox4_32_10_t state;
+  curand_init(seed, index, 0, &state);
+  return state;
 }
 
-template <>
+/// Returns the linear index of 'coord' within 'extent', as the host reference fills compute it
+template <int Rank>
 CUTLASS_DEVICE
-double random_normal_float<double>(curandState_t *state) {
-  return curand_normal_double(state);
+uint64_t random_stream_index(Coord<Rank> const &coord, Coord<Rank> const &extent) {
+  uint64_t index = 0;
+  CUTLASS_PRAGMA_UNROLL
+  for (int i = 0; i < Rank; ++i) {
+    index = index * uint64_t(extent[i]) + uint64_t(coord[i]);
+  }
+  return index;
+}
+
+/// Computes min + range * rnd with separately rounded operations, as host code does
+CUTLASS_DEVICE
+double random_scale(double rnd, double min, double range) {
+  return __dadd_rn(min, __dmul_rn(range, rnd));
 }
 
-template <typename FloatType>
+/// Returns a pair of values of the Gaussian distribution generated by the Box Muller method from
+/// two uniform values of 'state'. The device's log, sqrt, cos and sin may differ from the host's
+/// in the last place.
 CUTLASS_DEVICE
-FloatType random_uniform_float(curandState_t *state) {
-  return curand_uniform(state);
+void random_box_muller(
+  curandStatePhilox4_32_10_t *state,
+  double *rnd,
+  double mean,
+  double stddev) {
+
+  double const kPi = 3.14159265358979323846;
+
+  double u1 = curand_uniform_double(state);
+  double u2 = curand_uniform_double(state);
+
+  double radius = fast_sqrt(__dmul_rn(-2, fast_log(u1)));
+  double angle = __dmul_rn(2 * kPi, u2);
+
+  rnd[0] = random_scale(__dmul_rn(radius, fast_cos(angle)), mean, stddev);
+  rnd[1] = random_scale(__dmul_rn(radius, fast_sin(angle)), mean, stddev);
 }
 
-template <>
+/// Truncates 'rnd' to 'int_scale' fractional bits, as the host reference fills do
+template <typename IntType>
 CUTLASS_DEVICE
-double random_uniform_float<double>(curandState_t *state) {
-  return curand_uniform_double(state);
+double random_truncate(double rnd, int int_scale) {
+  double scale = double(1 << int_scale);
+  return double(IntType(__dmul_rn(rnd, scale))) / scale;
 }
 
 template <typename Element>
 struct RandomGaussianFunc {
 
-  using FloatType = typename std::conditional<(sizeof(Element) > 4), double, float>::type;
-  using IntType = typename std::conditional<(sizeof(Element) > 4), int64_t, int>::type;
-
   /// Parameters structure
   struct Params {
 
@@ -110,11 +142,9 @@ struct RandomGaussianFunc {
     //
 
     uint64_t seed;
-    FloatType mean;
-    FloatType stddev;
+    double mean;
+    double stddev;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
 
     //
     // Methods
@@ -128,13 +158,10 @@ struct RandomGaussianFunc {
       int int_scale_ = -1
     ):
       seed(seed_), 
-      mean(static_cast<FloatType>(mean_)), 
-      stddev(static_cast<FloatType>(stddev_)), 
+      mean(static_cast<double>(mean_)), 
+      stddev(static_cast<double>(stddev_)), 
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(1) << int_scale);
-      float_scale_up += FloatType(0.5) * float_scale_up;
-      float_scale_down = FloatType(1) / FloatType(IntType(1) << int_scale);
     }
   };
 
@@ -145,39 +172,29 @@ struct RandomGaussianFunc {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomGaussianFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element with the given index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
+
+    curandStatePhilox4_32_10_t state = random_stream(params.seed, index);
 
-    FloatType rnd = random_normal_float<FloatType>(&rng_state);
-    rnd = params.mean + params.stddev * rnd;
+    double rnd[2];
+    random_box_muller(&state, rnd, params.mean, params.stddev);
 
-    Element result;
     if (params.int_scale >= 0) {
-      rnd = FloatType(IntType(rnd * params.float_scale_up));
-      result = Element(rnd * params.float_scale_down);
-    }
-    else {
-      result = Element(rnd);
+      rnd[0] = random_truncate<int64_t>(rnd[0], params.int_scale);
     }
 
-    return result;
+    return static_cast<Element>(rnd[0]);
   }
 };
 
@@ -186,8 +203,6 @@ template <typename Real>
 struct RandomGaussianFunc<complex<Real>> {
 
   using Element = complex<Real>;
-  using FloatType = typename std::conditional<(sizeof(Real) > 4), double, float>::type;
-  using IntType = typename std::conditional<(sizeof(Real) > 4), int64_t, int>::type;
 
   /// Parameters structure
   struct Params {
@@ -197,11 +212,9 @@ struct RandomGaussianFunc<complex<Real>> {
     //
 
     uint64_t seed;
-    FloatType mean;
-    FloatType stddev;
+    double mean;
+    double stddev;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
 
     //
     // Methods
@@ -215,13 +228,10 @@ struct RandomGaussianFunc<complex<Real>> {
       int int_scale_ = -1
     ):
       seed(seed_), 
-      mean(static_cast<FloatType>(mean_)), 
-      stddev(static_cast<FloatType>(stddev_)), 
+      mean(static_cast<double>(mean_)), 
+      stddev(static_cast<double>(stddev_)), 
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(1) << int_scale);
-      float_scale_up += FloatType(0.5) * float_scale_up;
-      float_scale_down = FloatType(1) / FloatType(IntType(1) << int_scale);
     }
   };
 
@@ -232,46 +242,30 @@ struct RandomGaussianFunc<complex<Real>> {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomGaussianFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element with the given index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
 
-    FloatType rnd_r = random_normal_float<FloatType>(&rng_state);
-    FloatType rnd_i = random_normal_float<FloatType>(&rng_state);
-    rnd_r = params.mean + params.stddev * rnd_r;
-    rnd_i = params.mean + params.stddev * rnd_i;
+    curandStatePhilox4_32_10_t state = random_stream(params.seed, index);
 
-    Element result;
-    if (params.int_scale >= 0) {
-      rnd_r = FloatType(IntType(rnd_r * params.float_scale_up));
-      rnd_i = FloatType(IntType(rnd_i * params.float_scale_down));
+    double rnd[2];
+    random_box_muller(&state, rnd, params.mean, params.stddev);
 
-      result = {
-        Real(rnd_r * params.float_scale_down),
-        Real(rnd_i * params.float_scale_down)
-      };
-    }
-    else {
-      result = Element(Real(rnd_r), Real(rnd_i));
+    if (params.int_scale >= 0) {
+      rnd[0] = random_truncate<int>(rnd[0], params.int_scale);
+      rnd[1] = random_truncate<int>(rnd[1], params.int_scale);
     }
 
-    return result;
+    return Element(from_real<Real>(rnd[0]), from_real<Real>(rnd[1]));
   }
 };
 
@@ -333,11 +327,11 @@ struct TensorFillRandomGaussianFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at 'coord'
   CUTLASS_DEVICE
   void operator()(TensorCoord const &coord) {
 
-    params.view.at(coord) = random();
+    params.view.at(coord) = random(random_stream_index(coord, params.view.extent()));
   }
 };
 
@@ -394,20 +388,10 @@ void BlockFillRandomGaussian(
 
 namespace detail {
 
-/// Computes a random Gaussian distribution
+/// Computes a random uniform distribution
 template <typename Element>                ///< Element type 
 struct RandomUniformFunc {
 
-  using FloatType = typename std::conditional<
-    (sizeof(Element) > 4),
-    double,
-    float>::type;
-
-  using IntType = typename std::conditional<
-    (sizeof(Element) > 4),
-    int64_t,
-    int>::type;
-
   /// Parameters structure
   struct Params {
 
@@ -416,11 +400,9 @@ struct RandomUniformFunc {
     //
 
     uint64_t seed;
-    FloatType range;
-    FloatType max;
+    double range;
+    double min;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
 
     /// Default ctor
     CUTLASS_HOST_DEVICE
@@ -430,21 +412,18 @@ struct RandomUniformFunc {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of uniform RNG functor.
     Params(
       uint64_t seed_ = 0, 
-      Element max_ = 1,
-      Element min = 0,
+      Element max = 1,
+      Element min_ = 0,
       int int_scale_ = -1
     ):
       seed(seed_), 
-      range(static_cast<FloatType>(max_ - min)), 
-      max(static_cast<FloatType>(max_)),
+      range(static_cast<double>(max) - static_cast<double>(min_)), 
+      min(static_cast<double>(min_)),
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(1) << int_scale);
-      float_scale_up += FloatType(0.5) * float_scale_up;
-      float_scale_down = FloatType(1) / FloatType(IntType(1) << int_scale);
     }
   };
 
@@ -455,61 +434,39 @@ struct RandomUniformFunc {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomUniformFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element with the given index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
+
+    curandStatePhilox4_32_10_t state = random_stream(params.seed, index);
 
-    FloatType rnd = random_uniform_float<FloatType>(&rng_state);
-    rnd = params.max - params.range * rnd;
+    double rnd = random_scale(curand_uniform_double(&state), params.min, params.range);
 
     // Random values are cast to integer after scaling by a power of two to facilitate error
     // testing
-    Element result;
-
     if (params.int_scale >= 0) {
-      rnd = FloatType(IntType(rnd * params.float_scale_up));
-      result = Element(rnd * params.float_scale_down);
-    }
-    else {
-      result = Element(rnd);
+      rnd = random_truncate<int64_t>(rnd, params.int_scale);
     }
 
-    return result;
+    return static_cast<Element>(rnd);
   }
 };
 
-/// Computes a random Gaussian distribution
+/// Computes a random uniform distribution
 template <typename Real>
 struct RandomUniformFunc<complex<Real>> {
 
   using Element = complex<Real>;
 
-  using FloatType = typename std::conditional<
-    (sizeof(Real) > 4),
-    double,
-    float>::type;
-
-  using IntType = typename std::conditional<
-    (sizeof(Real) > 4),
-    int64_t,
-    int>::type;
-
   /// Parameters structure
   struct Params {
 
@@ -518,11 +475,9 @@ struct RandomUniformFunc<complex<Real>> {
     //
 
     uint64_t seed;
-    FloatType range;
-    FloatType min;
+    double range;
+    double min;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
 
     /// Default ctor
     CUTLASS_HOST_DEVICE
@@ -532,21 +487,18 @@ struct RandomUniformFunc<complex<Real>> {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of uniform RNG functor.
     Params(
       uint64_t seed_ = 0, 
-      FloatType max = 1,
-      FloatType min_ = 0,
+      double max = 1,
+      double min_ = 0,
       int int_scale_ = -1
     ):
       seed(seed_), 
-      range(static_cast<FloatType>(max - min_)), 
-      min(static_cast<FloatType>(min_)), 
+      range(max - min_), 
+      min(min_), 
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(1) << int_scale);
-      float_scale_up += FloatType(0.5) * float_scale_up;
-      float_scale_down = FloatType(1) / FloatType(IntType(1) << int_scale);
     }
   };
 
@@ -557,50 +509,35 @@ struct RandomUniformFunc<complex<Real>> {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomUniformFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element with the given index
   CUTLASS_DEVICE
-  Element operator()() {
-
-    FloatType rnd_r = random_uniform_float<FloatType>(&rng_state);
-    FloatType rnd_i = random_uniform_float<FloatType>(&rng_state);
+  Element operator()(uint64_t index) const {
 
-    rnd_r = params.min + params.range * rnd_r;
-    rnd_i = params.min + params.range * rnd_i;
+    curandStatePhilox4_32_10_t state = random_stream(params.seed, index);
 
-    // Random values are cast to integer after scaling by a power of two to facilitate error
-    // testing
-    Element result;
+    double rnd[2];
 
-    if (params.int_scale >= 0) {
-      rnd_r = FloatType(IntType(rnd_r * params.float_scale_up));
-      rnd_i = FloatType(IntType(rnd_i * params.float_scale_up));
+    CUTLASS_PRAGMA_UNROLL
+    for (int i = 0; i < 2; ++i) {
+      rnd[i] = random_scale(curand_uniform_double(&state), params.min, params.range);
 
-      result = {
-        Real(rnd_r * params.float_scale_down),
-        Real(rnd_i * params.float_scale_down)
-      };
-    }
-    else {
-      result = Element(Real(rnd_r), Real(rnd_i));
+      // Random values are cast to integer after scaling by a power of two to facilitate error
+      // testing
+      if (params.int_scale >= 0) {
+        rnd[i] = random_truncate<int>(rnd[i], params.int_scale);
+      }
     }
 
-    return result;
+    return Element(from_real<Real>(rnd[0]), from_real<Real>(rnd[1]));
   }
 };
 
@@ -665,11 +602,11 @@ struct TensorFillRandomUniformFunc {
   TensorFillRandomUniformFunc(Params const &params): params(params), random(params.random) {
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at 'coord'
   CUTLASS_DEVICE
   void operator()(TensorCoord const &coord) {
 
-    params.view.at(coord) = random();
+    params.view.at(coord) = random(random_stream_index(coord, params.view.extent()));
   }
 };
 
@@ -732,10 +669,6 @@ namespace detail {
 template <typename Element>               ///< Element type
 struct RandomSparseMetaFunc {
 
-  using FloatType = float;
-
-  using IntType = int32_t;
-
   /// Parameters structure
   struct Params {
 
@@ -744,7 +677,7 @@ struct RandomSparseMetaFunc {
     //
 
     uint64_t seed;
-    FloatType range;
+    uint32_t range;
     int MetaSizeInBits;
 
     /// Default ctor
@@ -755,7 +688,7 @@ struct RandomSparseMetaFunc {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of sparse meta RNG functor.
     Params(
       uint64_t seed_ = 0, 
       int MetaSizeInBits_ = 2 
@@ -777,38 +710,31 @@ struct RandomSparseMetaFunc {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomSparseMetaFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element with the given index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
     Element FourToTwoMeta[6] = {0x4, 0x8, 0x9, 0xc, 0xd, 0xe};
     Element TwoToOneMeta[2] = {0x4, 0xe};
 
     Element *MetaArray =
         (params.MetaSizeInBits == 2) ? FourToTwoMeta : TwoToOneMeta;
 
+    curandStatePhilox4_32_10_t state = random_stream(params.seed, index);
+
     Element result = 0x0;
 
     CUTLASS_PRAGMA_UNROLL
     for (int i = 0; i < cutlass::sizeof_bits<Element>::value / 4; ++i) {
-      FloatType rnd = random_uniform_float<FloatType>(&rng_state);
-      rnd = params.range * rnd;
-      Element meta = MetaArray[(int)rnd];
+      Element meta = MetaArray[curand(&state) % params.range];
 
       result = (Element)(result | ((Element)(meta << (i * 4))));
     }
@@ -878,11 +804,11 @@ struct TensorFillRandomSparseMetaFunc {
   TensorFillRandomSparseMetaFunc(Params const &params): params(params), random(params.random) {
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at 'coord'
   CUTLASS_DEVICE
   void operator()(TensorCoord const &coord) {
 
-    params.view.at(coord) = random();
+    params.view.at(coord) = random(random_stream_index(coord, params.view.extent()));
   }
 };
 
@@ -902,7 +828,7 @@ void TensorFillRandomSparseMeta(
                                           ///  data.                 
   
   using RandomFunc = detail::RandomSparseMetaFunc<Element>;
-  using Func = detail::TensorFillRandomUniformFunc<Element, Layout>;
+  using Func = detail::TensorFillRandomSparseMetaFunc<Element, Layout>;
   using Params = typename Func::Params;
 
   typename RandomFunc::Params random(seed, MetaSizeInBits);
@@ -45,6 +45,8 @@
 #include "cutlass/conv/convolution.h"
 #include "cutlass/conv/conv2d_problem_size.h"
 #include "cutlass/conv/conv3d_problem_size.h"
+#include "cutlass/util/reference/host/detail/conv_depthwise.h"
+#include "cutlass/util/reference/host/detail/conv_implicit_gemm.h"
 #include <iostream>
 
 namespace cutlass {
@@ -78,46 +80,24 @@ void Conv2dFprop(
   ElementCompute beta) {
 
   ConvertOp convert_op;
-  InnerProductOp inner_product_op;
 
-  // Apply MMA and accumulate ElementAccumulator
-  for (int n = 0; n < problem_size.N; ++n) {
-    for (int p = 0; p < problem_size.P; ++p) {
-      for (int q = 0; q < problem_size.Q; ++q) {
+  int const channels_per_group = problem_size.C / problem_size.groups;
+  int const filters_per_group = problem_size.K / problem_size.groups;
+
+  // Depthwise convolution filters each channel independently
+  if (channels_per_group == 1 && filters_per_group == 1) {
+
+    detail::conv2d_depthwise_fprop<ElementAccumulator, InnerProductOp>(
+      problem_size,
+      tensor_x,
+      [&](int k, int r, int s) {
+        ElementB b = tensor_w.at(cutlass::make_Coord(k, r, s, 0));
+        return ElementAccumulator(b);
+      },
+      false,
+      [&](int n, int p, int q, ElementAccumulator const *accum) {
         for (int k = 0; k < problem_size.K; ++k) {
 
-          int group_idx = k / (problem_size.K / problem_size.groups);
-          int channels_per_group = problem_size.C / problem_size.groups;
-
-          ElementAccumulator acc = ElementAccumulator();
-
-          for (int r = 0; r < problem_size.R; ++r) {
-            for (int s = 0; s < problem_size.S; ++s) {
-              for (int c = 0; c < channels_per_group; ++c) {
-
-                int filter_r = r;
-                int filter_s = s;
-
-                if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
-                  filter_r = problem_size.R - 1 - r;
-                  filter_s = problem_size.S - 1 - s;
-                }
-
-                int h = p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h;
-                int w = q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w;
-
-                if (h >= 0 && h < problem_size.H && w >= 0 && w < problem_size.W) {
-
-                  ElementA a = tensor_x.at({n, h, w, c + group_idx * channels_per_group});
-                  ElementB b = tensor_w.at({k, r, s, c});
-
-                  acc = inner_product_op(ElementAccumulator(a), ElementAccumulator(b), acc);
-
-                }
-              }
-            }
-          }
-
           // Apply Epilogue, compute ElementCompute, convert and store ElementC
           ElementC c_ref = ElementC();
 
@@ -126,10 +106,47 @@ void Conv2dFprop(
           }
 
           tensor_y_out.at(cutlass::make_Coord(n, p, q, k)) =
-              convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+              convert_op(alpha * ElementCompute(accum[k]) + beta * ElementCompute(c_ref));
         }
-      }
-    }
+      });
+
+    return;
+  }
+
+  // Implicit GEMM: M = N*P*Q, N = K / groups, K = R*S*C / groups for each group
+  for (int group_idx = 0; group_idx < problem_size.groups; ++group_idx) {
+
+    int const filter_offset = group_idx * filters_per_group;
+
+    detail::gemm_engine<ElementAccumulator, InnerProductOp>(
+      problem_size.N * problem_size.P * problem_size.Q,
+      filters_per_group,
+      problem_size.R * problem_size.S * channels_per_group,
+      detail::MaskedOperand<
+        detail::Conv2dFpropActivationDecoder<ElementAccumulator, ElementA, LayoutA>>{
+          {tensor_x, problem_size, channels_per_group, group_idx * channels_per_group}},
+      detail::FactoredOperand<
+        detail::Conv2dFpropFilterDecoder<ElementAccumulator, ElementB, LayoutB>>{
+          {tensor_w, problem_size, channels_per_group, filter_offset}},
+      [&](int row, int col, ElementAccumulator const &acc) {
+
+        int q = row % problem_size.Q;
+        int npq = row / problem_size.Q;
+        int p = npq % problem_size.P;
+        int n = npq / problem_size.P;
+        int k = filter_offset + col;
+
+        // Apply Epilogue, compute ElementCompute, convert and store ElementC
+        ElementC c_ref = ElementC();
+
+        if (beta != ElementCompute()) {
+          c_ref = tensor_y_in.at(cutlass::make_Coord(n, p, q, k));
+        }
+
+        tensor_y_out.at(cutlass::make_Coord(n, p, q, k)) =
+            convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+      },
+      ElementAccumulator());
   }
 }
 
@@ -156,42 +173,45 @@ void Depsep_Fprop(cutlass::TensorView<ElementA, LayoutA> tensor_A,
                   cutlass::conv::Mode mode = cutlass::conv::Mode::kCrossCorrelation) {
 
   ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-
-  // Apply MMA and accumulate ElementAccumulator
-  for (int n = 0; n < tensor_C.extent().n(); ++n) {
-    for (int p = 0; p < tensor_C.extent().h(); ++p) {
-      for (int q = 0; q < tensor_C.extent().w(); ++q) {
-        for (int g = 0; g < tensor_C.extent().c(); ++g) {
-          ElementAccumulator acc = ElementAccumulator();
-          for (int r = 0; r < tensor_B.extent().h(); ++r) {
-            for (int s = 0; s < tensor_B.extent().w(); ++s) {
-              
-              // input activation H and W
-              int h = p * conv_stride[0] - padding[0] + r * dilation[0];
-              int w = q * conv_stride[1] - padding[2] + s * dilation[1];
-
-              if (h < tensor_A.extent().h() && h >= 0 && w < tensor_A.extent().w() && w >= 0) {
-                ElementA a = tensor_A.at(cutlass::make_Coord(n, h, w, g));
-
-                ElementB b = (mode == cutlass::conv::Mode::kCrossCorrelation)
-                                   ? tensor_B.at(cutlass::make_Coord(g, r, s, 0))
-                                   : tensor_B.at(cutlass::make_Coord(
-                                         g, tensor_B.extent().h() - r - 1, tensor_B.extent().w() - s - 1, 0));
-
-                acc = inner_product_op(ElementAccumulator(a), ElementAccumulator(b), acc);
-              }
-            }
-          }
 
-          // Apply Epilogue, compute ElementCompute, convert and store ElementC
-          ElementC c_ref = tensor_C.at(cutlass::make_Coord(n, p, q, g));
-          tensor_D.at(cutlass::make_Coord(n, p, q, g)) =
-              convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
-        }
+  cutlass::conv::Conv2dProblemSize problem_size(
+    tensor_C.extent().n(),
+    tensor_A.extent().h(),
+    tensor_A.extent().w(),
+    tensor_C.extent().c(),
+    tensor_C.extent().c(),
+    tensor_B.extent().h(),
+    tensor_B.extent().w(),
+    tensor_C.extent().h(),
+    tensor_C.extent().w(),
+    padding[0],
+    padding[2],
+    conv_stride[0],
+    conv_stride[1],
+    dilation[0],
+    dilation[1],
+    mode,
+    1,
+    tensor_C.extent().c());
+
+  // Apply MMA and accumulate ElementAccumulator. The filter is flipped in convolution mode.
+  detail::conv2d_depthwise_fprop<ElementAccumulator, InnerProductOp>(
+    problem_size,
+    tensor_A,
+    [&](int g, int r, int s) {
+      ElementB b = tensor_B.at(cutlass::make_Coord(g, r, s, 0));
+      return ElementAccumulator(b);
+    },
+    true,
+    [&](int n, int p, int q, ElementAccumulator const *accum) {
+      for (int g = 0; g < problem_size.C; ++g) {
+
+        // Apply Epilogue, compute ElementCompute, convert and store ElementC
+        ElementC c_ref = tensor_C.at(cutlass::make_Coord(n, p, q, g));
+        tensor_D.at(cutlass::make_Coord(n, p, q, g)) =
+            convert_op(alpha * ElementCompute(accum[g]) + beta * ElementCompute(c_ref));
       }
-    }
-  }
+    });
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -221,63 +241,28 @@ void Conv2dDgrad(
   ElementCompute beta) {
 
   ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-
-  // Apply MMA and accumulate ElementAccumulator
-  for (int n = 0; n < problem_size.N; ++n) {
-    for (int h = 0; h < problem_size.H; ++h) {
-      for (int w = 0; w < problem_size.W; ++w) {
-        for (int c = 0; c < problem_size.C; ++c) {
-
-          ElementAccumulator acc = ElementAccumulator();
-
-          for (int r = 0; r < problem_size.R; ++r) {
-            for (int s = 0; s < problem_size.S; ++s) {
-              for (int k = 0; k < problem_size.K; ++k) {
-
-                int filter_r = r;
-                int filter_s = s;
-
-                if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
-                  filter_r = problem_size.R - 1 - r;
-                  filter_s = problem_size.S - 1 - s;
-                }
-
-                int p = h + problem_size.pad_h - filter_r * problem_size.dilation_h;
-                int q = w + problem_size.pad_w - filter_s * problem_size.dilation_w;
-
-                if (p >= 0 && (p % problem_size.stride_h) == 0 && 
-                    q >= 0 && (q % problem_size.stride_w) == 0) {
-
-                  p = p / problem_size.stride_h;
-                  q = q / problem_size.stride_w;
-#if 0
-                  std::cout << "row:" 
-                  << n * problem_size.H * problem_size.W +
-                    h * problem_size.W +
-                    w << " "
-                  << "n, p, q: (" 
-                  << n << ", "
-                  << p << ", "
-                  << q << ") * "
-                  << "r, s: (" 
-                  << r << ", "
-                  << s << ") [" 
-                  << ((p < problem_size.P && q < problem_size.Q) ? "true":"false") << "]"        
-                  << std::endl;
-#endif
-                  if (p < problem_size.P && q < problem_size.Q) {
-
-                    ElementA a = tensor_dy.at(cutlass::make_Coord(n, p, q, k));
-                    ElementB b = tensor_w.at(cutlass::make_Coord(k, r, s, c));
-
-                    acc = inner_product_op(ElementAccumulator(a), ElementAccumulator(b), acc);
-                  }
-                }
-
-              } // for (K)
-            } // for (S)
-          } // for (R)
+
+  // Implicit GEMM for each phase of the stride: M = N*H*W, N = C, K = R*S*K, where H, W and R*S
+  // count the input positions of the phase and the filter positions reaching them
+  for (int phase_h = 0; phase_h < problem_size.stride_h; ++phase_h) {
+    for (int phase_w = 0; phase_w < problem_size.stride_w; ++phase_w) {
+
+      detail::Conv2dDgradPhase phase(problem_size, phase_h, phase_w);
+
+      detail::gemm_engine<ElementAccumulator, InnerProductOp>(
+        problem_size.N * phase.H * phase.W,
+        problem_size.C,
+        int(phase.taps.size()) * problem_size.K,
+        detail::MaskedOperand<
+          detail::Conv2dDgradOutputGradientDecoder<ElementAccumulator, ElementA, LayoutA>>{
+            {tensor_dy, problem_size, &phase}},
+        detail::FactoredOperand<
+          detail::Conv2dDgradFilterDecoder<ElementAccumulator, ElementB, LayoutB>>{
+            {tensor_w, problem_size, &phase}},
+        [&](int row, int c, ElementAccumulator const &acc) {
+
+          int n, h, w;
+          phase.input_position(row, n, h, w);
 
           // Apply Epilogue, compute ElementCompute, convert and store ElementC
           ElementC c_ref = ElementC();
@@ -288,11 +273,10 @@ void Conv2dDgrad(
 
           tensor_dx_out.at(cutlass::make_Coord(n, h, w, c)) =
               convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
-
-        } // for (C)
-      } // for (W)
-    } // for (H)
-  } // for (N)
+        },
+        ElementAccumulator());
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -320,63 +304,38 @@ void Conv2dWgrad(
   TensorRef<ElementC, LayoutC> tensor_dw_out,
   ElementCompute alpha,
   ElementCompute beta) {
-  
-  InnerProductOp inner_product_op;
-  ConvertOp convert_op;
-
-  // Apply MMA and accumulate ElementAccumulator
-  for (int k = 0; k < problem_size.K; ++k) {
-    for (int r = 0; r < problem_size.R; ++r) {
-      for (int s = 0; s < problem_size.S; ++s) {
-        for (int c = 0; c < problem_size.C; ++c) {
-
-          ElementAccumulator acc = ElementAccumulator();
-
-          for (int n = 0; n < problem_size.N; ++n) {
-            for (int p = 0; p < problem_size.P; ++p) {
-              for (int q = 0; q < problem_size.Q; ++q) {
-                  
-                cutlass::Tensor4DCoord b_coord;
-                
-                int filter_r = r;
-                int filter_s = s; 
-
-                if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
-                  filter_r = problem_size.R - 1 - r;
-                  filter_s = problem_size.S - 1 - s;
-                }
-
-                b_coord = make_Coord(
-                    n,
-                    p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h,
-                    q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w,
-                    c);
-
-                if (b_coord.h() < problem_size.H && b_coord.h() >= 0 &&
-                    b_coord.w() < problem_size.W && b_coord.w() >= 0) {
-
-                  ElementAccumulator a = ElementAccumulator(tensor_dy.at(cutlass::make_Coord(n, p, q, k)));
-                  ElementAccumulator b = ElementAccumulator(tensor_x.at(b_coord));
-                  acc = inner_product_op(a, b, acc);
-                }
-              }
-            }
-          }
 
-          // Apply Epilogue, compute ElementCompute, convert and store ElementC
-          ElementC c_ref = ElementC();
-
-          if (beta != ElementCompute()) {
-            c_ref = tensor_dw_in.at(cutlass::make_Coord(k, r, s, c));
-          }
+  ConvertOp convert_op;
 
-          tensor_dw_out.at(cutlass::make_Coord(k, r, s, c)) =
-              convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+  // Implicit GEMM: M = K, N = R*S*C, K = N*P*Q
+  detail::gemm_engine<ElementAccumulator, InnerProductOp>(
+    problem_size.K,
+    problem_size.R * problem_size.S * problem_size.C,
+    problem_size.N * problem_size.P * problem_size.Q,
+    detail::FactoredOperand<
+      detail::Conv2dWgradOutputGradientDecoder<ElementAccumulator, ElementA, LayoutA>>{
+        {tensor_dy, problem_size}},
+    detail::MaskedOperand<
+      detail::Conv2dWgradActivationDecoder<ElementAccumulator, ElementB, LayoutB>>{
+        {tensor_x, problem_size}},
+    [&](int k, int col, ElementAccumulator const &acc) {
+
+      int c = col % problem_size.C;
+      int rs = col / problem_size.C;
+      int s = rs % problem_size.S;
+      int r = rs / problem_size.S;
+
+      // Apply Epilogue, compute ElementCompute, convert and store ElementC
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_dw_in.at(cutlass::make_Coord(k, r, s, c));
+      }
 
-        } // for (C)
-      } // for (S)
-    } // for (R)
-  } // for (K)
+      tensor_dw_out.at(cutlass::make_Coord(k, r, s, c)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    },
+    ElementAccumulator());
 }
 
 /// Generic 2D convolution targeting Conv2dFprop, Conv2dDgrad, and Conv2dWgrad.
@@ -468,64 +427,38 @@ void Conv3dFprop(
   ElementCompute beta) {
 
   ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-
-  // Apply MMA and accumulate ElementAccumulator
-  for (int n = 0; n < problem_size.N; ++n) {
-    for (int z = 0; z < problem_size.Z; ++z) {
-      for (int p = 0; p < problem_size.P; ++p) {
-        for (int q = 0; q < problem_size.Q; ++q) {
-          for (int k = 0; k < problem_size.K; ++k) {
-
-            ElementAccumulator acc = ElementAccumulator();
-
-            for (int t = 0; t < problem_size.T; ++t) {
-              for (int r = 0; r < problem_size.R; ++r) {
-                for (int s = 0; s < problem_size.S; ++s) {
-                  for (int c = 0; c < problem_size.C; ++c) {
-
-                    int filter_t = t;
-                    int filter_r = r;
-                    int filter_s = s;
-
-                    if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
-                      filter_t = problem_size.T - 1 - t;
-                      filter_r = problem_size.R - 1 - r;
-                      filter_s = problem_size.S - 1 - s;
-                    }
-
-                    int d = z * problem_size.stride_d - problem_size.pad_d + filter_t * problem_size.dilation_d;
-                    int h = p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h;
-                    int w = q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w;
-
-                    if (d >= 0 && d < problem_size.D && 
-                      h >=0 && h < problem_size.H && 
-                      w >= 0 && w < problem_size.W) {
-
-                      ElementA a = tensor_x.at({n, d, h, w, c});
-                      ElementB b = tensor_w.at({k, t, r, s, c});
-                      
-                      acc = inner_product_op(ElementAccumulator(a), ElementAccumulator(b), acc);
-                    }
-                  }
-                }
-              }
-            }
 
-            // Apply Epilogue, compute ElementCompute, convert and store ElementC
-            ElementC c_ref = ElementC();
-
-            if (beta != ElementCompute()) {
-              c_ref = tensor_y_in.at(cutlass::make_Coord(n, z, p, q, k));
-            }
-
-            tensor_y_out.at(cutlass::make_Coord(n, z, p, q, k)) =
-                convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
-          }
-        }
+  // Implicit GEMM: M = N*Z*P*Q, N = K, K = T*R*S*C
+  detail::gemm_engine<ElementAccumulator, InnerProductOp>(
+    problem_size.N * problem_size.Z * problem_size.P * problem_size.Q,
+    problem_size.K,
+    problem_size.T * problem_size.R * problem_size.S * problem_size.C,
+    detail::MaskedOperand<
+      detail::Conv3dFpropActivationDecoder<ElementAccumulator, ElementA, LayoutA>>{
+        {tensor_x, problem_size}},
+    detail::FactoredOperand<
+      detail::Conv3dFilterDecoder<ElementAccumulator, ElementB, LayoutB, false>>{
+        {tensor_w, problem_size, nullptr}},
+    [&](int row, int k, ElementAccumulator const &acc) {
+
+      int q = row % problem_size.Q;
+      int nzp = row / problem_size.Q;
+      int p = nzp % problem_size.P;
+      int nz = nzp / problem_size.P;
+      int z = nz % problem_size.Z;
+      int n = nz / problem_size.Z;
+
+      // Apply Epilogue, compute ElementCompute, convert and store ElementC
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_y_in.at(cutlass::make_Coord(n, z, p, q, k));
       }
-    }
-  }
+
+      tensor_y_out.at(cutlass::make_Coord(n, z, p, q, k)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    },
+    ElementAccumulator());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -555,57 +488,29 @@ void Conv3dDgrad(
   ElementCompute beta) {
 
   ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-
-  // Apply MMA and accumulate ElementAccumulator
-  for (int n = 0; n < problem_size.N; ++n) {
-    for (int d = 0; d < problem_size.D; ++d) {
-      for (int h = 0; h < problem_size.H; ++h) {
-        for (int w = 0; w < problem_size.W; ++w) {
-          for (int c = 0; c < problem_size.C; ++c) {
-
-            ElementAccumulator acc = ElementAccumulator();
-
-            for (int t = 0; t < problem_size.T; ++t) {
-              for (int r = 0; r < problem_size.R; ++r) {
-                for (int s = 0; s < problem_size.S; ++s) {
-                  for (int k = 0; k < problem_size.K; ++k) {
-
-                    int filter_t = t;
-                    int filter_r = r;
-                    int filter_s = s;
-
-                    if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
-                      filter_t = problem_size.T - 1 - t;
-                      filter_r = problem_size.R - 1 - r;
-                      filter_s = problem_size.S - 1 - s;
-                    }
-
-                    int z = d + problem_size.pad_d - filter_t * problem_size.dilation_d;
-                    int p = h + problem_size.pad_h - filter_r * problem_size.dilation_h;
-                    int q = w + problem_size.pad_w - filter_s * problem_size.dilation_w;
-
-                    if (z >= 0 && (z % problem_size.stride_d) == 0 &&
-                        p >= 0 && (p % problem_size.stride_h) == 0 && 
-                        q >= 0 && (q % problem_size.stride_w) == 0) {
-
-                      z = z / problem_size.stride_d;
-                      p = p / problem_size.stride_h;
-                      q = q / problem_size.stride_w;
-                      
-                      if (z < problem_size.Z && p < problem_size.P && q < problem_size.Q) {
-
-                        ElementA a = tensor_dy.at(cutlass::make_Coord(n, z, p, q, k));
-                        ElementB b = tensor_w.at(cutlass::make_Coord(k, t, r, s, c));
-
-                        acc = inner_product_op(ElementAccumulator(a), ElementAccumulator(b), acc);
-                      }
-                    }
-
-                  } // for (K)
-                } // for (S)
-              } // for (R)
-            } // for (T)
+
+  // Implicit GEMM for each phase of the stride: M = N*D*H*W, N = C, K = T*R*S*K, where D, H, W
+  // and T*R*S count the input positions of the phase and the filter positions reaching them
+  for (int phase_d = 0; phase_d < problem_size.stride_d; ++phase_d) {
+    for (int phase_h = 0; phase_h < problem_size.stride_h; ++phase_h) {
+      for (int phase_w = 0; phase_w < problem_size.stride_w; ++phase_w) {
+
+        detail::Conv3dDgradPhase phase(problem_size, phase_d, phase_h, phase_w);
+
+        detail::gemm_engine<ElementAccumulator, InnerProductOp>(
+          problem_size.N * phase.D * phase.H * phase.W,
+          problem_size.C,
+          int(phase.taps.size()) * problem_size.K,
+          detail::MaskedOperand<
+            detail::Conv3dDgradOutputGradientDecoder<ElementAccumulator, ElementA, LayoutA>>{
+              {tensor_dy, problem_size, &phase}},
+          detail::FactoredOperand<
+            detail::Conv3dFilterDecoder<ElementAccumulator, ElementB, LayoutB, true>>{
+              {tensor_w, problem_size, &phase}},
+          [&](int row, int c, ElementAccumulator const &acc) {
+
+            int n, d, h, w;
+            phase.input_position(row, n, d, h, w);
 
             // Apply Epilogue, compute ElementCompute, convert and store ElementC
             ElementC c_ref = ElementC();
@@ -616,12 +521,11 @@ void Conv3dDgrad(
 
             tensor_dx_out.at(cutlass::make_Coord(n, d, h, w, c)) =
                 convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
-
-          } // for (C)
-        } // for (W)
-      } // for (H)
-    } // for (D)
-  } // for (N)
+          },
+          ElementAccumulator());
+      }
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -649,70 +553,40 @@ void Conv3dWgrad(
   TensorRef<ElementC, LayoutC> tensor_dw_out,
   ElementCompute alpha,
   ElementCompute beta) {
-  
-  InnerProductOp inner_product_op;
-  ConvertOp convert_op;
-
-  // Apply MMA and accumulate ElementAccumulator
-  for (int k = 0; k < problem_size.K; ++k) {
-    for (int t = 0; t < problem_size.T; ++t) {
-      for (int r = 0; r < problem_size.R; ++r) {
-        for (int s = 0; s < problem_size.S; ++s) {
-          for (int c = 0; c < problem_size.C; ++c) {
-
-            ElementAccumulator acc = ElementAccumulator();
-
-            for (int n = 0; n < problem_size.N; ++n) {
-              for (int z = 0; z < problem_size.Z; ++z) {
-                for (int p = 0; p < problem_size.P; ++p) {
-                  for (int q = 0; q < problem_size.Q; ++q) {
-                      
-                    int filter_t = t;     
-                    int filter_r = r;
-                    int filter_s = s; 
-
-                    if (problem_size.mode == cutlass::conv::Mode::kConvolution) {
-                      filter_t = problem_size.T - 1 - t;
-                      filter_r = problem_size.R - 1 - r;
-                      filter_s = problem_size.S - 1 - s;
-                    }
-
-                    Tensor5DCoord b_coord = make_Coord(
-                        n,
-                        z * problem_size.stride_d - problem_size.pad_d + filter_t * problem_size.dilation_d,
-                        p * problem_size.stride_h - problem_size.pad_h + filter_r * problem_size.dilation_h,
-                        q * problem_size.stride_w - problem_size.pad_w + filter_s * problem_size.dilation_w,
-                        c);
-
-                    if (b_coord.d() < problem_size.D && b_coord.d() >= 0 &&
-                        b_coord.h() < problem_size.H && b_coord.h() >= 0 &&
-                        b_coord.w() < problem_size.W && b_coord.w() >= 0) {
-
-                      ElementAccumulator a = ElementAccumulator(tensor_dy.at(cutlass::make_Coord(n, z, p, q, k)));
-                      ElementAccumulator b = ElementAccumulator(tensor_x.at(b_coord));
-
-                      acc = inner_product_op(a, b, acc);
-                    }
-                  }
-                }
-              }
-            }
 
-            // Apply Epilogue, compute ElementCompute, convert and store ElementC
-            ElementC c_ref = ElementC();
-
-            if (beta != ElementCompute()) {
-              c_ref = tensor_dw_in.at(cutlass::make_Coord(k, t, r, s, c));
-            }
+  ConvertOp convert_op;
 
-            tensor_dw_out.at(cutlass::make_Coord(k, t, r, s, c)) =
-                convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+  // Implicit GEMM: M = K, N = T*R*S*C, K = N*Z*P*Q
+  detail::gemm_engine<ElementAccumulator, InnerProductOp>(
+    problem_size.K,
+    problem_size.T * problem_size.R * problem_size.S * problem_size.C,
+    problem_size.N * problem_size.Z * problem_size.P * problem_size.Q,
+    detail::FactoredOperand<
+      detail::Conv3dWgradOutputGradientDecoder<ElementAccumulator, ElementA, LayoutA>>{
+        {tensor_dy, problem_size}},
+    detail::MaskedOperand<
+      detail::Conv3dWgradActivationDecoder<ElementAccumulator, ElementB, LayoutB>>{
+        {tensor_x, problem_size}},
+    [&](int k, int col, ElementAccumulator const &acc) {
+
+      int c = col % problem_size.C;
+      int trs = col / problem_size.C;
+      int s = trs % problem_size.S;
+      int tr = trs / problem_size.S;
+      int r = tr % problem_size.R;
+      int t = tr / problem_size.R;
+
+      // Apply Epilogue, compute ElementCompute, convert and store ElementC
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_dw_in.at(cutlass::make_Coord(k, t, r, s, c));
+      }
 
-          } // for (C)
-        } // for (S)
-      } // for (R)
-    } // for (T)
-  } // for (K)
+      tensor_dw_out.at(cutlass::make_Coord(k, t, r, s, c)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    },
+    ElementAccumulator());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
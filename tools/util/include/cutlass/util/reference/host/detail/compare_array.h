@@ -0,0 +1,242 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Search for the first mismatching element of two contiguous arrays in host-side code.
+
+    Mismatches are defined by operator!= of the element type, so NaN values never compare equal
+    and positive and negative zero compare equal. Integer arrays are compared bytewise.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/reference/host/detail/cpu_features.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if CUTLASS_HOST_SIMD_X86
+
+/// Skips equal float elements 32 at a time. Returns the index of a block of 32 elements containing
+/// the first mismatch, or of the remaining elements.
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t find_mismatch_f32_avx2(float const *a, float const *b, int64_t count) {
+  int64_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256 ne = _mm256_setzero_ps();
+    for (int v = 0; v < 4; ++v) {
+      __m256 x = _mm256_loadu_ps(a + i + v * 8);
+      __m256 y = _mm256_loadu_ps(b + i + v * 8);
+      ne = _mm256_or_ps(ne, _mm256_cmp_ps(x, y, _CMP_NEQ_UQ));
+    }
+    if (_mm256_movemask_ps(ne)) {
+      break;
+    }
+  }
+  return i;
+}
+
+/// Skips equal double elements 16 at a time
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t find_mismatch_f64_avx2(double const *a, double const *b, int64_t count) {
+  int64_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256d ne = _mm256_setzero_pd();
+    for (int v = 0; v < 4; ++v) {
+      __m256d x = _mm256_loadu_pd(a + i + v * 4);
+      __m256d y = _mm256_loadu_pd(b + i + v * 4);
+      ne = _mm256_or_pd(ne, _mm256_cmp_pd(x, y, _CMP_NEQ_UQ));
+    }
+    if (_mm256_movemask_pd(ne)) {
+      break;
+    }
+  }
+  return i;
+}
+
+/// Skips equal half_t elements 16 at a time, comparing their values widened to float
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t find_mismatch_f16_avx2(half_t const *a, half_t const *b, int64_t count) {
+  int64_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256 ne = _mm256_setzero_ps();
+    for (int v = 0; v < 2; ++v) {
+      __m256 x = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const *>(a + i + v * 8)));
+      __m256 y = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const *>(b + i + v * 8)));
+      ne = _mm256_or_ps(ne, _mm256_cmp_ps(x, y, _CMP_NEQ_UQ));
+    }
+    if (_mm256_movemask_ps(ne)) {
+      break;
+    }
+  }
+  return i;
+}
+
+/// Skips equal bfloat16_t elements 16 at a time, comparing their values widened to float
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t find_mismatch_bf16_avx2(bfloat16_t const *a, bfloat16_t const *b, int64_t count) {
+  int64_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256 ne = _mm256_setzero_ps();
+    for (int v = 0; v < 2; ++v) {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a + i + v * 8));
+      __m128i y = _mm_loadu_si128(reinterpret_cast<__m128i const *>(b + i + v * 8));
+      __m256 xf = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(x), 16));
+      __m256 yf = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(y), 16));
+      ne = _mm256_or_ps(ne, _mm256_cmp_ps(xf, yf, _CMP_NEQ_UQ));
+    }
+    if (_mm256_movemask_ps(ne)) {
+      break;
+    }
+  }
+  return i;
+}
+
+/// Skips equal bytes 128 at a time
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t find_mismatch_bytes_avx2(uint8_t const *a, uint8_t const *b, int64_t bytes) {
+  int64_t i = 0;
+  for (; i + 128 <= bytes; i += 128) {
+    __m256i eq = _mm256_set1_epi8(-1);
+    for (int v = 0; v < 4; ++v) {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + i + v * 32));
+      __m256i y = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + i + v * 32));
+      eq = _mm256_and_si256(eq, _mm256_cmpeq_epi8(x, y));
+    }
+    if (_mm256_movemask_epi8(eq) != -1) {
+      break;
+    }
+  }
+  return i;
+}
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the index of the first element of [begin, count) at which 'a' and 'b' differ, or 'count'
+template <typename Element>
+int64_t find_mismatch_scalar(Element const *a, Element const *b, int64_t begin, int64_t count) {
+  for (int64_t i = begin; i < count; ++i) {
+    if (a[i] != b[i]) {
+      return i;
+    }
+  }
+  return count;
+}
+
+/// Compares elements with operator!=
+template <typename Element>
+int64_t find_mismatch(Element const *a, Element const *b, int64_t count, std::false_type) {
+  return find_mismatch_scalar(a, b, 0, count);
+}
+
+/// Compares integers bytewise
+template <typename Element>
+int64_t find_mismatch(Element const *a, Element const *b, int64_t count, std::true_type) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = find_mismatch_bytes_avx2(
+      reinterpret_cast<uint8_t const *>(a),
+      reinterpret_cast<uint8_t const *>(b),
+      count * int64_t(sizeof(Element))) / int64_t(sizeof(Element));
+  }
+#endif
+  return find_mismatch_scalar(a, b, i, count);
+}
+
+/// Returns the index of the first element at which 'a' and 'b' differ, or 'count' if the arrays
+/// are equal
+template <typename Element>
+int64_t find_mismatch(Element const *a, Element const *b, int64_t count) {
+  return find_mismatch(a, b, count, std::integral_constant<bool, std::is_integral<Element>::value>());
+}
+
+/// Compares float elements
+inline int64_t find_mismatch(float const *a, float const *b, int64_t count) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = find_mismatch_f32_avx2(a, b, count);
+  }
+#endif
+  return find_mismatch_scalar(a, b, i, count);
+}
+
+/// Compares double elements
+inline int64_t find_mismatch(double const *a, double const *b, int64_t count) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = find_mismatch_f64_avx2(a, b, count);
+  }
+#endif
+  return find_mismatch_scalar(a, b, i, count);
+}
+
+/// Compares half_t elements
+inline int64_t find_mismatch(half_t const *a, half_t const *b, int64_t count) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = find_mismatch_f16_avx2(a, b, count);
+  }
+#endif
+  return find_mismatch_scalar(a, b, i, count);
+}
+
+/// Compares bfloat16_t elements
+inline int64_t find_mismatch(bfloat16_t const *a, bfloat16_t const *b, int64_t count) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = find_mismatch_bf16_avx2(a, b, count);
+  }
+#endif
+  return find_mismatch_scalar(a, b, i, count);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
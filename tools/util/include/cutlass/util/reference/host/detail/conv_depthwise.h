@@ -0,0 +1,226 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Direct depthwise convolution in host-side code.
+
+    Each channel of a depthwise convolution is filtered independently, so the channels of an NHWC
+    activation are processed as contiguous vectors. Output rows (n, p) are distributed across the
+    host threads. Each input row contributing to an output row is converted to the accumulator
+    type once, and the filter taps are applied to whole channel vectors with the vector kernel of
+    the host GEMM engine.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "cutlass/coord.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/tensor_ref.h"
+#include "cutlass/conv/convolution.h"
+#include "cutlass/conv/conv2d_problem_size.h"
+#include "cutlass/util/reference/host/detail/convert_array.h"
+#include "cutlass/util/reference/host/detail/gemm_engine.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Converts the first 'count' channels of an input pixel to the accumulator type
+template <typename ElementAccumulator, typename Element, typename Layout>
+void conv_depthwise_load_pixel(
+  ElementAccumulator *dst,
+  TensorRef<Element, Layout> ref,
+  int n,
+  int h,
+  int w,
+  int count) {
+
+  for (int c = 0; c < count; ++c) {
+    Element a = ref.at(make_Coord(n, h, w, c));
+    dst[c] = ElementAccumulator(a);
+  }
+}
+
+/// Activations in the NHWC layout hold the channels of a pixel contiguously
+template <typename ElementAccumulator, typename Element>
+void conv_depthwise_load_pixel(
+  ElementAccumulator *dst,
+  TensorRef<Element, layout::TensorNHWC> ref,
+  int n,
+  int h,
+  int w,
+  int count) {
+
+  if (sizeof_bits<Element>::value < 8) {
+    for (int c = 0; c < count; ++c) {
+      Element a = ref.at(make_Coord(n, h, w, c));
+      dst[c] = ElementAccumulator(a);
+    }
+    return;
+  }
+
+  convert_array(
+    dst,
+    ref.data() + ref.layout()(make_Coord(n, h, w, 0)),
+    count,
+    [](Element const &a) { return ElementAccumulator(a); });
+}
+
+/// Computes a depthwise convolution forward propagation, in which output channel c is the
+/// convolution of input channel c with filter c.
+///
+///   load_filter(c, r, s) -> ElementAccumulator
+///   epilogue(n, p, q, ElementAccumulator const *accum)   with accum[c] for c in [0, C)
+///
+/// Filter taps are applied in the order of (r, s). In convolution mode, the filter is flipped if
+/// 'flip_filter' is true and the activation window is flipped otherwise.
+template <
+  typename ElementAccumulator,
+  typename InnerProductOp,
+  typename ElementA,
+  typename LayoutA,
+  typename LoadFilter,
+  typename Epilogue
+>
+void conv2d_depthwise_fprop(
+  conv::Conv2dProblemSize const &problem_size,
+  TensorRef<ElementA, LayoutA> tensor_x,
+  LoadFilter const &load_filter,
+  bool flip_filter,
+  Epilogue const &epilogue) {
+
+  using Microkernel = GemmMicrokernel<ElementAccumulator, InnerProductOp>;
+
+  int const C = problem_size.C;
+  int const R = problem_size.R;
+  int const S = problem_size.S;
+  int const P = problem_size.P;
+  int const Q = problem_size.Q;
+  int const W = problem_size.W;
+
+  if (problem_size.N <= 0 || P <= 0 || Q <= 0 || C <= 0) {
+    return;
+  }
+
+  int const alignment = Microkernel::kRowAlignment;
+  int const ldc = (C + alignment - 1) / alignment * alignment;
+
+  bool const convolution = (problem_size.mode == conv::Mode::kConvolution);
+
+  // Filter and activation positions of each tap (r, s)
+  std::vector<int> tap_h(R), tap_w(S);
+
+  for (int r = 0; r < R; ++r) {
+    tap_h[r] = ((convolution && !flip_filter) ? R - 1 - r : r) * problem_size.dilation_h;
+  }
+  for (int s = 0; s < S; ++s) {
+    tap_w[s] = ((convolution && !flip_filter) ? S - 1 - s : s) * problem_size.dilation_w;
+  }
+
+  // Filters are converted once and stored with the channels of each tap contiguous
+  std::vector<ElementAccumulator> filter(size_t(R) * S * ldc, ElementAccumulator());
+
+  for (int r = 0; r < R; ++r) {
+    for (int s = 0; s < S; ++s) {
+      int filter_r = (convolution && flip_filter) ? R - 1 - r : r;
+      int filter_s = (convolution && flip_filter) ? S - 1 - s : s;
+      ElementAccumulator *dst = filter.data() + size_t(r * S + s) * ldc;
+      for (int c = 0; c < C; ++c) {
+        dst[c] = load_filter(c, filter_r, filter_s);
+      }
+    }
+  }
+
+  typename Microkernel::VectorFunction vector_function = Microkernel::get().vector_function;
+
+  parallel_for_range(int64_t(problem_size.N) * P, 1, [&](int64_t row_begin, int64_t row_end) {
+
+    std::vector<ElementAccumulator> accum(size_t(Q) * ldc);
+    std::vector<ElementAccumulator> input(size_t(W) * ldc, ElementAccumulator());
+
+    for (int64_t row = row_begin; row < row_end; ++row) {
+
+      int n = int(row / P);
+      int p = int(row % P);
+
+      std::fill(accum.begin(), accum.end(), ElementAccumulator());
+
+      for (int r = 0; r < R; ++r) {
+
+        int h = p * problem_size.stride_h - problem_size.pad_h + tap_h[r];
+
+        if (h < 0 || h >= problem_size.H) {
+          continue;
+        }
+
+        for (int w = 0; w < W; ++w) {
+          conv_depthwise_load_pixel(input.data() + size_t(w) * ldc, tensor_x, n, h, w, C);
+        }
+
+        for (int s = 0; s < S; ++s) {
+
+          ElementAccumulator const *weights = filter.data() + size_t(r * S + s) * ldc;
+
+          for (int q = 0; q < Q; ++q) {
+
+            int w = q * problem_size.stride_w - problem_size.pad_w + tap_w[s];
+
+            if (w >= 0 && w < W) {
+              vector_function(
+                ldc,
+                input.data() + size_t(w) * ldc,
+                weights,
+                accum.data() + size_t(q) * ldc);
+            }
+          }
+        }
+      }
+
+      for (int q = 0; q < Q; ++q) {
+        epilogue(n, p, q, accum.data() + size_t(q) * ldc);
+      }
+    }
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,736 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Operand decoders mapping host reference convolutions onto the host GEMM engine.
+
+    Each convolution is computed as the implicit GEMM described by
+    conv::implicit_gemm_problem_size(). The decoders gather the activation, output gradient and
+    filter tensors into packed panels while the engine performs the tiled, multithreaded GEMM.
+    Terms whose activation or output gradient lies outside its tensor are omitted from the
+    reduction, as the direct loop nest skips them.
+
+      Fprop: M = N*P*Q, N = K, K = R*S*C    A = gather(x),  B = w
+      Dgrad: M = N*H*W, N = C, K = R*S*K    A = gather(dy), B = w
+      Wgrad: M = K,     N = R*S*C, K = N*P*Q  A = dy,       B = gather(x)
+
+    Strided Dgrad is partitioned into one GEMM per phase of the stride. The input positions of a
+    phase are reached only by a subset of the filter positions, and the reduction of its GEMM
+    enumerates just those.
+
+    3-D convolutions extend each of these products with the depth dimensions D, Z and T.
+
+    The reduction index enumerates filter positions and channels in the same order as a direct
+    loop nest, so every output accumulates its terms in the same sequence.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "cutlass/coord.h"
+#include "cutlass/tensor_ref.h"
+#include "cutlass/conv/convolution.h"
+#include "cutlass/conv/conv2d_problem_size.h"
+#include "cutlass/conv/conv3d_problem_size.h"
+#include "cutlass/util/reference/host/detail/gemm_engine.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Filter position (r, s) accounting for the convolution mode
+inline void conv2d_filter_position(
+  conv::Conv2dProblemSize const &problem_size,
+  int r,
+  int s,
+  int &filter_r,
+  int &filter_s) {
+
+  filter_r = r;
+  filter_s = s;
+
+  if (problem_size.mode == conv::Mode::kConvolution) {
+    filter_r = problem_size.R - 1 - r;
+    filter_s = problem_size.S - 1 - s;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Fprop operand A: activations gathered for output positions (n, p, q) and reduction (r, s, c)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv2dFpropActivationDecoder {
+
+  struct IndexCoord {
+    int n, h, w;
+  };
+
+  struct ReductionCoord {
+    int h, w, c;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv2dProblemSize problem_size;
+  int channels_per_group;
+  int channel_offset;
+
+  IndexCoord index(int idx) const {
+    int q = idx % problem_size.Q;
+    int npq = idx / problem_size.Q;
+    int p = npq % problem_size.P;
+    int n = npq / problem_size.P;
+
+    return IndexCoord{
+      n,
+      p * problem_size.stride_h - problem_size.pad_h,
+      q * problem_size.stride_w - problem_size.pad_w};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int c = k % channels_per_group;
+    int rs = k / channels_per_group;
+    int filter_r, filter_s;
+    conv2d_filter_position(problem_size, rs / problem_size.S, rs % problem_size.S, filter_r, filter_s);
+
+    return ReductionCoord{
+      filter_r * problem_size.dilation_h,
+      filter_s * problem_size.dilation_w,
+      c + channel_offset};
+  }
+
+  /// Filter taps falling into the padding are omitted
+  bool contains(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int h = index.h + reduction.h;
+    int w = index.w + reduction.w;
+
+    return h >= 0 && h < problem_size.H && w >= 0 && w < problem_size.W;
+  }
+
+  ElementAccumulator load(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element a = ref.at(make_Coord(index.n, index.h + reduction.h, index.w + reduction.w, reduction.c));
+    return ElementAccumulator(a);
+  }
+};
+
+/// Fprop operand B: filter for output channel k and reduction (r, s, c)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv2dFpropFilterDecoder {
+
+  struct IndexCoord {
+    int k;
+  };
+
+  struct ReductionCoord {
+    int r, s, c;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv2dProblemSize problem_size;
+  int channels_per_group;
+  int filter_offset;
+
+  IndexCoord index(int idx) const {
+    return IndexCoord{idx + filter_offset};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int rs = k / channels_per_group;
+    return ReductionCoord{rs / problem_size.S, rs % problem_size.S, k % channels_per_group};
+  }
+
+  ElementAccumulator operator()(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element b = ref.at(make_Coord(index.k, reduction.r, reduction.s, reduction.c));
+    return ElementAccumulator(b);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Input positions and filter positions of one phase of a strided Dgrad. The input positions of
+/// phase (phase_h, phase_w) satisfy (h + pad_h) % stride_h == phase_h and
+/// (w + pad_w) % stride_w == phase_w. They map onto output positions through exactly the filter
+/// positions with (filter_r * dilation_h) % stride_h == phase_h and
+/// (filter_s * dilation_w) % stride_w == phase_w.
+struct Conv2dDgradPhase {
+
+  int h_begin;
+  int w_begin;
+  int stride_h;
+  int stride_w;
+
+  /// Extent of the phase along h and w
+  int H;
+  int W;
+
+  /// Linear filter positions r * S + s reaching the phase, in increasing order
+  std::vector<int> taps;
+
+  Conv2dDgradPhase(conv::Conv2dProblemSize const &problem_size, int phase_h, int phase_w):
+    stride_h(problem_size.stride_h), stride_w(problem_size.stride_w) {
+
+    h_begin = ((phase_h - problem_size.pad_h) % stride_h + stride_h) % stride_h;
+    w_begin = ((phase_w - problem_size.pad_w) % stride_w + stride_w) % stride_w;
+
+    H = (h_begin < problem_size.H ? (problem_size.H - h_begin + stride_h - 1) / stride_h : 0);
+    W = (w_begin < problem_size.W ? (problem_size.W - w_begin + stride_w - 1) / stride_w : 0);
+
+    for (int r = 0; r < problem_size.R; ++r) {
+      for (int s = 0; s < problem_size.S; ++s) {
+        int filter_r, filter_s;
+        conv2d_filter_position(problem_size, r, s, filter_r, filter_s);
+
+        if ((filter_r * problem_size.dilation_h) % stride_h == phase_h &&
+            (filter_s * problem_size.dilation_w) % stride_w == phase_w) {
+          taps.push_back(r * problem_size.S + s);
+        }
+      }
+    }
+  }
+
+  /// Input position of a row of the phase's implicit GEMM
+  void input_position(int idx, int &n, int &h, int &w) const {
+    int w_idx = idx % W;
+    int nh = idx / W;
+    h = h_begin + (nh % H) * stride_h;
+    w = w_begin + w_idx * stride_w;
+    n = nh / H;
+  }
+};
+
+/// Dgrad operand A: output gradient gathered for input positions (n, h, w) of a phase and
+/// reduction (r, s, k) over the filter positions reaching the phase
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv2dDgradOutputGradientDecoder {
+
+  struct IndexCoord {
+    int n, h, w;
+  };
+
+  struct ReductionCoord {
+    int h, w, k;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv2dProblemSize problem_size;
+  Conv2dDgradPhase const *phase;
+
+  IndexCoord index(int idx) const {
+    int n, h, w;
+    phase->input_position(idx, n, h, w);
+
+    return IndexCoord{n, h + problem_size.pad_h, w + problem_size.pad_w};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int rs = phase->taps[k / problem_size.K];
+    int filter_r, filter_s;
+    conv2d_filter_position(problem_size, rs / problem_size.S, rs % problem_size.S, filter_r, filter_s);
+
+    return ReductionCoord{
+      filter_r * problem_size.dilation_h,
+      filter_s * problem_size.dilation_w,
+      k % problem_size.K};
+  }
+
+  /// Filter taps reaching output positions outside the output gradient are omitted
+  bool contains(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int p = index.h - reduction.h;
+    int q = index.w - reduction.w;
+
+    return p >= 0 && (p % problem_size.stride_h) == 0 && p / problem_size.stride_h < problem_size.P &&
+           q >= 0 && (q % problem_size.stride_w) == 0 && q / problem_size.stride_w < problem_size.Q;
+  }
+
+  ElementAccumulator load(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int p = (index.h - reduction.h) / problem_size.stride_h;
+    int q = (index.w - reduction.w) / problem_size.stride_w;
+
+    Element a = ref.at(make_Coord(index.n, p, q, reduction.k));
+    return ElementAccumulator(a);
+  }
+};
+
+/// Dgrad operand B: filter for input channel c and reduction (r, s, k) over the filter positions
+/// reaching a phase
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv2dDgradFilterDecoder {
+
+  struct IndexCoord {
+    int c;
+  };
+
+  struct ReductionCoord {
+    int r, s, k;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv2dProblemSize problem_size;
+  Conv2dDgradPhase const *phase;
+
+  IndexCoord index(int idx) const {
+    return IndexCoord{idx};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int rs = phase->taps[k / problem_size.K];
+    return ReductionCoord{rs / problem_size.S, rs % problem_size.S, k % problem_size.K};
+  }
+
+  ElementAccumulator operator()(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element b = ref.at(make_Coord(reduction.k, reduction.r, reduction.s, index.c));
+    return ElementAccumulator(b);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Wgrad operand A: output gradient for output channel k and reduction (n, p, q)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv2dWgradOutputGradientDecoder {
+
+  struct IndexCoord {
+    int k;
+  };
+
+  struct ReductionCoord {
+    int n, p, q;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv2dProblemSize problem_size;
+
+  IndexCoord index(int idx) const {
+    return IndexCoord{idx};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int q = k % problem_size.Q;
+    int np = k / problem_size.Q;
+    return ReductionCoord{np / problem_size.P, np % problem_size.P, q};
+  }
+
+  ElementAccumulator operator()(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element a = ref.at(make_Coord(reduction.n, reduction.p, reduction.q, index.k));
+    return ElementAccumulator(a);
+  }
+};
+
+/// Wgrad operand B: activations gathered for filter positions (r, s, c) and reduction (n, p, q)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv2dWgradActivationDecoder {
+
+  struct IndexCoord {
+    int h, w, c;
+  };
+
+  struct ReductionCoord {
+    int n, h, w;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv2dProblemSize problem_size;
+
+  IndexCoord index(int idx) const {
+    int c = idx % problem_size.C;
+    int rs = idx / problem_size.C;
+    int filter_r, filter_s;
+    conv2d_filter_position(problem_size, rs / problem_size.S, rs % problem_size.S, filter_r, filter_s);
+
+    return IndexCoord{
+      filter_r * problem_size.dilation_h - problem_size.pad_h,
+      filter_s * problem_size.dilation_w - problem_size.pad_w,
+      c};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int q = k % problem_size.Q;
+    int np = k / problem_size.Q;
+
+    return ReductionCoord{
+      np / problem_size.P,
+      (np % problem_size.P) * problem_size.stride_h,
+      q * problem_size.stride_w};
+  }
+
+  /// Output positions whose filter tap falls into the padding are omitted
+  bool contains(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int h = reduction.h + index.h;
+    int w = reduction.w + index.w;
+
+    return h >= 0 && h < problem_size.H && w >= 0 && w < problem_size.W;
+  }
+
+  ElementAccumulator load(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element b = ref.at(make_Coord(reduction.n, reduction.h + index.h, reduction.w + index.w, index.c));
+    return ElementAccumulator(b);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// 3D convolution
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Filter position (t, r, s) of a linear filter index accounting for the convolution mode
+inline void conv3d_filter_position(
+  conv::Conv3dProblemSize const &problem_size,
+  int trs,
+  int &filter_t,
+  int &filter_r,
+  int &filter_s) {
+
+  filter_s = trs % problem_size.S;
+  filter_r = (trs / problem_size.S) % problem_size.R;
+  filter_t = trs / (problem_size.S * problem_size.R);
+
+  if (problem_size.mode == conv::Mode::kConvolution) {
+    filter_t = problem_size.T - 1 - filter_t;
+    filter_r = problem_size.R - 1 - filter_r;
+    filter_s = problem_size.S - 1 - filter_s;
+  }
+}
+
+/// Input positions and filter positions of one phase of a strided Dgrad, as Conv2dDgradPhase
+/// with the additional depth dimension
+struct Conv3dDgradPhase {
+
+  int d_begin;
+  int h_begin;
+  int w_begin;
+  int stride_d;
+  int stride_h;
+  int stride_w;
+
+  /// Extent of the phase along d, h and w
+  int D;
+  int H;
+  int W;
+
+  /// Linear filter positions (t * R + r) * S + s reaching the phase, in increasing order
+  std::vector<int> taps;
+
+  Conv3dDgradPhase(conv::Conv3dProblemSize const &problem_size, int phase_d, int phase_h, int phase_w):
+    stride_d(problem_size.stride_d), stride_h(problem_size.stride_h), stride_w(problem_size.stride_w) {
+
+    d_begin = ((phase_d - problem_size.pad_d) % stride_d + stride_d) % stride_d;
+    h_begin = ((phase_h - problem_size.pad_h) % stride_h + stride_h) % stride_h;
+    w_begin = ((phase_w - problem_size.pad_w) % stride_w + stride_w) % stride_w;
+
+    D = (d_begin < problem_size.D ? (problem_size.D - d_begin + stride_d - 1) / stride_d : 0);
+    H = (h_begin < problem_size.H ? (problem_size.H - h_begin + stride_h - 1) / stride_h : 0);
+    W = (w_begin < problem_size.W ? (problem_size.W - w_begin + stride_w - 1) / stride_w : 0);
+
+    for (int trs = 0; trs < problem_size.T * problem_size.R * problem_size.S; ++trs) {
+      int filter_t, filter_r, filter_s;
+      conv3d_filter_position(problem_size, trs, filter_t, filter_r, filter_s);
+
+      if ((filter_t * problem_size.dilation_d) % stride_d == phase_d &&
+          (filter_r * problem_size.dilation_h) % stride_h == phase_h &&
+          (filter_s * problem_size.dilation_w) % stride_w == phase_w) {
+        taps.push_back(trs);
+      }
+    }
+  }
+
+  /// Input position of a row of the phase's implicit GEMM
+  void input_position(int idx, int &n, int &d, int &h, int &w) const {
+    int w_idx = idx % W;
+    int ndh = idx / W;
+    int h_idx = ndh % H;
+    int nd = ndh / H;
+    d = d_begin + (nd % D) * stride_d;
+    h = h_begin + h_idx * stride_h;
+    w = w_begin + w_idx * stride_w;
+    n = nd / D;
+  }
+};
+
+/// Fprop operand A: activations gathered for output positions (n, z, p, q) and reduction
+/// (t, r, s, c)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv3dFpropActivationDecoder {
+
+  struct IndexCoord {
+    int n, d, h, w;
+  };
+
+  struct ReductionCoord {
+    int d, h, w, c;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv3dProblemSize problem_size;
+
+  IndexCoord index(int idx) const {
+    int q = idx % problem_size.Q;
+    int nzp = idx / problem_size.Q;
+    int p = nzp % problem_size.P;
+    int nz = nzp / problem_size.P;
+    int z = nz % problem_size.Z;
+    int n = nz / problem_size.Z;
+
+    return IndexCoord{
+      n,
+      z * problem_size.stride_d - problem_size.pad_d,
+      p * problem_size.stride_h - problem_size.pad_h,
+      q * problem_size.stride_w - problem_size.pad_w};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int filter_t, filter_r, filter_s;
+    conv3d_filter_position(problem_size, k / problem_size.C, filter_t, filter_r, filter_s);
+
+    return ReductionCoord{
+      filter_t * problem_size.dilation_d,
+      filter_r * problem_size.dilation_h,
+      filter_s * problem_size.dilation_w,
+      k % problem_size.C};
+  }
+
+  /// Filter taps falling into the padding are omitted
+  bool contains(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int d = index.d + reduction.d;
+    int h = index.h + reduction.h;
+    int w = index.w + reduction.w;
+
+    return d >= 0 && d < problem_size.D &&
+           h >= 0 && h < problem_size.H &&
+           w >= 0 && w < problem_size.W;
+  }
+
+  ElementAccumulator load(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element a = ref.at(make_Coord(
+      index.n, index.d + reduction.d, index.h + reduction.h, index.w + reduction.w, reduction.c));
+    return ElementAccumulator(a);
+  }
+};
+
+/// Fprop and Dgrad operand B: filter element (k, t, r, s, c). For Fprop the output index is k
+/// and the reduction enumerates (t, r, s, c); for Dgrad the output index is c and the reduction
+/// enumerates (t, r, s, k) over the filter positions reaching a phase.
+template <typename ElementAccumulator, typename Element, typename Layout, bool kDgrad>
+struct Conv3dFilterDecoder {
+
+  struct IndexCoord {
+    int idx;
+  };
+
+  struct ReductionCoord {
+    int t, r, s, idx;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv3dProblemSize problem_size;
+
+  /// Phase of a strided Dgrad; unused by Fprop
+  Conv3dDgradPhase const *phase;
+
+  IndexCoord index(int idx) const {
+    return IndexCoord{idx};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int channels = (kDgrad ? problem_size.K : problem_size.C);
+    int trs = (kDgrad ? phase->taps[k / channels] : k / channels);
+
+    return ReductionCoord{
+      trs / (problem_size.R * problem_size.S),
+      (trs / problem_size.S) % problem_size.R,
+      trs % problem_size.S,
+      k % channels};
+  }
+
+  ElementAccumulator operator()(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int k = (kDgrad ? reduction.idx : index.idx);
+    int c = (kDgrad ? index.idx : reduction.idx);
+
+    Element b = ref.at(make_Coord(k, reduction.t, reduction.r, reduction.s, c));
+    return ElementAccumulator(b);
+  }
+};
+
+/// Dgrad operand A: output gradient gathered for input positions (n, d, h, w) of a phase and
+/// reduction (t, r, s, k) over the filter positions reaching the phase
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv3dDgradOutputGradientDecoder {
+
+  struct IndexCoord {
+    int n, d, h, w;
+  };
+
+  struct ReductionCoord {
+    int d, h, w, k;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv3dProblemSize problem_size;
+  Conv3dDgradPhase const *phase;
+
+  IndexCoord index(int idx) const {
+    int n, d, h, w;
+    phase->input_position(idx, n, d, h, w);
+
+    return IndexCoord{n, d + problem_size.pad_d, h + problem_size.pad_h, w + problem_size.pad_w};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int filter_t, filter_r, filter_s;
+    conv3d_filter_position(problem_size, phase->taps[k / problem_size.K], filter_t, filter_r, filter_s);
+
+    return ReductionCoord{
+      filter_t * problem_size.dilation_d,
+      filter_r * problem_size.dilation_h,
+      filter_s * problem_size.dilation_w,
+      k % problem_size.K};
+  }
+
+  /// Filter taps reaching output positions outside the output gradient are omitted
+  bool contains(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int z = index.d - reduction.d;
+    int p = index.h - reduction.h;
+    int q = index.w - reduction.w;
+
+    return z >= 0 && (z % problem_size.stride_d) == 0 && z / problem_size.stride_d < problem_size.Z &&
+           p >= 0 && (p % problem_size.stride_h) == 0 && p / problem_size.stride_h < problem_size.P &&
+           q >= 0 && (q % problem_size.stride_w) == 0 && q / problem_size.stride_w < problem_size.Q;
+  }
+
+  ElementAccumulator load(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int z = (index.d - reduction.d) / problem_size.stride_d;
+    int p = (index.h - reduction.h) / problem_size.stride_h;
+    int q = (index.w - reduction.w) / problem_size.stride_w;
+
+    Element a = ref.at(make_Coord(index.n, z, p, q, reduction.k));
+    return ElementAccumulator(a);
+  }
+};
+
+/// Wgrad operand A: output gradient for output channel k and reduction (n, z, p, q)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv3dWgradOutputGradientDecoder {
+
+  struct IndexCoord {
+    int k;
+  };
+
+  struct ReductionCoord {
+    int n, z, p, q;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv3dProblemSize problem_size;
+
+  IndexCoord index(int idx) const {
+    return IndexCoord{idx};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int q = k % problem_size.Q;
+    int nzp = k / problem_size.Q;
+    int p = nzp % problem_size.P;
+    int nz = nzp / problem_size.P;
+    return ReductionCoord{nz / problem_size.Z, nz % problem_size.Z, p, q};
+  }
+
+  ElementAccumulator operator()(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element a = ref.at(make_Coord(reduction.n, reduction.z, reduction.p, reduction.q, index.k));
+    return ElementAccumulator(a);
+  }
+};
+
+/// Wgrad operand B: activations gathered for filter positions (t, r, s, c) and reduction
+/// (n, z, p, q)
+template <typename ElementAccumulator, typename Element, typename Layout>
+struct Conv3dWgradActivationDecoder {
+
+  struct IndexCoord {
+    int d, h, w, c;
+  };
+
+  struct ReductionCoord {
+    int n, d, h, w;
+  };
+
+  TensorRef<Element, Layout> ref;
+  conv::Conv3dProblemSize problem_size;
+
+  IndexCoord index(int idx) const {
+    int filter_t, filter_r, filter_s;
+    conv3d_filter_position(problem_size, idx / problem_size.C, filter_t, filter_r, filter_s);
+
+    return IndexCoord{
+      filter_t * problem_size.dilation_d - problem_size.pad_d,
+      filter_r * problem_size.dilation_h - problem_size.pad_h,
+      filter_s * problem_size.dilation_w - problem_size.pad_w,
+      idx % problem_size.C};
+  }
+
+  ReductionCoord reduction(int k) const {
+    int q = k % problem_size.Q;
+    int nzp = k / problem_size.Q;
+    int p = nzp % problem_size.P;
+    int nz = nzp / problem_size.P;
+
+    return ReductionCoord{
+      nz / problem_size.Z,
+      (nz % problem_size.Z) * problem_size.stride_d,
+      p * problem_size.stride_h,
+      q * problem_size.stride_w};
+  }
+
+  /// Output positions whose filter tap falls into the padding are omitted
+  bool contains(IndexCoord const &index, ReductionCoord const &reduction) const {
+    int d = reduction.d + index.d;
+    int h = reduction.h + index.h;
+    int w = reduction.w + index.w;
+
+    return d >= 0 && d < problem_size.D &&
+           h >= 0 && h < problem_size.H &&
+           w >= 0 && w < problem_size.W;
+  }
+
+  ElementAccumulator load(IndexCoord const &index, ReductionCoord const &reduction) const {
+    Element b = ref.at(make_Coord(
+      reduction.n, reduction.d + index.d, reduction.h + index.h, reduction.w + index.w, index.c));
+    return ElementAccumulator(b);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,716 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Conversion of contiguous arrays of numeric elements in host-side code.
+
+    Widening conversions from half_t, bfloat16_t and tfloat32_t to float are exact. Narrowing
+    conversions to half_t, bfloat16_t and tfloat32_t honor the rounding style of the conversion
+    functor and reproduce the scalar conversion bit for bit, including its canonical NaN and the
+    low-order mantissa bits tfloat32_t ignores. Conversions to
+    float_e4m3_t and float_e5m2_t round to nearest even and saturate to the largest finite value
+    as float8_base::convert_float_to_fp8() does, and conversions from them read a table of all
+    256 encodings. The vectorized paths therefore produce the same values as converting one
+    element at a time.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/numeric_conversion.h"
+#include "cutlass/util/reference/host/detail/cpu_features.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if CUTLASS_HOST_SIMD_X86
+
+/// Converts half_t to float eight elements at a time using F16C
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f16_to_f32_avx2(float *dst, half_t const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  return i;
+}
+
+/// Converts bfloat16_t to float eight elements at a time by widening the storage into the upper
+/// half of each 32-bit lane
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_bf16_to_f32_avx2(float *dst, bfloat16_t const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256i w = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(w));
+  }
+  return i;
+}
+
+/// Converts tfloat32_t to float eight elements at a time by clearing the ignored mantissa bits
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_tf32_to_f32_avx2(float *dst, tfloat32_t const *src, int64_t count) {
+  static_assert(sizeof(tfloat32_t) == sizeof(float), "tfloat32_t must be stored in 32 bits");
+  __m256i const mask = _mm256_set1_epi32(~0x1fff);
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_and_si256(x, mask)));
+  }
+  return i;
+}
+
+/// Rounds eight floats to bfloat16_t to nearest even. NaN becomes the canonical NaN 0x7fff.
+CUTLASS_HOST_TARGET_AVX2
+inline __m128i convert_f32_to_bf16_rn_avx2(__m256i x) {
+  __m256i const exponent = _mm256_set1_epi32(0x7f800000);
+  __m256i const magnitude = _mm256_set1_epi32(0x7fffffff);
+
+  __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+  __m256i rounded = _mm256_add_epi32(x, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff)));
+
+  // Infinity is preserved and NaN is replaced, so neither is rounded
+  __m256i non_finite = _mm256_cmpeq_epi32(_mm256_and_si256(x, exponent), exponent);
+  __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, magnitude), exponent);
+  rounded = _mm256_blendv_epi8(rounded, x, non_finite);
+  rounded = _mm256_blendv_epi8(rounded, magnitude, nan);
+
+  __m256i packed = _mm256_packus_epi32(_mm256_srli_epi32(rounded, 16), _mm256_setzero_si256());
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08));
+}
+
+/// Truncates eight floats to bfloat16_t
+CUTLASS_HOST_TARGET_AVX2
+inline __m128i convert_f32_to_bf16_rz_avx2(__m256i x) {
+  __m256i packed = _mm256_packus_epi32(_mm256_srli_epi32(x, 16), _mm256_setzero_si256());
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08));
+}
+
+/// Adds half an ulp to eight finite floats and truncates them to bfloat16_t
+CUTLASS_HOST_TARGET_AVX2
+inline __m128i convert_f32_to_bf16_half_ulp_avx2(__m256i x) {
+  __m256i const exponent = _mm256_set1_epi32(0x7f800000);
+
+  __m256i finite = _mm256_cmpgt_epi32(exponent, _mm256_and_si256(x, exponent));
+  x = _mm256_add_epi32(x, _mm256_and_si256(finite, _mm256_set1_epi32(0x8000)));
+
+  return convert_f32_to_bf16_rz_avx2(x);
+}
+
+/// Rounds eight floats to half_t with the F16C rounding control 'Rounding'. NaN becomes the
+/// canonical NaN 0x7fff. When 'kSaturateToInfinity' is set, magnitudes of 2^16 and beyond become
+/// infinity as the scalar round-toward-zero conversion does, rather than the largest finite value.
+template <int Rounding, bool kSaturateToInfinity>
+CUTLASS_HOST_TARGET_AVX2
+inline __m128i convert_f32_to_f16_avx2(__m256 x) {
+
+  __m128i h = _mm256_cvtps_ph(x, Rounding);
+
+  __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+  __m128i nan16 = _mm_packs_epi32(_mm256_castsi256_si128(nan), _mm256_extracti128_si256(nan, 1));
+  h = _mm_blendv_epi8(h, _mm_set1_epi16(0x7fff), nan16);
+
+  if (kSaturateToInfinity) {
+    __m256 abs_x = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+    __m256i over = _mm256_castps_si256(_mm256_cmp_ps(abs_x, _mm256_set1_ps(65536.0f), _CMP_GE_OQ));
+    __m128i over16 = _mm_packs_epi32(_mm256_castsi256_si128(over), _mm256_extracti128_si256(over, 1));
+    __m128i inf = _mm_or_si128(_mm_and_si128(h, _mm_set1_epi16(int16_t(0x8000))), _mm_set1_epi16(0x7c00));
+    h = _mm_blendv_epi8(h, inf, over16);
+  }
+
+  return h;
+}
+
+/// F16C rounding control and overflow behavior of the scalar conversions to half_t
+template <FloatRoundStyle Round>
+struct ConvertArrayF16Rounding;
+
+template <>
+struct ConvertArrayF16Rounding<FloatRoundStyle::round_to_nearest> {
+  static int const kRounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+  static bool const kSaturateToInfinity = false;
+};
+
+template <>
+struct ConvertArrayF16Rounding<FloatRoundStyle::round_toward_zero> {
+  static int const kRounding = _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC;
+  static bool const kSaturateToInfinity = true;
+};
+
+/// Narrows float to half_t eight elements at a time
+template <FloatRoundStyle Round>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f32_to_f16_avx2(half_t *dst, float const *src, int64_t count) {
+  using Rounding = ConvertArrayF16Rounding<Round>;
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 x = _mm256_loadu_ps(src + i);
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(dst + i),
+      convert_f32_to_f16_avx2<Rounding::kRounding, Rounding::kSaturateToInfinity>(x));
+  }
+  return i;
+}
+
+/// Narrows float to bfloat16_t eight elements at a time
+template <FloatRoundStyle Round>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f32_to_bf16_avx2(bfloat16_t *dst, float const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    __m128i h;
+    if (Round == FloatRoundStyle::round_to_nearest) {
+      h = convert_f32_to_bf16_rn_avx2(x);
+    }
+    else if (Round == FloatRoundStyle::round_toward_zero) {
+      h = convert_f32_to_bf16_rz_avx2(x);
+    }
+    else {
+      h = convert_f32_to_bf16_half_ulp_avx2(x);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+  }
+  return i;
+}
+
+/// Rounds eight floats to tfloat32_t as the scalar conversion of rounding style 'Round' does,
+/// including the ignored low-order mantissa bits it leaves in place
+template <FloatRoundStyle Round>
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i convert_f32_to_tf32_avx2(__m256i x) {
+  __m256i const exponent = _mm256_set1_epi32(0x7f800000);
+
+  if (Round == FloatRoundStyle::round_toward_zero) {
+    return _mm256_and_si256(x, _mm256_set1_epi32(~0x1fff));
+  }
+
+  if (Round == FloatRoundStyle::round_half_ulp_trunc_dntz) {
+    // Adds half an ulp computed from the exponent, so denormals are not rounded up
+    __m256 d = _mm256_castsi256_ps(_mm256_and_si256(x, _mm256_set1_epi32(0xff800000)));
+    __m256 z = _mm256_add_ps(_mm256_mul_ps(d, _mm256_set1_ps(1.0f / 2048)), _mm256_castsi256_ps(x));
+    return _mm256_castps_si256(z);
+  }
+
+  __m256i finite = _mm256_cmpgt_epi32(exponent, _mm256_and_si256(x, exponent));
+
+  if (Round == FloatRoundStyle::round_half_ulp_truncate) {
+    return _mm256_add_epi32(x, _mm256_and_si256(finite, _mm256_set1_epi32(0x1000)));
+  }
+
+  // Rounds to nearest even by carrying into bit 13, leaving the low-order bits unchanged
+  __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 13), _mm256_set1_epi32(1));
+  __m256i low = _mm256_and_si256(x, _mm256_set1_epi32(0x1fff));
+  __m256i carry = _mm256_srli_epi32(
+    _mm256_add_epi32(low, _mm256_add_epi32(lsb, _mm256_set1_epi32(0xfff))), 13);
+  __m256i rounded = _mm256_add_epi32(x, _mm256_slli_epi32(carry, 13));
+
+  // Infinity is preserved and NaN becomes the canonical NaN 0x7fffffff
+  __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0x7fffffff)), exponent);
+  rounded = _mm256_blendv_epi8(x, rounded, finite);
+  return _mm256_blendv_epi8(rounded, _mm256_set1_epi32(0x7fffffff), nan);
+}
+
+/// Rounds float to tfloat32_t eight elements at a time
+template <FloatRoundStyle Round>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f32_to_tf32_avx2(tfloat32_t *dst, float const *src, int64_t count) {
+  static_assert(sizeof(tfloat32_t) == sizeof(float), "tfloat32_t must be stored in 32 bits");
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), convert_f32_to_tf32_avx2<Round>(x));
+  }
+  return i;
+}
+
+/// Splits float into big and small tfloat32_t parts eight elements at a time. The small part
+/// rounds the difference between the source and the big part widened to float.
+template <FloatRoundStyle RoundBig, FloatRoundStyle RoundSmall>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f32_to_tf32_split_avx2(
+  tfloat32_t *big, tfloat32_t *small, float const *src, int64_t count) {
+
+  __m256i const mask = _mm256_set1_epi32(~0x1fff);
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    __m256i b = convert_f32_to_tf32_avx2<RoundBig>(x);
+    __m256 residual = _mm256_sub_ps(
+      _mm256_castsi256_ps(x), _mm256_castsi256_ps(_mm256_and_si256(b, mask)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(big + i), b);
+    _mm256_storeu_si256(
+      reinterpret_cast<__m256i *>(small + i),
+      convert_f32_to_tf32_avx2<RoundSmall>(_mm256_castps_si256(residual)));
+  }
+  return i;
+}
+
+/// Converts half_t to bfloat16_t eight elements at a time, rounding to nearest even
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f16_to_bf16_avx2(bfloat16_t *dst, half_t const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256i x = _mm256_castps_si256(_mm256_cvtph_ps(h));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), convert_f32_to_bf16_rn_avx2(x));
+  }
+  return i;
+}
+
+/// Converts bfloat16_t to half_t eight elements at a time, rounding to nearest even
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_bf16_to_f16_avx2(half_t *dst, bfloat16_t const *src, int64_t count) {
+  using Rounding = ConvertArrayF16Rounding<FloatRoundStyle::round_to_nearest>;
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256 x = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(dst + i),
+      convert_f32_to_f16_avx2<Rounding::kRounding, Rounding::kSaturateToInfinity>(x));
+  }
+  return i;
+}
+
+/// Rounds eight floats to nearest even in the 8-bit floating point type 'Fp8',
+/// saturating out-of-range values and infinity to the largest finite value. NaN becomes 0x7f.
+/// Returns the encodings in the low byte of each 32-bit lane.
+template <typename Fp8>
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i convert_f32_to_fp8_avx2(__m256i x) {
+  int const kMantissa = Fp8::FP8_NUM_MANTISSA_BITS;
+  int const kShift = 23 - kMantissa;
+
+  // Bias of the float exponent relative to the fp8 exponent
+  int const kRebias = (127 - Fp8::FP8_EXPONENT_BIAS) << kMantissa;
+
+  // Floats below the smallest normal fp8 value round to a multiple of the smallest subnormal
+  int const kSmallestNormal = (127 + Fp8::FP8_MIN_EXPONENT) << 23;
+  int const kSubnormalMagic = (127 + Fp8::FP8_MIN_EXPONENT - kMantissa + 23) << 23;
+
+  __m256i sign = _mm256_and_si256(_mm256_srli_epi32(x, 24), _mm256_set1_epi32(0x80));
+  __m256i a = _mm256_and_si256(x, _mm256_set1_epi32(0x7fffffff));
+
+  // Normal results: round the float mantissa to nearest even and rebias the exponent
+  __m256i odd = _mm256_and_si256(_mm256_srli_epi32(a, kShift), _mm256_set1_epi32(1));
+  __m256i rounded = _mm256_add_epi32(a, _mm256_add_epi32(odd, _mm256_set1_epi32((1 << (kShift - 1)) - 1)));
+  __m256i normal = _mm256_sub_epi32(_mm256_srli_epi32(rounded, kShift), _mm256_set1_epi32(kRebias));
+
+  // Subnormal results: the float addition aligns and rounds the mantissa to nearest even
+  __m256 magic = _mm256_castsi256_ps(_mm256_set1_epi32(kSubnormalMagic));
+  __m256i subnormal = _mm256_sub_epi32(
+    _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), magic)), _mm256_castps_si256(magic));
+
+  __m256i is_subnormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(kSmallestNormal), a);
+  __m256i u = _mm256_blendv_epi8(normal, subnormal, is_subnormal);
+
+  u = _mm256_or_si256(_mm256_min_epi32(u, _mm256_set1_epi32(Fp8::FP8_MAX_FLT)), sign);
+
+  __m256i nan = _mm256_cmpgt_epi32(a, _mm256_set1_epi32(0x7f800000));
+  return _mm256_blendv_epi8(u, _mm256_set1_epi32(0x7f), nan);
+}
+
+/// Stores the low bytes of eight 32-bit lanes
+CUTLASS_HOST_TARGET_AVX2
+inline void store_fp8_avx2(void *dst, __m256i u) {
+  __m128i u16 = _mm_packus_epi32(_mm256_castsi256_si128(u), _mm256_extracti128_si256(u, 1));
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(u16, u16));
+}
+
+/// Narrows float to an 8-bit floating point type eight elements at a time
+template <typename Fp8>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f32_to_fp8_avx2(Fp8 *dst, float const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    store_fp8_avx2(dst + i, convert_f32_to_fp8_avx2<Fp8>(x));
+  }
+  return i;
+}
+
+/// Narrows half_t to an 8-bit floating point type eight elements at a time through float
+template <typename Fp8>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_f16_to_fp8_avx2(Fp8 *dst, half_t const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256i x = _mm256_castps_si256(_mm256_cvtph_ps(h));
+    store_fp8_avx2(dst + i, convert_f32_to_fp8_avx2<Fp8>(x));
+  }
+  return i;
+}
+
+/// Narrows bfloat16_t to an 8-bit floating point type eight elements at a time through float
+template <typename Fp8>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t convert_array_bf16_to_fp8_avx2(Fp8 *dst, bfloat16_t const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256i x = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+    store_fp8_avx2(dst + i, convert_f32_to_fp8_avx2<Fp8>(x));
+  }
+  return i;
+}
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+struct ConvertArrayVoid {
+  using type = void;
+};
+
+/// Rounding style of a conversion functor. Functors without a 'round_style' member are assumed to
+/// be the conversion of the element constructors, which round to nearest even.
+template <typename Convert, typename Enable = void>
+struct ConvertArrayRoundStyle {
+  static FloatRoundStyle const value = FloatRoundStyle::round_to_nearest;
+};
+
+template <typename Convert>
+struct ConvertArrayRoundStyle<Convert, typename ConvertArrayVoid<decltype(Convert::round_style)>::type> {
+  static FloatRoundStyle const value = Convert::round_style;
+};
+
+/// Rounding style of a conversion functor to tfloat32_t. Functors without a 'round_style' member
+/// are assumed to be the conversion of the tfloat32_t constructor, which adds half an ulp and
+/// truncates.
+template <typename Convert, typename Enable = void>
+struct ConvertArrayTf32RoundStyle {
+  static FloatRoundStyle const value = FloatRoundStyle::round_half_ulp_truncate;
+};
+
+template <typename Convert>
+struct ConvertArrayTf32RoundStyle<Convert, typename ConvertArrayVoid<decltype(Convert::round_style)>::type> {
+  static FloatRoundStyle const value = Convert::round_style;
+};
+
+/// Whether the vectorized conversions to half_t, bfloat16_t and tfloat32_t support a rounding style
+template <FloatRoundStyle Round>
+struct ConvertArrayNarrowing {
+  static bool const kHalf =
+    Round == FloatRoundStyle::round_to_nearest || Round == FloatRoundStyle::round_toward_zero;
+
+  static bool const kBFloat16 = kHalf || Round == FloatRoundStyle::round_half_ulp_truncate;
+
+  static bool const kTFloat32 = kBFloat16 || Round == FloatRoundStyle::round_half_ulp_trunc_dntz;
+};
+
+/// Whether an element type is one of the 8-bit floating point types
+template <typename T>
+struct ConvertArrayFp8 : std::false_type { };
+
+template <>
+struct ConvertArrayFp8<float_e4m3_t> : std::true_type { };
+
+template <>
+struct ConvertArrayFp8<float_e5m2_t> : std::true_type { };
+
+/// Whether an element type is decoded from the 8-bit floating point types through a table. These
+/// conversions are exact, so the table holds the result of every rounding style.
+template <typename T>
+struct ConvertArrayFp8Decode {
+  static bool const value = std::is_same<T, float>::value ||
+    std::is_same<T, half_t>::value || std::is_same<T, bfloat16_t>::value;
+};
+
+/// Values of all 256 encodings of the 8-bit floating point type 'Src' converted to 'Dst' by the
+/// scalar conversion, computed on first use
+template <typename Dst, typename Src>
+struct ConvertArrayFp8Table {
+  Dst values[256];
+
+  ConvertArrayFp8Table() {
+    NumericConverter<Dst, Src> convert;
+    for (int i = 0; i < 256; ++i) {
+      values[i] = convert(Src::bitcast(uint8_t(i)));
+    }
+  }
+
+  static Dst const *get() {
+    static ConvertArrayFp8Table const table;
+    return table.values;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Converts 'count' contiguous elements using 'convert' on each element. The overloads for
+/// specific element types below assume 'convert' is the numeric conversion between them.
+template <typename Dst, typename Src, typename Convert>
+void convert_array(Dst *dst, Src const *src, int64_t count, Convert convert) {
+  for (int64_t i = 0; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Identity conversion of float
+template <typename Convert>
+void convert_array(float *dst, float const *src, int64_t count, Convert) {
+  std::memcpy(dst, src, size_t(count) * sizeof(float));
+}
+
+/// Identity conversion of double
+template <typename Convert>
+void convert_array(double *dst, double const *src, int64_t count, Convert) {
+  std::memcpy(dst, src, size_t(count) * sizeof(double));
+}
+
+/// Widens tfloat32_t to float by clearing the ignored low-order mantissa bits
+template <typename Convert>
+void convert_array(float *dst, tfloat32_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = convert_array_tf32_to_f32_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Widens half_t to float
+template <typename Convert>
+void convert_array(float *dst, half_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = convert_array_f16_to_f32_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Widens bfloat16_t to float
+template <typename Convert>
+void convert_array(float *dst, bfloat16_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = convert_array_bf16_to_f32_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Narrows float to half_t
+template <typename Convert>
+void convert_array(half_t *dst, float const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  static FloatRoundStyle const kRound = ConvertArrayRoundStyle<Convert>::value;
+  if (ConvertArrayNarrowing<kRound>::kHalf && CpuFeatures::instance().avx2) {
+    // The kernel is instantiated only for rounding styles it supports
+    i = convert_array_f32_to_f16_avx2<
+      ConvertArrayNarrowing<kRound>::kHalf ? kRound : FloatRoundStyle::round_to_nearest>(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Narrows float to bfloat16_t
+template <typename Convert>
+void convert_array(bfloat16_t *dst, float const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  static FloatRoundStyle const kRound = ConvertArrayRoundStyle<Convert>::value;
+  if (ConvertArrayNarrowing<kRound>::kBFloat16 && CpuFeatures::instance().avx2) {
+    i = convert_array_f32_to_bf16_avx2<kRound>(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Rounds float to tfloat32_t
+template <typename Convert>
+void convert_array(tfloat32_t *dst, float const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  static FloatRoundStyle const kRound = ConvertArrayTf32RoundStyle<Convert>::value;
+  if (ConvertArrayNarrowing<kRound>::kTFloat32 && CpuFeatures::instance().avx2) {
+    i = convert_array_f32_to_tf32_avx2<kRound>(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Splits float into the big and small tfloat32_t parts of NumericConverterFastF32
+template <FloatRoundStyle RoundBig, FloatRoundStyle RoundSmall>
+void convert_array_split(
+  tfloat32_t *big,
+  tfloat32_t *small,
+  float const *src,
+  int64_t count,
+  NumericConverterFastF32<RoundBig, RoundSmall> convert) {
+
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (ConvertArrayNarrowing<RoundBig>::kTFloat32 &&
+      ConvertArrayNarrowing<RoundSmall>::kTFloat32 &&
+      CpuFeatures::instance().avx2) {
+    i = convert_array_f32_to_tf32_split_avx2<RoundBig, RoundSmall>(big, small, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    Array<tfloat32_t, 2> parts = convert(src[i]);
+    big[i] = parts[0];
+    small[i] = parts[1];
+  }
+}
+
+/// Converts half_t to bfloat16_t through float
+template <typename Convert>
+void convert_array(bfloat16_t *dst, half_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (ConvertArrayRoundStyle<Convert>::value == FloatRoundStyle::round_to_nearest &&
+      CpuFeatures::instance().avx2) {
+    i = convert_array_f16_to_bf16_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Converts bfloat16_t to half_t through float
+template <typename Convert>
+void convert_array(half_t *dst, bfloat16_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (ConvertArrayRoundStyle<Convert>::value == FloatRoundStyle::round_to_nearest &&
+      CpuFeatures::instance().avx2) {
+    i = convert_array_bf16_to_f16_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Narrows float to an 8-bit floating point type. The conversion always rounds to nearest even.
+template <typename Fp8, typename Convert>
+typename std::enable_if<ConvertArrayFp8<Fp8>::value>::type
+convert_array(Fp8 *dst, float const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = convert_array_f32_to_fp8_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Narrows half_t to an 8-bit floating point type through float
+template <typename Fp8, typename Convert>
+typename std::enable_if<ConvertArrayFp8<Fp8>::value>::type
+convert_array(Fp8 *dst, half_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = convert_array_f16_to_fp8_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Narrows bfloat16_t to an 8-bit floating point type through float
+template <typename Fp8, typename Convert>
+typename std::enable_if<ConvertArrayFp8<Fp8>::value>::type
+convert_array(Fp8 *dst, bfloat16_t const *src, int64_t count, Convert convert) {
+  int64_t i = 0;
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = convert_array_bf16_to_fp8_avx2(dst, src, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Widens float_e4m3_t to float, half_t or bfloat16_t by table lookup
+template <typename Dst, typename Convert>
+typename std::enable_if<ConvertArrayFp8Decode<Dst>::value>::type
+convert_array(Dst *dst, float_e4m3_t const *src, int64_t count, Convert) {
+  Dst const *table = ConvertArrayFp8Table<Dst, float_e4m3_t>::get();
+  for (int64_t i = 0; i < count; ++i) {
+    dst[i] = table[src[i].storage];
+  }
+}
+
+/// Widens float_e5m2_t to float, half_t or bfloat16_t by table lookup
+template <typename Dst, typename Convert>
+typename std::enable_if<ConvertArrayFp8Decode<Dst>::value>::type
+convert_array(Dst *dst, float_e5m2_t const *src, int64_t count, Convert) {
+  Dst const *table = ConvertArrayFp8Table<Dst, float_e5m2_t>::get();
+  for (int64_t i = 0; i < count; ++i) {
+    dst[i] = table[src[i].storage];
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
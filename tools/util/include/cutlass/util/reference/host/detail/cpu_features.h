@@ -0,0 +1,177 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Runtime detection of x86 SIMD extensions used by host-side reference implementations.
+
+    Vectorized host kernels are compiled with per-function target attributes and selected at
+    runtime, so they do not require the translation unit to be compiled for a particular ISA.
+    They are enabled by defining CUTLASS_ENABLE_HOST_SIMD=1.
+*/
+
+#pragma once
+
+#include "cutlass/cutlass.h"
+
+#ifndef CUTLASS_ENABLE_HOST_SIMD
+#define CUTLASS_ENABLE_HOST_SIMD 0
+#endif
+
+// SIMD extensions are not meaningful when compiling for NVRTC or for the device.
+#if defined(__CUDACC_RTC__) || defined(__CUDA_ARCH__)
+#undef CUTLASS_ENABLE_HOST_SIMD
+#define CUTLASS_ENABLE_HOST_SIMD 0
+#endif
+
+#if CUTLASS_ENABLE_HOST_SIMD && (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define CUTLASS_HOST_SIMD_X86 1
+#else
+#define CUTLASS_HOST_SIMD_X86 0
+#endif
+
+#if CUTLASS_HOST_SIMD_X86
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CUTLASS_HOST_TARGET_AVX2
+#define CUTLASS_HOST_TARGET_AVX512
+#define CUTLASS_HOST_PRAGMA_UNROLL
+#else
+#include <cpuid.h>
+#define CUTLASS_HOST_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+// AVX-512F implies FMA. Unless scalar code may be contracted alike, GCC must not fuse the separate
+// multiplies and adds of the AVX-512 kernels.
+#if defined(__clang__) || defined(__FMA__)
+#define CUTLASS_HOST_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,f16c")))
+#else
+#define CUTLASS_HOST_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,f16c"), optimize("fp-contract=off")))
+#endif
+// Register-blocked kernels rely on constant-trip-count loops being fully unrolled
+#define CUTLASS_HOST_PRAGMA_UNROLL _Pragma("GCC unroll 16")
+#endif
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// SIMD extensions supported by both the processor and the operating system
+class CpuFeatures {
+public:
+
+  bool f16c;
+  bool avx2;
+  bool avx512;    ///< AVX-512 F, BW, DQ and VL
+
+private:
+
+  CpuFeatures(): f16c(false), avx2(false), avx512(false) {
+
+  #if CUTLASS_HOST_SIMD_X86
+    unsigned leaf0[4] = {0, 0, 0, 0};
+    unsigned leaf1[4] = {0, 0, 0, 0};
+    unsigned leaf7[4] = {0, 0, 0, 0};
+
+    cpuid(leaf0, 0, 0);
+    cpuid(leaf1, 1, 0);
+
+    if (leaf0[0] >= 7) {
+      cpuid(leaf7, 7, 0);
+    }
+
+    bool osxsave = (leaf1[2] >> 27) & 1;
+    unsigned long long xcr0 = osxsave ? xgetbv() : 0;
+
+    // XMM and YMM state, and additionally opmask and ZMM state for AVX-512
+    bool os_avx = (xcr0 & 0x6) == 0x6;
+    bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+    bool avx = os_avx && ((leaf1[2] >> 28) & 1);
+
+    f16c = avx && ((leaf1[2] >> 29) & 1);
+    avx2 = avx && ((leaf7[1] >> 5) & 1);
+    avx512 = avx2 && f16c && os_avx512 &&
+      ((leaf7[1] >> 16) & 1) &&   // AVX512F
+      ((leaf7[1] >> 17) & 1) &&   // AVX512DQ
+      ((leaf7[1] >> 30) & 1) &&   // AVX512BW
+      ((leaf7[1] >> 31) & 1);     // AVX512VL
+  #endif
+  }
+
+#if CUTLASS_HOST_SIMD_X86
+
+  static void cpuid(unsigned regs[4], unsigned leaf, unsigned subleaf) {
+  #if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuidex(r, int(leaf), int(subleaf));
+    for (int i = 0; i < 4; ++i) {
+      regs[i] = unsigned(r[i]);
+    }
+  #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+  #endif
+  }
+
+  static unsigned long long xgetbv() {
+  #if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+  #else
+    unsigned eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+  #endif
+  }
+
+#endif
+
+public:
+
+  static CpuFeatures const &instance() {
+    static CpuFeatures const features;
+    return features;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,1185 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Blocked, packed and multithreaded GEMM engine backing the host reference implementations.
+
+    The engine is parameterized by functors which load elements of A and B already converted to
+    the compute type and by an epilogue functor which receives each final accumulator. Both
+    operands are indexed by their output dimension first: load_a(row, k) and load_b(col, k).
+    Operands are packed into contiguous panels of the compute type once per cache block, and the
+    output is partitioned into tiles which are distributed across the host thread pool. Gathered
+    operands may omit terms of the reduction, which are then excluded from each result.
+
+    Each output element accumulates over k = 0, 1, ..., K-1 in order. The portable inner kernel
+    applies InnerProductOp exactly as an unblocked loop would. The vectorized kernels for float,
+    double and their complex and quaternion types selected when CUTLASS_ENABLE_HOST_SIMD is set
+    round each product before adding it, as multiply_add does, so results do not depend on the
+    problem size or on the kernel chosen for the host. This holds as long as the host compiler does
+    not contract InnerProductOp itself into fused multiply-add, which it may only do when host code
+    targets FMA (e.g. -march=native) without -ffp-contract=off.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/functional.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/util/reference/host/detail/convert_array.h"
+#include "cutlass/util/reference/host/detail/gemm_simd.h"
+#include "cutlass/util/reference/host/detail/thread_pool.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Cache blocking parameters of the host GEMM engine
+template <typename ComputeType>
+struct GemmBlocking {
+
+  /// Depth of the packed panels, sized such that a B panel fits in L2
+  static int const kK = (sizeof(ComputeType) <= 4 ? 256 : (sizeof(ComputeType) <= 8 ? 128 : 64));
+
+  /// Rows of the packed A panel
+  static int const kM = 96;
+
+  /// Columns of the packed B panel
+  static int const kN = 256;
+
+  /// Minimum number of output tiles per thread before tiles are made smaller
+  static int const kTilesPerThread = 2;
+
+  /// Problems of at most this many multiply-adds are computed without packing
+  static int64_t const kUnblockedVolume = (int64_t(1) << 15);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Register-blocked inner kernel computing an mr-by-nr block of accumulators from packed panels.
+///
+/// Packed A holds mr consecutive rows for each k, and packed B holds nr consecutive columns for
+/// each k. Accumulators are stored row-major with leading dimension 'ldm'.
+template <typename ComputeType, typename InnerProductOp>
+struct GemmMicrokernel {
+
+  /// Signature of an inner kernel
+  using Function = void (*)(
+    int kc,
+    ComputeType const *packed_a,
+    ComputeType const *packed_b,
+    ComputeType *accum,
+    int ldm);
+
+  /// Signature of a kernel updating one row of accumulators, c[j] = op(a, b[j], c[j]) for j in
+  /// [0, n), with the same arithmetic as the inner kernel. 'n' is a multiple of kRowAlignment.
+  using RowFunction = void (*)(
+    int n,
+    ComputeType a,
+    ComputeType const *b,
+    ComputeType *c);
+
+  /// Signature of a kernel updating a vector of accumulators elementwise, c[j] = op(a[j], b[j], c[j])
+  /// for j in [0, n), with the same arithmetic as the inner kernel. 'n' is a multiple of
+  /// kRowAlignment.
+  using VectorFunction = void (*)(
+    int n,
+    ComputeType const *a,
+    ComputeType const *b,
+    ComputeType *c);
+
+  /// Granularity of the rows updated by a row or vector kernel
+  static int const kRowAlignment = 16;
+
+  /// Rows of the register block
+  int mr;
+
+  /// Columns of the register block
+  int nr;
+
+  /// Kernel entry point
+  Function function;
+
+  /// Row kernel entry point
+  RowFunction row_function;
+
+  /// Vector kernel entry point
+  VectorFunction vector_function;
+
+  /// Portable kernel applying InnerProductOp to each element of the register block
+  template <int Mr, int Nr>
+  static void generic(
+    int kc,
+    ComputeType const *packed_a,
+    ComputeType const *packed_b,
+    ComputeType *accum,
+    int ldm) {
+
+    InnerProductOp inner_product_op;
+
+    ComputeType c[Mr][Nr];
+
+    for (int i = 0; i < Mr; ++i) {
+      for (int j = 0; j < Nr; ++j) {
+        c[i][j] = accum[i * ldm + j];
+      }
+    }
+
+    for (int k = 0; k < kc; ++k, packed_a += Mr, packed_b += Nr) {
+      for (int i = 0; i < Mr; ++i) {
+        for (int j = 0; j < Nr; ++j) {
+          c[i][j] = inner_product_op(packed_a[i], packed_b[j], c[i][j]);
+        }
+      }
+    }
+
+    for (int i = 0; i < Mr; ++i) {
+      for (int j = 0; j < Nr; ++j) {
+        accum[i * ldm + j] = c[i][j];
+      }
+    }
+  }
+
+  /// Portable row kernel applying InnerProductOp to each element
+  static void generic_row(
+    int n,
+    ComputeType a,
+    ComputeType const *b,
+    ComputeType *c) {
+
+    InnerProductOp inner_product_op;
+
+    for (int j = 0; j < n; ++j) {
+      c[j] = inner_product_op(a, b[j], c[j]);
+    }
+  }
+
+  /// Portable vector kernel applying InnerProductOp to each element
+  static void generic_vector(
+    int n,
+    ComputeType const *a,
+    ComputeType const *b,
+    ComputeType *c) {
+
+    InnerProductOp inner_product_op;
+
+    for (int j = 0; j < n; ++j) {
+      c[j] = inner_product_op(a[j], b[j], c[j]);
+    }
+  }
+
+  /// Returns the portable kernels
+  static GemmMicrokernel portable() {
+    return GemmMicrokernel{4, 4, &generic<4, 4>, &generic_row, &generic_vector};
+  }
+
+  /// Selects the kernel used on this host
+  static GemmMicrokernel select();
+
+  /// Returns the kernel selected once per process
+  static GemmMicrokernel const &get() {
+    static GemmMicrokernel const kernel = select();
+    return kernel;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Vectorized inner kernels are available for multiply-add of float and double and of complex and
+/// quaternion elements of float and double. Specializations return false if the host does not
+/// support them.
+template <typename ComputeType, typename InnerProductOp>
+struct GemmMicrokernelSimd {
+  static bool select(GemmMicrokernel<ComputeType, InnerProductOp> &) {
+    return false;
+  }
+};
+
+#if CUTLASS_HOST_SIMD_X86
+
+template <>
+struct GemmMicrokernelSimd<float, multiply_add<float>> {
+  static bool select(GemmMicrokernel<float, multiply_add<float>> &kernel) {
+    if (CpuFeatures::instance().avx512) {
+      kernel.mr = 12;
+      kernel.nr = 32;
+      kernel.function = &gemm_kernel_f32_avx512<12>;
+      kernel.row_function = &gemm_row_kernel_f32_avx2;
+      kernel.vector_function = &gemm_vector_kernel_f32_avx2;
+      return true;
+    }
+    if (CpuFeatures::instance().avx2) {
+      kernel.mr = 6;
+      kernel.nr = 16;
+      kernel.function = &gemm_kernel_f32_avx2<6>;
+      kernel.row_function = &gemm_row_kernel_f32_avx2;
+      kernel.vector_function = &gemm_vector_kernel_f32_avx2;
+      return true;
+    }
+    return false;
+  }
+};
+
+template <>
+struct GemmMicrokernelSimd<double, multiply_add<double>> {
+  static bool select(GemmMicrokernel<double, multiply_add<double>> &kernel) {
+    if (CpuFeatures::instance().avx512) {
+      kernel.mr = 12;
+      kernel.nr = 16;
+      kernel.function = &gemm_kernel_f64_avx512<12>;
+      kernel.row_function = &gemm_row_kernel_f64_avx2;
+      kernel.vector_function = &gemm_vector_kernel_f64_avx2;
+      return true;
+    }
+    if (CpuFeatures::instance().avx2) {
+      kernel.mr = 6;
+      kernel.nr = 8;
+      kernel.function = &gemm_kernel_f64_avx2<6>;
+      kernel.row_function = &gemm_row_kernel_f64_avx2;
+      kernel.vector_function = &gemm_vector_kernel_f64_avx2;
+      return true;
+    }
+    return false;
+  }
+};
+
+template <>
+struct GemmMicrokernelSimd<complex<float>, multiply_add<complex<float>>> {
+  static bool select(GemmMicrokernel<complex<float>, multiply_add<complex<float>>> &kernel) {
+    if (CpuFeatures::instance().avx2) {
+      kernel.mr = 4;
+      kernel.nr = arch::HostSimdSplit<float>::kLanes;
+      kernel.function = &gemm_kernel_split_avx2<complex<float>, 4>;
+      kernel.row_function = &gemm_row_kernel_split_avx2<complex<float>>;
+      kernel.vector_function = &gemm_vector_kernel_split_avx2<complex<float>>;
+      return true;
+    }
+    return false;
+  }
+};
+
+template <>
+struct GemmMicrokernelSimd<complex<double>, multiply_add<complex<double>>> {
+  static bool select(GemmMicrokernel<complex<double>, multiply_add<complex<double>>> &kernel) {
+    if (CpuFeatures::instance().avx2) {
+      kernel.mr = 4;
+      kernel.nr = arch::HostSimdSplit<double>::kLanes;
+      kernel.function = &gemm_kernel_split_avx2<complex<double>, 4>;
+      kernel.row_function = &gemm_row_kernel_split_avx2<complex<double>>;
+      kernel.vector_function = &gemm_vector_kernel_split_avx2<complex<double>>;
+      return true;
+    }
+    return false;
+  }
+};
+
+template <>
+struct GemmMicrokernelSimd<Quaternion<float>, multiply_add<Quaternion<float>>> {
+  static bool select(GemmMicrokernel<Quaternion<float>, multiply_add<Quaternion<float>>> &kernel) {
+    if (CpuFeatures::instance().avx2) {
+      kernel.mr = 2;
+      kernel.nr = arch::HostSimdSplit<float>::kLanes;
+      kernel.function = &gemm_kernel_split_avx2<Quaternion<float>, 2>;
+      kernel.row_function = &gemm_row_kernel_split_avx2<Quaternion<float>>;
+      kernel.vector_function = &gemm_vector_kernel_split_avx2<Quaternion<float>>;
+      return true;
+    }
+    return false;
+  }
+};
+
+template <>
+struct GemmMicrokernelSimd<Quaternion<double>, multiply_add<Quaternion<double>>> {
+  static bool select(GemmMicrokernel<Quaternion<double>, multiply_add<Quaternion<double>>> &kernel) {
+    if (CpuFeatures::instance().avx2) {
+      kernel.mr = 2;
+      kernel.nr = arch::HostSimdSplit<double>::kLanes;
+      kernel.function = &gemm_kernel_split_avx2<Quaternion<double>, 2>;
+      kernel.row_function = &gemm_row_kernel_split_avx2<Quaternion<double>>;
+      kernel.vector_function = &gemm_vector_kernel_split_avx2<Quaternion<double>>;
+      return true;
+    }
+    return false;
+  }
+};
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+template <typename ComputeType, typename InnerProductOp>
+GemmMicrokernel<ComputeType, InnerProductOp> GemmMicrokernel<ComputeType, InnerProductOp>::select() {
+  GemmMicrokernel kernel = portable();
+  GemmMicrokernelSimd<ComputeType, InnerProductOp>::select(kernel);
+  return kernel;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Operand of a GEMM stored in memory with arbitrary strides along its output dimension and
+/// along k. Contiguous runs are converted to the compute type in bulk while packing.
+template <typename Element, typename ComputeType, typename Convert>
+struct DenseOperand {
+
+  Element const *ptr;
+  int64_t stride_idx;
+  int64_t stride_k;
+  Convert convert;
+
+  ComputeType operator()(int idx, int k) const {
+    return convert(ptr[idx * stride_idx + k * stride_k]);
+  }
+};
+
+/// Packs [idx_begin, idx_end) x [k_begin, k_begin + kc) of an operand into strips holding
+/// 'width' consecutive indices for each k. Indices beyond idx_end are zero-filled.
+template <typename ComputeType, typename Load>
+void pack_panel(
+  ComputeType *dst,
+  Load const &load,
+  int idx_begin,
+  int idx_end,
+  int width,
+  int k_begin,
+  int kc) {
+
+  for (int idx = idx_begin; idx < idx_end; idx += width, dst += size_t(width) * kc) {
+    int const valid = std::min(width, idx_end - idx);
+    ComputeType *strip = dst;
+    for (int k = 0; k < kc; ++k, strip += width) {
+      for (int i = 0; i < valid; ++i) {
+        strip[i] = load(idx + i, k_begin + k);
+      }
+      for (int i = valid; i < width; ++i) {
+        strip[i] = ComputeType();
+      }
+    }
+  }
+}
+
+/// Packs a dense operand, converting contiguous runs along either dimension in bulk
+template <typename ComputeType, typename Element, typename Convert>
+void pack_panel(
+  ComputeType *dst,
+  DenseOperand<Element, ComputeType, Convert> const &operand,
+  int idx_begin,
+  int idx_end,
+  int width,
+  int k_begin,
+  int kc) {
+
+  int const count = idx_end - idx_begin;
+  int const strips = (count + width - 1) / width;
+
+  if (operand.stride_idx == 1) {
+
+    // Convert one line of the panel per k and distribute it across strips
+    std::vector<ComputeType> line(size_t(strips) * width, ComputeType());
+
+    for (int k = 0; k < kc; ++k) {
+      convert_array(
+        line.data(),
+        operand.ptr + idx_begin + (k_begin + k) * operand.stride_k,
+        count,
+        operand.convert);
+
+      for (int strip = 0; strip < strips; ++strip) {
+        std::copy(
+          line.data() + strip * width,
+          line.data() + (strip + 1) * width,
+          dst + (size_t(strip) * kc + k) * width);
+      }
+    }
+  }
+  else if (operand.stride_k == 1) {
+
+    // Convert a run along k for each index and interleave it into its strip
+    std::vector<ComputeType> line(kc);
+
+    for (int strip = 0; strip < strips; ++strip) {
+      ComputeType *strip_dst = dst + size_t(strip) * kc * width;
+      for (int i = 0; i < width; ++i) {
+        int idx = idx_begin + strip * width + i;
+        if (idx < idx_end) {
+          convert_array(
+            line.data(),
+            operand.ptr + idx * operand.stride_idx + k_begin,
+            kc,
+            operand.convert);
+          for (int k = 0; k < kc; ++k) {
+            strip_dst[k * width + i] = line[k];
+          }
+        }
+        else {
+          for (int k = 0; k < kc; ++k) {
+            strip_dst[k * width + i] = ComputeType();
+          }
+        }
+      }
+    }
+  }
+  else {
+    pack_panel<ComputeType>(dst, [&](int idx, int k) { return operand(idx, k); },
+      idx_begin, idx_end, width, k_begin, kc);
+  }
+}
+
+/// Operand whose elements are addressed through separately decoded output and reduction indices,
+/// such as the gathered operands of an implicit GEMM convolution. Decoder provides:
+///
+///   IndexCoord index(int idx) const;
+///   ReductionCoord reduction(int k) const;
+///   ComputeType operator()(IndexCoord const &, ReductionCoord const &) const;
+///
+template <typename Decoder>
+struct FactoredOperand {
+  Decoder decoder;
+};
+
+/// Packs a factored operand. Indices are decoded once per panel rather than once per element.
+template <typename ComputeType, typename Decoder>
+void pack_panel(
+  ComputeType *dst,
+  FactoredOperand<Decoder> const &operand,
+  int idx_begin,
+  int idx_end,
+  int width,
+  int k_begin,
+  int kc) {
+
+  using IndexCoord = typename Decoder::IndexCoord;
+  using ReductionCoord = typename Decoder::ReductionCoord;
+
+  Decoder const &decoder = operand.decoder;
+
+  std::vector<IndexCoord> index_coords(size_t(idx_end - idx_begin));
+  std::vector<ReductionCoord> reduction_coords(kc);
+
+  for (int idx = idx_begin; idx < idx_end; ++idx) {
+    index_coords[idx - idx_begin] = decoder.index(idx);
+  }
+
+  for (int k = 0; k < kc; ++k) {
+    reduction_coords[k] = decoder.reduction(k_begin + k);
+  }
+
+  for (int idx = idx_begin; idx < idx_end; idx += width, dst += size_t(width) * kc) {
+    int const valid = std::min(width, idx_end - idx);
+    IndexCoord const *index = index_coords.data() + (idx - idx_begin);
+    ComputeType *strip = dst;
+    for (int k = 0; k < kc; ++k, strip += width) {
+      for (int i = 0; i < valid; ++i) {
+        strip[i] = decoder(index[i], reduction_coords[k]);
+      }
+      for (int i = valid; i < width; ++i) {
+        strip[i] = ComputeType();
+      }
+    }
+  }
+}
+
+/// Loads element (idx, k) of an operand outside of a packed panel
+template <typename ComputeType, typename Load>
+ComputeType load_element(Load const &load, int idx, int k) {
+  return load(idx, k);
+}
+
+template <typename ComputeType, typename Decoder>
+ComputeType load_element(FactoredOperand<Decoder> const &operand, int idx, int k) {
+  return operand.decoder(operand.decoder.index(idx), operand.decoder.reduction(k));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Gathered operand of a reduction which omits some of its terms, such as the filter taps of a
+/// convolution which fall into padding. Decoder provides
+///
+///   IndexCoord index(int idx) const;
+///   ReductionCoord reduction(int k) const;
+///   bool contains(IndexCoord const &, ReductionCoord const &) const;
+///   ComputeType load(IndexCoord const &, ReductionCoord const &) const;
+///
+/// where load() is only invoked for contained terms. The engine computes results as if omitted
+/// terms were absent from the reduction.
+template <typename Decoder>
+struct MaskedOperand {
+  Decoder decoder;
+};
+
+template <typename ComputeType, typename Decoder>
+ComputeType load_element(MaskedOperand<Decoder> const &operand, int idx, int k) {
+  return operand.decoder.load(operand.decoder.index(idx), operand.decoder.reduction(k));
+}
+
+/// Returns false if the term (idx, k) of an operand is omitted from the reduction
+template <typename Load>
+bool contains_term(Load const &, int, int) {
+  return true;
+}
+
+template <typename Decoder>
+bool contains_term(MaskedOperand<Decoder> const &operand, int idx, int k) {
+  return operand.decoder.contains(operand.decoder.index(idx), operand.decoder.reduction(k));
+}
+
+/// Packs a panel as pack_panel() does and records which of its terms belong to the reduction, one
+/// byte per element. Returns true if any term within [idx_begin, idx_end) is omitted. Operands
+/// other than MaskedOperand contain every term and leave 'mask' untouched.
+template <typename ComputeType, typename Load>
+bool pack_masked_panel(
+  ComputeType *dst,
+  std::vector<uint8_t> &,
+  Load const &load,
+  int idx_begin,
+  int idx_end,
+  int width,
+  int k_begin,
+  int kc) {
+
+  pack_panel(dst, load, idx_begin, idx_end, width, k_begin, kc);
+  return false;
+}
+
+template <typename ComputeType, typename Decoder>
+bool pack_masked_panel(
+  ComputeType *dst,
+  std::vector<uint8_t> &mask,
+  MaskedOperand<Decoder> const &operand,
+  int idx_begin,
+  int idx_end,
+  int width,
+  int k_begin,
+  int kc) {
+
+  using IndexCoord = typename Decoder::IndexCoord;
+  using ReductionCoord = typename Decoder::ReductionCoord;
+
+  Decoder const &decoder = operand.decoder;
+
+  int const strips = (idx_end - idx_begin + width - 1) / width;
+
+  std::vector<IndexCoord> index_coords(size_t(idx_end - idx_begin));
+  std::vector<ReductionCoord> reduction_coords(kc);
+
+  for (int idx = idx_begin; idx < idx_end; ++idx) {
+    index_coords[idx - idx_begin] = decoder.index(idx);
+  }
+
+  for (int k = 0; k < kc; ++k) {
+    reduction_coords[k] = decoder.reduction(k_begin + k);
+  }
+
+  mask.resize(size_t(strips) * width * kc);
+
+  bool omitted = false;
+
+  for (int strip = 0; strip < strips; ++strip) {
+    int const idx = idx_begin + strip * width;
+    int const valid = std::min(width, idx_end - idx);
+    IndexCoord const *index = index_coords.data() + (idx - idx_begin);
+    ComputeType *strip_dst = dst + size_t(strip) * width * kc;
+    uint8_t *strip_mask = mask.data() + size_t(strip) * width * kc;
+    for (int k = 0; k < kc; ++k, strip_dst += width, strip_mask += width) {
+      for (int i = 0; i < valid; ++i) {
+        bool contained = decoder.contains(index[i], reduction_coords[k]);
+        strip_dst[i] = (contained ? decoder.load(index[i], reduction_coords[k]) : ComputeType());
+        strip_mask[i] = uint8_t(contained);
+        omitted = omitted || !contained;
+      }
+      for (int i = valid; i < width; ++i) {
+        strip_dst[i] = ComputeType();
+        strip_mask[i] = 0;
+      }
+    }
+  }
+
+  return omitted;
+}
+
+/// True if InnerProductOp leaves an accumulator unchanged when one operand is zero and the other
+/// is finite. Omitted terms may then be computed from zero-filled panels, given accumulators which
+/// start at positive zero.
+template <typename ComputeType, typename InnerProductOp>
+struct GemmZeroTermIsNeutral {
+  static bool const value = false;
+};
+
+template <typename ComputeType>
+struct GemmZeroTermIsNeutral<ComputeType, multiply_add<ComputeType, ComputeType, ComputeType>> {
+  static bool const value = true;
+};
+
+/// Returns true if no element of a packed panel is infinite or NaN. A finite value minus itself
+/// is zero, while infinities and NaN yield NaN, which compares unequal to itself.
+template <typename ComputeType>
+bool packed_panel_is_finite(ComputeType const *panel, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ComputeType difference = panel[i] - panel[i];
+    if (!(difference == difference)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Partitioning of a GEMM output into tiles processed by independent threads
+struct GemmTiling {
+  int tile_m;
+  int tile_n;
+  int tiles_m;
+  int tiles_n;
+
+  /// Chooses tile dimensions which are multiples of the register block and shrinks them until
+  /// there are enough tiles to occupy the host threads.
+  template <typename ComputeType>
+  static GemmTiling make(int M, int N, int mr, int nr, int64_t batch_count = 1) {
+
+    auto round_up = [](int x, int multiple) { return (x + multiple - 1) / multiple * multiple; };
+
+    // Copies, as std::min() would bind references to the static members
+    int const tile_m_max = GemmBlocking<ComputeType>::kM;
+    int const tile_n_max = GemmBlocking<ComputeType>::kN;
+
+    GemmTiling tiling;
+    tiling.tile_m = round_up(std::min(tile_m_max, std::max(M, 1)), mr);
+    tiling.tile_n = round_up(std::min(tile_n_max, std::max(N, 1)), nr);
+
+    int64_t target = int64_t(host_thread_count()) * GemmBlocking<ComputeType>::kTilesPerThread;
+
+    while (true) {
+      tiling.tiles_m = (M + tiling.tile_m - 1) / tiling.tile_m;
+      tiling.tiles_n = (N + tiling.tile_n - 1) / tiling.tile_n;
+
+      if (batch_count * tiling.tiles_m * tiling.tiles_n >= target) {
+        break;
+      }
+
+      if (tiling.tile_n >= tiling.tile_m && tiling.tile_n > 4 * nr) {
+        tiling.tile_n = round_up(tiling.tile_n / 2, nr);
+      }
+      else if (tiling.tile_m > 4 * mr) {
+        tiling.tile_m = round_up(tiling.tile_m / 2, mr);
+      }
+      else {
+        break;
+      }
+    }
+
+    return tiling;
+  }
+
+  int64_t count() const {
+    return int64_t(tiles_m) * tiles_n;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Accumulates one block of packed panels term by term, skipping the terms whose mask byte is
+/// zero. A null mask contains every term.
+template <typename ComputeType, typename InnerProductOp>
+void gemm_block_masked(
+  int strips_m,
+  int strips_n,
+  int mr,
+  int nr,
+  int kc,
+  ComputeType const *packed_a,
+  uint8_t const *mask_a,
+  ComputeType const *packed_b,
+  uint8_t const *mask_b,
+  ComputeType *accum,
+  int ldm) {
+
+  InnerProductOp inner_product_op;
+
+  for (int strip_m = 0; strip_m < strips_m; ++strip_m) {
+    for (int i = 0; i < mr; ++i) {
+
+      size_t const offset_a = size_t(strip_m) * mr * kc + i;
+
+      for (int strip_n = 0; strip_n < strips_n; ++strip_n) {
+        for (int j = 0; j < nr; ++j) {
+
+          size_t const offset_b = size_t(strip_n) * nr * kc + j;
+
+          ComputeType &c = accum[(size_t(strip_m) * mr + i) * ldm + strip_n * nr + j];
+
+          for (int k = 0; k < kc; ++k) {
+            size_t a = offset_a + size_t(k) * mr;
+            size_t b = offset_b + size_t(k) * nr;
+
+            if ((!mask_a || mask_a[a]) && (!mask_b || mask_b[b])) {
+              c = inner_product_op(packed_a[a], packed_b[b], c);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Computes one output tile of a GEMM, accumulating over k in [k_begin, k_end).
+///
+///   load_a(row, k) -> ComputeType
+///   load_b(col, k) -> ComputeType
+///   epilogue(row, col, ComputeType accum)
+///
+template <
+  typename ComputeType,
+  typename InnerProductOp,
+  typename LoadA,
+  typename LoadB,
+  typename Epilogue
+>
+void gemm_tile(
+  GemmMicrokernel<ComputeType, InnerProductOp> const &kernel,
+  int row_begin,
+  int row_end,
+  int col_begin,
+  int col_end,
+  int k_begin,
+  int k_end,
+  LoadA const &load_a,
+  LoadB const &load_b,
+  Epilogue const &epilogue,
+  ComputeType initial_accum) {
+
+  int const mr = kernel.mr;
+  int const nr = kernel.nr;
+  int const kc_max = GemmBlocking<ComputeType>::kK;
+
+  int const rows = row_end - row_begin;
+  int const cols = col_end - col_begin;
+  int const K = std::max(k_end - k_begin, 0);
+
+  if (rows <= 0 || cols <= 0) {
+    return;
+  }
+
+  int const strips_m = (rows + mr - 1) / mr;
+  int const strips_n = (cols + nr - 1) / nr;
+  int const ldm = strips_n * nr;
+
+  std::vector<ComputeType> accum(size_t(strips_m) * mr * ldm, initial_accum);
+  std::vector<ComputeType> packed_a(size_t(strips_m) * mr * std::min(K, kc_max));
+  std::vector<ComputeType> packed_b(size_t(strips_n) * nr * std::min(K, kc_max));
+  std::vector<uint8_t> mask_a;
+  std::vector<uint8_t> mask_b;
+
+  for (int k = k_begin; k < k_end; k += kc_max) {
+
+    int const kc = std::min(kc_max, k_end - k);
+
+    bool const omitted_a = pack_masked_panel(
+      packed_a.data(), mask_a, load_a, row_begin, row_end, mr, k, kc);
+    bool const omitted_b = pack_masked_panel(
+      packed_b.data(), mask_b, load_b, col_begin, col_end, nr, k, kc);
+
+    // Omitted terms are packed as zero. The inner kernels may add their products unless a zero
+    // product is not neutral, in which case the block is accumulated term by term.
+    if (omitted_a || omitted_b) {
+
+      bool zero_is_neutral = GemmZeroTermIsNeutral<ComputeType, InnerProductOp>::value &&
+        (!omitted_a || packed_panel_is_finite(packed_b.data(), size_t(strips_n) * nr * kc)) &&
+        (!omitted_b || packed_panel_is_finite(packed_a.data(), size_t(strips_m) * mr * kc));
+
+      if (!zero_is_neutral) {
+        gemm_block_masked<ComputeType, InnerProductOp>(
+          strips_m, strips_n, mr, nr, kc,
+          packed_a.data(), omitted_a ? mask_a.data() : nullptr,
+          packed_b.data(), omitted_b ? mask_b.data() : nullptr,
+          accum.data(), ldm);
+
+        continue;
+      }
+    }
+
+    // Each B strip stays resident in L1 while the A panel streams from L2
+    for (int strip_n = 0; strip_n < strips_n; ++strip_n) {
+      for (int strip_m = 0; strip_m < strips_m; ++strip_m) {
+        kernel.function(
+          kc,
+          packed_a.data() + size_t(strip_m) * mr * kc,
+          packed_b.data() + size_t(strip_n) * nr * kc,
+          accum.data() + size_t(strip_m) * mr * ldm + strip_n * nr,
+          ldm);
+      }
+    }
+  }
+
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      epilogue(row_begin + i, col_begin + j, accum[size_t(i) * ldm + j]);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Extent of the work of one output tile
+struct GemmTileBounds {
+
+  /// False if no element of the tile is computed
+  bool active;
+
+  /// Range of the reduction over which the operands of the tile may be nonzero
+  int k_begin;
+  int k_end;
+};
+
+/// Computes every tile over the full reduction
+struct GemmTileBoundsFull {
+  GemmTileBounds operator()(int, int, int, int, int K) const {
+    return GemmTileBounds{true, 0, K};
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a small GEMM without packing by applying InnerProductOp to each term in order
+template <
+  typename ComputeType,
+  typename InnerProductOp,
+  typename LoadA,
+  typename LoadB,
+  typename Epilogue,
+  typename TileBounds
+>
+void gemm_unblocked(
+  int M,
+  int N,
+  int K,
+  LoadA const &load_a,
+  LoadB const &load_b,
+  Epilogue const &epilogue,
+  ComputeType initial_accum,
+  TileBounds const &tile_bounds) {
+
+  InnerProductOp inner_product_op;
+
+  for (int col = 0; col < N; ++col) {
+    for (int row = 0; row < M; ++row) {
+
+      GemmTileBounds bounds = tile_bounds(row, row + 1, col, col + 1, K);
+
+      if (!bounds.active) {
+        continue;
+      }
+
+      ComputeType accum = initial_accum;
+
+      for (int k = bounds.k_begin; k < bounds.k_end; ++k) {
+
+        if (!contains_term(load_a, row, k) || !contains_term(load_b, col, k)) {
+          continue;
+        }
+
+        accum = inner_product_op(
+          load_element<ComputeType>(load_a, row, k),
+          load_element<ComputeType>(load_b, col, k),
+          accum);
+      }
+
+      epilogue(row, col, accum);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a batch of M-by-N-by-K GEMMs by distributing the output tiles of every problem in the
+/// batch across the host thread pool. The operands and epilogue of each problem are obtained from
+/// factories invoked with its batch index:
+///
+///   operand_a(batch) -> LoadA
+///   operand_b(batch) -> LoadB
+///   epilogue(batch)  -> Epilogue
+///
+/// Structured operands may restrict the work of each tile through
+///
+///   tile_bounds(row_begin, row_end, col_begin, col_end, K) -> GemmTileBounds
+///
+/// Inactive tiles are skipped entirely, and the epilogue is not invoked for their elements.
+///
+/// Small problems are computed whole by a single thread with the unblocked kernel, so that a large
+/// batch of small matrices is not dominated by the cost of packing.
+template <
+  typename ComputeType,
+  typename InnerProductOp,
+  typename OperandA,
+  typename OperandB,
+  typename BatchEpilogue,
+  typename TileBounds = GemmTileBoundsFull
+>
+void gemm_engine_batched(
+  int batch_count,
+  int M,
+  int N,
+  int K,
+  OperandA const &operand_a,
+  OperandB const &operand_b,
+  BatchEpilogue const &epilogue,
+  ComputeType initial_accum,
+  TileBounds const &tile_bounds = TileBounds()) {
+
+  if (batch_count <= 0 || M <= 0 || N <= 0) {
+    return;
+  }
+
+  int64_t const volume = int64_t(M) * N * std::max(K, 1);
+
+  if (volume <= GemmBlocking<ComputeType>::kUnblockedVolume) {
+
+    parallel_for_range(batch_count, GemmBlocking<ComputeType>::kUnblockedVolume / volume,
+      [&](int64_t batch_begin, int64_t batch_end) {
+
+      for (int batch = int(batch_begin); batch < int(batch_end); ++batch) {
+        gemm_unblocked<ComputeType, InnerProductOp>(
+          M, N, K,
+          operand_a(batch),
+          operand_b(batch),
+          epilogue(batch),
+          initial_accum,
+          tile_bounds);
+      }
+    });
+
+    return;
+  }
+
+  GemmMicrokernel<ComputeType, InnerProductOp> const &kernel =
+    GemmMicrokernel<ComputeType, InnerProductOp>::get();
+
+  GemmTiling tiling = GemmTiling::make<ComputeType>(M, N, kernel.mr, kernel.nr, batch_count);
+
+  parallel_for(batch_count * tiling.count(), [&](int64_t idx) {
+    int batch = int(idx / tiling.count());
+    int64_t tile = idx % tiling.count();
+    int row_begin = int(tile % tiling.tiles_m) * tiling.tile_m;
+    int col_begin = int(tile / tiling.tiles_m) * tiling.tile_n;
+    int row_end = std::min(row_begin + tiling.tile_m, M);
+    int col_end = std::min(col_begin + tiling.tile_n, N);
+
+    GemmTileBounds bounds = tile_bounds(row_begin, row_end, col_begin, col_end, K);
+
+    if (!bounds.active) {
+      return;
+    }
+
+    gemm_tile(
+      kernel,
+      row_begin,
+      row_end,
+      col_begin,
+      col_end,
+      bounds.k_begin,
+      bounds.k_end,
+      operand_a(batch),
+      operand_b(batch),
+      epilogue(batch),
+      initial_accum);
+  });
+}
+
+/// Unit of work of a grouped GEMM: either an output tile of a large problem or the whole of a
+/// small problem
+struct GemmGroupedWorkItem {
+  int problem;
+  int row_begin;
+  int row_end;
+  int col_begin;
+  int col_end;
+  int64_t cost;
+
+  /// True if the item is a whole small problem computed without packing
+  bool unblocked;
+};
+
+/// Computes a group of GEMMs of arbitrary and independent sizes. The operands and epilogue of each
+/// problem are obtained from factories invoked with its index in the group:
+///
+///   operand_a(problem) -> LoadA
+///   operand_b(problem) -> LoadB
+///   epilogue(problem)  -> Epilogue
+///
+/// Small problems form a single work item computed with the unblocked kernel, and large problems
+/// are partitioned into output tiles, so each element is computed exactly as gemm_engine() would
+/// compute it. Work items are ordered by decreasing volume before being claimed by the host
+/// threads, which balances skewed groups by longest-processing-time-first list scheduling.
+template <
+  typename ComputeType,
+  typename InnerProductOp,
+  typename OperandA,
+  typename OperandB,
+  typename GroupEpilogue
+>
+void gemm_engine_grouped(
+  int problem_count,
+  gemm::GemmCoord const *problem_sizes,
+  OperandA const &operand_a,
+  OperandB const &operand_b,
+  GroupEpilogue const &epilogue,
+  ComputeType initial_accum) {
+
+  GemmMicrokernel<ComputeType, InnerProductOp> const &kernel =
+    GemmMicrokernel<ComputeType, InnerProductOp>::get();
+
+  std::vector<GemmGroupedWorkItem> work;
+
+  for (int problem = 0; problem < problem_count; ++problem) {
+
+    int const M = problem_sizes[problem].m();
+    int const N = problem_sizes[problem].n();
+    int const K = problem_sizes[problem].k();
+
+    if (M <= 0 || N <= 0) {
+      continue;
+    }
+
+    int64_t const volume = int64_t(M) * N * std::max(K, 1);
+
+    if (volume <= GemmBlocking<ComputeType>::kUnblockedVolume) {
+      work.push_back(GemmGroupedWorkItem{problem, 0, M, 0, N, volume, true});
+      continue;
+    }
+
+    GemmTiling tiling = GemmTiling::make<ComputeType>(M, N, kernel.mr, kernel.nr);
+
+    for (int64_t tile = 0; tile < tiling.count(); ++tile) {
+      int row_begin = int(tile % tiling.tiles_m) * tiling.tile_m;
+      int col_begin = int(tile / tiling.tiles_m) * tiling.tile_n;
+      int row_end = std::min(row_begin + tiling.tile_m, M);
+      int col_end = std::min(col_begin + tiling.tile_n, N);
+
+      work.push_back(GemmGroupedWorkItem{
+        problem,
+        row_begin,
+        row_end,
+        col_begin,
+        col_end,
+        int64_t(row_end - row_begin) * (col_end - col_begin) * std::max(K, 1),
+        false});
+    }
+  }
+
+  std::stable_sort(work.begin(), work.end(),
+    [](GemmGroupedWorkItem const &lhs, GemmGroupedWorkItem const &rhs) {
+      return lhs.cost > rhs.cost;
+    });
+
+  parallel_for(int64_t(work.size()), [&](int64_t idx) {
+
+    GemmGroupedWorkItem const &item = work[size_t(idx)];
+    int const K = problem_sizes[item.problem].k();
+
+    if (item.unblocked) {
+
+      gemm_unblocked<ComputeType, InnerProductOp>(
+        item.row_end,
+        item.col_end,
+        K,
+        operand_a(item.problem),
+        operand_b(item.problem),
+        epilogue(item.problem),
+        initial_accum,
+        GemmTileBoundsFull());
+
+      return;
+    }
+
+    gemm_tile(
+      kernel,
+      item.row_begin,
+      item.row_end,
+      item.col_begin,
+      item.col_end,
+      0,
+      K,
+      operand_a(item.problem),
+      operand_b(item.problem),
+      epilogue(item.problem),
+      initial_accum);
+  });
+}
+
+/// Returns the same object for every problem of a batch
+template <typename T>
+struct GemmBatchInvariant {
+
+  T const &value;
+
+  T const &operator()(int) const {
+    return value;
+  }
+};
+
+/// Computes an M-by-N-by-K GEMM by distributing output tiles across the host thread pool.
+template <
+  typename ComputeType,
+  typename InnerProductOp,
+  typename LoadA,
+  typename LoadB,
+  typename Epilogue,
+  typename TileBounds = GemmTileBoundsFull
+>
+void gemm_engine(
+  int M,
+  int N,
+  int K,
+  LoadA const &load_a,
+  LoadB const &load_b,
+  Epilogue const &epilogue,
+  ComputeType initial_accum,
+  TileBounds const &tile_bounds = TileBounds()) {
+
+  gemm_engine_batched<ComputeType, InnerProductOp>(
+    1, M, N, K,
+    GemmBatchInvariant<LoadA>{load_a},
+    GemmBatchInvariant<LoadB>{load_b},
+    GemmBatchInvariant<Epilogue>{epilogue},
+    initial_accum,
+    tile_bounds);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
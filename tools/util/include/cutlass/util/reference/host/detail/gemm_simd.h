@@ -0,0 +1,322 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Register-blocked AVX2 and AVX-512 GEMM inner kernels for float and double accumulators.
+
+    Each kernel computes an Mr-by-(kLanes * 2) block of accumulators from packed panels of A and B.
+    Products are rounded before they are added, as in the scalar multiply_add, so the kernels
+    produce the same accumulators as InnerProductOp. Accumulators are stored row-major with leading
+    dimension 'ldm'. Row and vector kernels apply the same update to a single row of accumulators.
+
+    Kernels for complex and quaternion accumulators split each group of kLanes elements into one
+    register per component with arch::HostSimdSplit, which also implements the host Array
+    operators for these types, so that every term of the product is a multiply and an add of whole
+    registers. Terms are accumulated in the order of the scalar multiply_add specializations.
+*/
+
+#pragma once
+
+#include "cutlass/complex.h"
+#include "cutlass/quaternion.h"
+#include "cutlass/arch/simd_x86.h"
+#include "cutlass/util/reference/host/detail/cpu_features.h"
+
+#if CUTLASS_HOST_SIMD_X86
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Mr x 16 float kernel using AVX2
+template <int Mr>
+CUTLASS_HOST_TARGET_AVX2
+void gemm_kernel_f32_avx2(int kc, float const *a, float const *b, float *c, int ldm) {
+
+  __m256 accum[Mr][2];
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    accum[i][0] = _mm256_loadu_ps(c + i * ldm);
+    accum[i][1] = _mm256_loadu_ps(c + i * ldm + 8);
+  }
+
+  for (int k = 0; k < kc; ++k, a += Mr, b += 16) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+
+    CUTLASS_HOST_PRAGMA_UNROLL
+    for (int i = 0; i < Mr; ++i) {
+      __m256 a_i = _mm256_broadcast_ss(a + i);
+      accum[i][0] = _mm256_add_ps(accum[i][0], _mm256_mul_ps(a_i, b0));
+      accum[i][1] = _mm256_add_ps(accum[i][1], _mm256_mul_ps(a_i, b1));
+    }
+  }
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    _mm256_storeu_ps(c + i * ldm, accum[i][0]);
+    _mm256_storeu_ps(c + i * ldm + 8, accum[i][1]);
+  }
+}
+
+/// Mr x 8 double kernel using AVX2
+template <int Mr>
+CUTLASS_HOST_TARGET_AVX2
+void gemm_kernel_f64_avx2(int kc, double const *a, double const *b, double *c, int ldm) {
+
+  __m256d accum[Mr][2];
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    accum[i][0] = _mm256_loadu_pd(c + i * ldm);
+    accum[i][1] = _mm256_loadu_pd(c + i * ldm + 4);
+  }
+
+  for (int k = 0; k < kc; ++k, a += Mr, b += 8) {
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + 4);
+
+    CUTLASS_HOST_PRAGMA_UNROLL
+    for (int i = 0; i < Mr; ++i) {
+      __m256d a_i = _mm256_broadcast_sd(a + i);
+      accum[i][0] = _mm256_add_pd(accum[i][0], _mm256_mul_pd(a_i, b0));
+      accum[i][1] = _mm256_add_pd(accum[i][1], _mm256_mul_pd(a_i, b1));
+    }
+  }
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    _mm256_storeu_pd(c + i * ldm, accum[i][0]);
+    _mm256_storeu_pd(c + i * ldm + 4, accum[i][1]);
+  }
+}
+
+/// Mr x 32 float kernel using AVX-512
+template <int Mr>
+CUTLASS_HOST_TARGET_AVX512
+void gemm_kernel_f32_avx512(int kc, float const *a, float const *b, float *c, int ldm) {
+
+  __m512 accum[Mr][2];
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    accum[i][0] = _mm512_loadu_ps(c + i * ldm);
+    accum[i][1] = _mm512_loadu_ps(c + i * ldm + 16);
+  }
+
+  for (int k = 0; k < kc; ++k, a += Mr, b += 32) {
+    __m512 b0 = _mm512_loadu_ps(b);
+    __m512 b1 = _mm512_loadu_ps(b + 16);
+
+    CUTLASS_HOST_PRAGMA_UNROLL
+    for (int i = 0; i < Mr; ++i) {
+      __m512 a_i = _mm512_set1_ps(a[i]);
+      accum[i][0] = _mm512_add_ps(accum[i][0], _mm512_mul_ps(a_i, b0));
+      accum[i][1] = _mm512_add_ps(accum[i][1], _mm512_mul_ps(a_i, b1));
+    }
+  }
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    _mm512_storeu_ps(c + i * ldm, accum[i][0]);
+    _mm512_storeu_ps(c + i * ldm + 16, accum[i][1]);
+  }
+}
+
+/// Mr x 16 double kernel using AVX-512
+template <int Mr>
+CUTLASS_HOST_TARGET_AVX512
+void gemm_kernel_f64_avx512(int kc, double const *a, double const *b, double *c, int ldm) {
+
+  __m512d accum[Mr][2];
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    accum[i][0] = _mm512_loadu_pd(c + i * ldm);
+    accum[i][1] = _mm512_loadu_pd(c + i * ldm + 8);
+  }
+
+  for (int k = 0; k < kc; ++k, a += Mr, b += 16) {
+    __m512d b0 = _mm512_loadu_pd(b);
+    __m512d b1 = _mm512_loadu_pd(b + 8);
+
+    CUTLASS_HOST_PRAGMA_UNROLL
+    for (int i = 0; i < Mr; ++i) {
+      __m512d a_i = _mm512_set1_pd(a[i]);
+      accum[i][0] = _mm512_add_pd(accum[i][0], _mm512_mul_pd(a_i, b0));
+      accum[i][1] = _mm512_add_pd(accum[i][1], _mm512_mul_pd(a_i, b1));
+    }
+  }
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    _mm512_storeu_pd(c + i * ldm, accum[i][0]);
+    _mm512_storeu_pd(c + i * ldm + 8, accum[i][1]);
+  }
+}
+
+/// Updates a row of float accumulators, c[j] += a * b[j], with n a multiple of 8. Elementwise
+/// arithmetic rounds identically at any vector width, so this also serves the AVX-512 kernels.
+CUTLASS_HOST_TARGET_AVX2
+inline void gemm_row_kernel_f32_avx2(int n, float a, float const *b, float *c) {
+  __m256 a_v = _mm256_set1_ps(a);
+  for (int j = 0; j < n; j += 8) {
+    _mm256_storeu_ps(c + j, _mm256_add_ps(_mm256_loadu_ps(c + j), _mm256_mul_ps(a_v, _mm256_loadu_ps(b + j))));
+  }
+}
+
+/// Updates a row of double accumulators, c[j] += a * b[j], with n a multiple of 4
+CUTLASS_HOST_TARGET_AVX2
+inline void gemm_row_kernel_f64_avx2(int n, double a, double const *b, double *c) {
+  __m256d a_v = _mm256_set1_pd(a);
+  for (int j = 0; j < n; j += 4) {
+    _mm256_storeu_pd(c + j, _mm256_add_pd(_mm256_loadu_pd(c + j), _mm256_mul_pd(a_v, _mm256_loadu_pd(b + j))));
+  }
+}
+
+/// Updates a vector of float accumulators elementwise, c[j] += a[j] * b[j], with n a multiple of 8
+CUTLASS_HOST_TARGET_AVX2
+inline void gemm_vector_kernel_f32_avx2(int n, float const *a, float const *b, float *c) {
+  for (int j = 0; j < n; j += 8) {
+    _mm256_storeu_ps(c + j, _mm256_add_ps(
+      _mm256_loadu_ps(c + j), _mm256_mul_ps(_mm256_loadu_ps(a + j), _mm256_loadu_ps(b + j))));
+  }
+}
+
+/// Updates a vector of double accumulators elementwise, c[j] += a[j] * b[j], with n a multiple
+/// of 4
+CUTLASS_HOST_TARGET_AVX2
+inline void gemm_vector_kernel_f64_avx2(int n, double const *a, double const *b, double *c) {
+  for (int j = 0; j < n; j += 4) {
+    _mm256_storeu_pd(c + j, _mm256_add_pd(
+      _mm256_loadu_pd(c + j), _mm256_mul_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j))));
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Real type of complex and quaternion elements and the registers holding their components
+template <typename Element>
+struct GemmSplitElement;
+
+template <typename T>
+struct GemmSplitElement<complex<T> > {
+  using Real = T;
+  using Vector = arch::HostSimdSplitVector<typename arch::HostSimdSplit<T>::Register, 2>;
+};
+
+template <typename T>
+struct GemmSplitElement<Quaternion<T> > {
+  using Real = T;
+  using Vector = arch::HostSimdSplitVector<typename arch::HostSimdSplit<T>::Register, 4>;
+};
+
+/// Mr x kLanes kernel for complex or quaternion elements of float or double using AVX2
+template <typename Element, int Mr>
+CUTLASS_HOST_TARGET_AVX2
+void gemm_kernel_split_avx2(int kc, Element const *a, Element const *b, Element *c, int ldm) {
+
+  using Real = typename GemmSplitElement<Element>::Real;
+  using V = arch::HostSimdSplit<Real>;
+  using Vector = typename GemmSplitElement<Element>::Vector;
+
+  Vector accum[Mr];
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    accum[i] = V::load(c + i * ldm);
+  }
+
+  for (int k = 0; k < kc; ++k, a += Mr, b += V::kLanes) {
+    Vector b_v = V::load(b);
+
+    CUTLASS_HOST_PRAGMA_UNROLL
+    for (int i = 0; i < Mr; ++i) {
+      Vector a_i = arch::host_simd_split_broadcast<Real>(a[i]);
+      arch::host_simd_split_multiply_add<Real>(a_i, b_v, accum[i]);
+    }
+  }
+
+  CUTLASS_HOST_PRAGMA_UNROLL
+  for (int i = 0; i < Mr; ++i) {
+    V::store(c + i * ldm, accum[i]);
+  }
+}
+
+/// Updates a row of complex or quaternion accumulators, c[j] += a * b[j], with n a multiple of
+/// kLanes
+template <typename Element>
+CUTLASS_HOST_TARGET_AVX2
+void gemm_row_kernel_split_avx2(int n, Element a, Element const *b, Element *c) {
+
+  using Real = typename GemmSplitElement<Element>::Real;
+  using V = arch::HostSimdSplit<Real>;
+  using Vector = typename GemmSplitElement<Element>::Vector;
+
+  Vector a_v = arch::host_simd_split_broadcast<Real>(a);
+
+  for (int j = 0; j < n; j += V::kLanes) {
+    Vector c_v = V::load(c + j);
+    arch::host_simd_split_multiply_add<Real>(a_v, V::load(b + j), c_v);
+    V::store(c + j, c_v);
+  }
+}
+
+/// Updates a vector of complex or quaternion accumulators elementwise, c[j] += a[j] * b[j], with
+/// n a multiple of kLanes
+template <typename Element>
+CUTLASS_HOST_TARGET_AVX2
+void gemm_vector_kernel_split_avx2(int n, Element const *a, Element const *b, Element *c) {
+
+  using Real = typename GemmSplitElement<Element>::Real;
+  using V = arch::HostSimdSplit<Real>;
+  using Vector = typename GemmSplitElement<Element>::Vector;
+
+  for (int j = 0; j < n; j += V::kLanes) {
+    Vector c_v = V::load(c + j);
+    arch::host_simd_split_multiply_add<Real>(V::load(a + j), V::load(b + j), c_v);
+    V::store(c + j, c_v);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
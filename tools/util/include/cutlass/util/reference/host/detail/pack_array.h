@@ -0,0 +1,415 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Packing and unpacking of integer elements narrower than a byte in host-side code.
+
+    Sub-byte elements are stored least significant bits first: element i of an array of 'Bits'-bit
+    elements occupies bits [(i % k) * Bits, (i % k + 1) * Bits) of byte i / k, where k = 8 / Bits.
+    Packing stores each value modulo 2^Bits as the element's constructor from int does, or clamps
+    it to the range of the element type. Unpacking sign-extends signed elements to int8_t.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/tensor_view.h"
+#include "cutlass/util/reference/host/detail/cpu_features.h"
+#include "cutlass/util/reference/host/detail/thread_pool.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Properties of element types with respect to packing. Only integers narrower than a byte are
+/// packed.
+template <typename T>
+struct PackArrayElement {
+  static bool const kSubbyte = false;
+};
+
+template <int Bits, bool Signed>
+struct PackArrayElement<integer_subbyte<Bits, Signed> > {
+
+  using Element = integer_subbyte<Bits, Signed>;
+
+  /// Type holding one unpacked element
+  using Unpacked = typename std::conditional<Signed, int8_t, uint8_t>::type;
+
+  static bool const kSubbyte = true;
+  static int const kBits = Bits;
+  static bool const kSigned = Signed;
+
+  static Unpacked value(Element x) {
+    return Unpacked(typename Element::T(x));
+  }
+
+  static Element element(Unpacked x) {
+    return Element(int(x));
+  }
+};
+
+template <>
+struct PackArrayElement<bin1_t> {
+
+  using Element = bin1_t;
+  using Unpacked = uint8_t;
+
+  static bool const kSubbyte = true;
+  static int const kBits = 1;
+  static bool const kSigned = false;
+
+  static Unpacked value(Element x) {
+    return Unpacked(x ? 1 : 0);
+  }
+
+  static Element element(Unpacked x) {
+    return x != 0;
+  }
+};
+
+/// Returns a pointer to element 'offset' of a packed array. The offset must be a multiple of the
+/// number of elements per byte.
+template <typename Element>
+Element *packed_array_advance(Element *ptr, int64_t offset) {
+  using Value = typename std::remove_const<Element>::type;
+  if (PackArrayElement<Value>::kSubbyte) {
+    using Byte = typename std::conditional<std::is_const<Element>::value, uint8_t const, uint8_t>::type;
+    return reinterpret_cast<Element *>(
+      reinterpret_cast<Byte *>(ptr) + offset * sizeof_bits<Value>::value / 8);
+  }
+  return ptr + offset;
+}
+
+/// Number of elements in each range of a parallel operation on packed arrays. It is a multiple of
+/// the number of elements per byte of every sub-byte type, so ranges never share a byte.
+static int64_t const kPackArrayChunk = 256;
+
+/// Calls 'func(begin, end)' on ranges of [0, count) starting at multiples of kPackArrayChunk,
+/// in parallel unless the array is small
+template <typename Func>
+void packed_for_range(int64_t count, Func func) {
+
+  int64_t chunks = (count + kPackArrayChunk - 1) / kPackArrayChunk;
+
+  auto visit = [&](int64_t begin, int64_t end) {
+    func(begin * kPackArrayChunk, std::min(count, end * kPackArrayChunk));
+  };
+
+  if (count < kTensorForEachSerialVolume) {
+    visit(0, chunks);
+  }
+  else {
+    parallel_for_range(chunks, kTensorForEachMinChunk / kPackArrayChunk, visit);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Range of values of a packed element type
+template <int Bits, bool Signed>
+struct PackArrayRange {
+  static int const kMin = Signed ? -(1 << (Bits - 1)) : 0;
+  static int const kMax = Signed ? (1 << (Bits - 1)) - 1 : (1 << Bits) - 1;
+};
+
+/// Returns the low 'Bits' bits of a value, clamping it to the range of the element type first if
+/// 'Saturate' is set
+template <int Bits, bool Signed, bool Saturate, typename Value>
+uint8_t pack_value(Value x) {
+  int v = int(x);
+  if (Saturate) {
+    int const kMin = PackArrayRange<Bits, Signed>::kMin;
+    int const kMax = PackArrayRange<Bits, Signed>::kMax;
+    v = std::min(std::max(v, kMin), kMax);
+  }
+  return uint8_t(v & ((1 << Bits) - 1));
+}
+
+/// Sign-extends the low 'Bits' bits of a value if 'Signed' is set
+template <int Bits, bool Signed>
+int unpack_value(int bits) {
+  return Signed ? (bits ^ (1 << (Bits - 1))) - (1 << (Bits - 1)) : bits;
+}
+
+#if CUTLASS_HOST_SIMD_X86
+
+/// Clamps 32 signed bytes to [lo, hi]
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i pack_clamp_avx2(__m256i x, int lo, int hi, int8_t const *) {
+  return _mm256_min_epi8(_mm256_max_epi8(x, _mm256_set1_epi8(int8_t(lo))), _mm256_set1_epi8(int8_t(hi)));
+}
+
+/// Clamps 32 unsigned bytes to [lo, hi] for lo <= 0
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i pack_clamp_avx2(__m256i x, int, int hi, uint8_t const *) {
+  return _mm256_min_epu8(x, _mm256_set1_epi8(int8_t(hi)));
+}
+
+/// Interleaves the nibbles of 32 bytes into 16 bytes
+CUTLASS_HOST_TARGET_AVX2
+inline void pack_store_avx2(uint8_t *dst, __m256i x, std::integral_constant<int, 4>) {
+  x = _mm256_and_si256(x, _mm256_set1_epi8(0x0f));
+  __m256i pairs = _mm256_maddubs_epi16(x, _mm256_set1_epi16(0x1001));
+  __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs, pairs), 0x08);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm256_castsi256_si128(packed));
+}
+
+/// Packs the low two bits of 32 bytes into 8 bytes
+CUTLASS_HOST_TARGET_AVX2
+inline void pack_store_avx2(uint8_t *dst, __m256i x, std::integral_constant<int, 2>) {
+  x = _mm256_and_si256(x, _mm256_set1_epi8(0x03));
+  __m256i pairs = _mm256_maddubs_epi16(x, _mm256_set1_epi16(0x0401));
+  __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00100001));
+  __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(quads, quads), _mm256_setzero_si256());
+  packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm256_castsi256_si128(packed));
+}
+
+/// Packs the low bit of 32 bytes into 4 bytes
+CUTLASS_HOST_TARGET_AVX2
+inline void pack_store_avx2(uint8_t *dst, __m256i x, std::integral_constant<int, 1>) {
+  uint32_t bits = uint32_t(_mm256_movemask_epi8(_mm256_slli_epi16(x, 7)));
+  std::memcpy(dst, &bits, sizeof(bits));
+}
+
+/// Packs 32 elements at a time. Returns the number of elements packed.
+template <int Bits, bool Signed, bool Saturate, typename Value>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t pack_array_avx2(uint8_t *dst, Value const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    if (Saturate) {
+      x = pack_clamp_avx2(
+        x, PackArrayRange<Bits, Signed>::kMin, PackArrayRange<Bits, Signed>::kMax, src);
+    }
+    pack_store_avx2(dst + i * Bits / 8, x, std::integral_constant<int, Bits>());
+  }
+  return i;
+}
+
+/// Splits 16 bytes into the 32 nibbles they hold, low nibble first
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i unpack_load_avx2(uint8_t const *src, std::integral_constant<int, 4>) {
+  __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src));
+  __m128i mask = _mm_set1_epi8(0x0f);
+  __m128i lo = _mm_and_si128(b, mask);
+  __m128i hi = _mm_and_si128(_mm_srli_epi16(b, 4), mask);
+  return _mm256_setr_m128i(_mm_unpacklo_epi8(lo, hi), _mm_unpackhi_epi8(lo, hi));
+}
+
+/// Splits 8 bytes into the 32 two-bit fields they hold
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i unpack_load_avx2(uint8_t const *src, std::integral_constant<int, 2>) {
+  int64_t bits;
+  std::memcpy(&bits, src, sizeof(bits));
+  __m256i x = _mm256_shuffle_epi8(_mm256_set1_epi64x(bits), _mm256_setr_epi8(
+    0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+    4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7));
+  __m256i lo = _mm256_set1_epi32(0x40100401);
+  __m256i hi = _mm256_set1_epi32(int32_t(0x80200802));
+  __m256i bit0 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(x, lo), lo), _mm256_set1_epi8(1));
+  __m256i bit1 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(x, hi), hi), _mm256_set1_epi8(2));
+  return _mm256_or_si256(bit0, bit1);
+}
+
+/// Splits 4 bytes into the 32 bits they hold
+CUTLASS_HOST_TARGET_AVX2
+inline __m256i unpack_load_avx2(uint8_t const *src, std::integral_constant<int, 1>) {
+  int32_t bits;
+  std::memcpy(&bits, src, sizeof(bits));
+  __m256i x = _mm256_shuffle_epi8(_mm256_set1_epi32(bits), _mm256_setr_epi8(
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+  __m256i mask = _mm256_set1_epi64x(int64_t(0x8040201008040201ull));
+  return _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(x, mask), mask), _mm256_set1_epi8(1));
+}
+
+/// Unpacks 32 elements at a time. Returns the number of elements unpacked.
+template <int Bits, bool Signed, typename Value>
+CUTLASS_HOST_TARGET_AVX2
+inline int64_t unpack_array_avx2(Value *dst, uint8_t const *src, int64_t count) {
+  int64_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i x = unpack_load_avx2(src + i * Bits / 8, std::integral_constant<int, Bits>());
+    if (Signed) {
+      __m256i sign = _mm256_set1_epi8(int8_t(1 << (Bits - 1)));
+      x = _mm256_sub_epi8(_mm256_xor_si256(x, sign), sign);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), x);
+  }
+  return i;
+}
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Packs 'count' values of int8_t or uint8_t into a sub-byte array starting at its first element.
+/// Values are stored modulo 2^Bits, or clamped to the range of the element type if 'Saturate' is
+/// set. Bits of a final, partially written byte which belong to other elements are unchanged.
+template <bool Saturate, typename Element, typename Value>
+void pack_array(Element *dst, Value const *src, int64_t count) {
+
+  static_assert(std::is_same<Value, int8_t>::value || std::is_same<Value, uint8_t>::value,
+    "Packed values must be int8_t or uint8_t");
+
+  using Traits = PackArrayElement<Element>;
+  int const kBits = Traits::kBits;
+  int const kPerByte = 8 / kBits;
+
+  uint8_t *bytes = reinterpret_cast<uint8_t *>(dst);
+  int64_t i = 0;
+
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = pack_array_avx2<kBits, Traits::kSigned, Saturate>(bytes, src, count);
+  }
+#endif
+
+  for (; i + kPerByte <= count; i += kPerByte) {
+    uint8_t byte = 0;
+    for (int j = 0; j < kPerByte; ++j) {
+      byte = uint8_t(byte | (pack_value<kBits, Traits::kSigned, Saturate>(src[i + j]) << (j * kBits)));
+    }
+    bytes[i / kPerByte] = byte;
+  }
+
+  if (i < count) {
+    uint8_t byte = bytes[i / kPerByte];
+    for (int j = 0; i + j < count; ++j) {
+      byte = uint8_t((byte & ~(((1 << kBits) - 1) << (j * kBits))) |
+        (pack_value<kBits, Traits::kSigned, Saturate>(src[i + j]) << (j * kBits)));
+    }
+    bytes[i / kPerByte] = byte;
+  }
+}
+
+/// Unpacks 'count' elements of a sub-byte array starting at its first element
+template <typename Element>
+void unpack_array(
+  typename PackArrayElement<Element>::Unpacked *dst, Element const *src, int64_t count) {
+
+  using Traits = PackArrayElement<Element>;
+  using Unpacked = typename Traits::Unpacked;
+  int const kBits = Traits::kBits;
+  int const kPerByte = 8 / kBits;
+
+  uint8_t const *bytes = reinterpret_cast<uint8_t const *>(src);
+  int64_t i = 0;
+
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    i = unpack_array_avx2<kBits, Traits::kSigned>(dst, bytes, count);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    int bits = (bytes[i / kPerByte] >> ((i % kPerByte) * kBits)) & ((1 << kBits) - 1);
+    dst[i] = Unpacked(unpack_value<kBits, Traits::kSigned>(bits));
+  }
+}
+
+/// Stores 'value' to 'count' elements of a sub-byte array starting at its first element
+template <typename Element>
+void fill_packed_array(Element *dst, Element value, int64_t count) {
+
+  using Traits = PackArrayElement<Element>;
+  int const kPerByte = 8 / Traits::kBits;
+
+  typename Traits::Unpacked pattern[kPerByte];
+  for (int j = 0; j < kPerByte; ++j) {
+    pattern[j] = Traits::value(value);
+  }
+
+  uint8_t byte;
+  pack_array<false>(reinterpret_cast<Element *>(&byte), pattern, kPerByte);
+
+  int64_t bytes = count / kPerByte;
+  std::memset(dst, byte, size_t(bytes));
+  pack_array<false>(packed_array_advance(dst, bytes * kPerByte), pattern, count - bytes * kPerByte);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Updates elements of a tensor view of sub-byte elements in parallel. The tensor's storage is
+/// unpacked into a buffer of bytes, 'func(ptr, coord)' stores the unpacked value of the element
+/// at 'coord' to '*ptr' from any thread, and the buffer is packed again.
+template <typename Element, typename Layout, typename Func>
+void tensor_update_packed(TensorView<Element, Layout> const &view, Func const &func) {
+
+  using Traits = PackArrayElement<Element>;
+  using Unpacked = typename Traits::Unpacked;
+
+  int64_t capacity = int64_t(view.capacity());
+  std::vector<Unpacked> buffer(static_cast<size_t>(capacity));
+
+  Unpacked *buffer_ptr = buffer.data();
+  Element *ptr = view.data();
+
+  // Elements outside the view are preserved
+  if (capacity != int64_t(view.size())) {
+    packed_for_range(capacity, [&](int64_t begin, int64_t end) {
+      unpack_array(buffer_ptr + begin, packed_array_advance(ptr, begin), end - begin);
+    });
+  }
+
+  Layout layout = view.layout();
+
+  auto update = [&](Coord<Layout::kRank> const &coord) {
+    func(buffer_ptr + layout(coord), coord);
+  };
+
+  TensorForEach(view.extent(), update, TensorForEachPolicy::kParallel);
+
+  packed_for_range(capacity, [&](int64_t begin, int64_t end) {
+    pack_array<false>(packed_array_advance(ptr, begin), buffer_ptr + begin, end - begin);
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,158 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Counter-based Philox-4x32-10 random number generator for host-side reference code.
+
+    Every random value is a pure function of (seed, subsequence, position), so tensors may be
+    filled in any order and by any number of threads with identical results. Counters and keys are
+    laid out as in cuRAND's curandStatePhilox4_32_10_t after curand_init(seed, subsequence, 0),
+    and uniform values are formed from the 32-bit outputs as curand_uniform() and
+    curand_uniform_double() form them.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Philox-4x32 block function of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"
+struct Philox4x32 {
+
+  static uint32_t const kMultiplier0 = 0xD2511F53u;
+  static uint32_t const kMultiplier1 = 0xCD9E8D57u;
+  static uint32_t const kWeyl0 = 0x9E3779B9u;
+  static uint32_t const kWeyl1 = 0xBB67AE85u;
+
+  static int const kRounds = 10;
+
+  /// Replaces the counter 'ctr' by its image under the key 'key'
+  static void apply(uint32_t ctr[4], uint32_t const key_in[2]) {
+
+    uint32_t key[2] = {key_in[0], key_in[1]};
+
+    for (int round = 0; round < kRounds; ++round) {
+
+      uint64_t product0 = uint64_t(kMultiplier0) * ctr[0];
+      uint64_t product1 = uint64_t(kMultiplier1) * ctr[2];
+
+      uint32_t x = uint32_t(product1 >> 32) ^ ctr[1] ^ key[0];
+      uint32_t y = uint32_t(product1);
+      uint32_t z = uint32_t(product0 >> 32) ^ ctr[3] ^ key[1];
+      uint32_t w = uint32_t(product0);
+
+      ctr[0] = x;
+      ctr[1] = y;
+      ctr[2] = z;
+      ctr[3] = w;
+
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Sequence of 32-bit random values identified by a seed and a subsequence. Host reference fills
+/// use the linear index of each element as its subsequence.
+class PhiloxStream {
+
+  uint32_t ctr_[4];
+  uint32_t key_[2];
+  uint32_t output_[4];
+  int position_;
+
+  /// Computes the outputs of the current counter
+  void generate() {
+    for (int i = 0; i < 4; ++i) {
+      output_[i] = ctr_[i];
+    }
+    Philox4x32::apply(output_, key_);
+    position_ = 0;
+  }
+
+public:
+
+  PhiloxStream(uint64_t seed, uint64_t subsequence) {
+    key_[0] = uint32_t(seed);
+    key_[1] = uint32_t(seed >> 32);
+    ctr_[0] = 0;
+    ctr_[1] = 0;
+    ctr_[2] = uint32_t(subsequence);
+    ctr_[3] = uint32_t(subsequence >> 32);
+    generate();
+  }
+
+  /// Returns the next 32-bit value
+  uint32_t operator()() {
+
+    if (position_ == 4) {
+
+      // Advance the low 64 bits of the counter
+      if (++ctr_[0] == 0) {
+        ++ctr_[1];
+      }
+      generate();
+    }
+
+    return output_[position_++];
+  }
+
+  /// Returns a float uniformly distributed in (0, 1]
+  float uniform() {
+    float const kScale = 2.3283064365386963e-10f;   // 2^-32
+    return float((*this)()) * kScale + kScale * 0.5f;
+  }
+
+  /// Returns a double uniformly distributed in (0, 1) with 53 random bits
+  double uniform_double() {
+    double const kScale = 1.1102230246251565e-16;   // 2^-53
+    uint64_t x = (*this)();
+    uint64_t y = (*this)();
+    uint64_t z = x ^ (y << (53 - 32));
+    return double(z) * kScale + kScale * 0.5;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
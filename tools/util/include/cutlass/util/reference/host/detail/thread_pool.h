@@ -0,0 +1,281 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Thread pool used to parallelize host-side reference implementations.
+
+    The number of worker threads defaults to the hardware concurrency and may be overridden with
+    the CUTLASS_HOST_REFERENCE_THREADS environment variable. Setting it to 1 runs every host
+    reference kernel on the calling thread.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Pool of persistent worker threads executing independent work items.
+///
+/// Work items are claimed dynamically by the workers and by the calling thread, so unevenly sized
+/// items are balanced automatically. Nested calls issued from within a work item, or calls issued
+/// while another thread owns the pool, execute serially on the calling thread.
+class ThreadPool {
+public:
+
+  /// Function invoked once per work item
+  using WorkFunction = std::function<void(int64_t)>;
+
+private:
+
+  /// Work submitted by a single call to parallel_for()
+  struct Job {
+    WorkFunction const *func;
+    int64_t count;
+    std::atomic<int64_t> next;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    Job(WorkFunction const *func_, int64_t count_): func(func_), count(count_), next(0) { }
+
+    /// Claims and executes work items until none remain
+    void run() {
+      int64_t idx;
+      while ((idx = next.fetch_add(1)) < count) {
+        try {
+          (*func)(idx);
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          next.store(count);
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers_;
+  std::mutex dispatch_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  Job *job_;
+  uint64_t generation_;
+  int busy_;
+  bool stop_;
+
+  /// True while the current thread executes a work item
+  static bool &inside_work_item() {
+    static thread_local bool inside = false;
+    return inside;
+  }
+
+  /// Main loop of each worker thread
+  void worker_loop() {
+    inside_work_item() = true;
+    uint64_t seen = 0;
+
+    while (true) {
+      Job *job = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) {
+          return;
+        }
+        seen = generation_;
+        job = job_;
+      }
+
+      job->run();
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busy_ == 0) {
+          done_.notify_one();
+        }
+      }
+    }
+  }
+
+  explicit ThreadPool(int thread_count): job_(nullptr), generation_(0), busy_(0), stop_(false) {
+    for (int i = 1; i < thread_count; ++i) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+public:
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /// Number of threads requested through the environment or reported by the hardware
+  static int default_thread_count() {
+    if (char const *env = std::getenv("CUTLASS_HOST_REFERENCE_THREADS")) {
+      int count = std::atoi(env);
+      if (count > 0) {
+        return count;
+      }
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
+  /// Returns the process-wide pool
+  static ThreadPool &instance() {
+    static ThreadPool pool(default_thread_count());
+    return pool;
+  }
+
+  /// Number of threads executing work items, including the calling thread
+  int thread_count() const {
+    return static_cast<int>(workers_.size()) + 1;
+  }
+
+  /// Calls func(idx) for each idx in [0, count). Returns once all work items have completed and
+  /// rethrows the first exception raised by any of them.
+  void run(int64_t count, WorkFunction const &func) {
+
+    if (count <= 0) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> dispatch(dispatch_mutex_, std::defer_lock);
+
+    if (count == 1 || workers_.empty() || inside_work_item() || !dispatch.try_lock()) {
+      for (int64_t idx = 0; idx < count; ++idx) {
+        func(idx);
+      }
+      return;
+    }
+
+    Job job(&func, count);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      busy_ = static_cast<int>(workers_.size());
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    inside_work_item() = true;
+    job.run();
+    inside_work_item() = false;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [&] { return busy_ == 0; });
+      job_ = nullptr;
+    }
+
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Number of threads available to host reference kernels
+inline int host_thread_count() {
+  return ThreadPool::instance().thread_count();
+}
+
+/// Calls func(idx) for each idx in [0, count) using the host thread pool.
+template <typename Func>
+void parallel_for(int64_t count, Func &&func) {
+  ThreadPool::WorkFunction work(std::forward<Func>(func));
+  ThreadPool::instance().run(count, work);
+}
+
+/// Partitions [0, count) into contiguous ranges of at least min_chunk elements and calls
+/// func(begin, end) for each range using the host thread pool.
+template <typename Func>
+void parallel_for_range(int64_t count, int64_t min_chunk, Func &&func) {
+
+  if (count <= 0) {
+    return;
+  }
+
+  min_chunk = std::max<int64_t>(min_chunk, 1);
+
+  // Over-decompose to balance ranges of unequal cost
+  int64_t chunks = std::min<int64_t>(
+    (count + min_chunk - 1) / min_chunk,
+    int64_t(host_thread_count()) * 4);
+
+  if (chunks <= 1) {
+    func(int64_t(0), count);
+    return;
+  }
+
+  int64_t chunk_size = (count + chunks - 1) / chunks;
+  chunks = (count + chunk_size - 1) / chunk_size;
+
+  parallel_for(chunks, [&](int64_t chunk) {
+    int64_t begin = chunk * chunk_size;
+    func(begin, std::min(begin + chunk_size, count));
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,220 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Transposition of tiles of contiguous rows in host-side code.
+
+    Tiles of 16-bit and 32-bit elements are transposed in registers eight by eight. Elements are
+    moved without interpretation, so the result is identical to element-wise assignment.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "cutlass/util/reference/host/detail/cpu_features.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if CUTLASS_HOST_SIMD_X86
+
+/// Transposes an 8-by-8 tile of 32-bit elements: dst[i * ldd + j] = src[j * lds + i]
+CUTLASS_HOST_TARGET_AVX2
+inline void transpose_8x8_b32_avx2(uint32_t *dst, int64_t ldd, uint32_t const *src, int64_t lds) {
+
+  __m256 r0 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 0 * lds));
+  __m256 r1 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 1 * lds));
+  __m256 r2 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 2 * lds));
+  __m256 r3 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 3 * lds));
+  __m256 r4 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 4 * lds));
+  __m256 r5 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 5 * lds));
+  __m256 r6 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 6 * lds));
+  __m256 r7 = _mm256_loadu_ps(reinterpret_cast<float const *>(src + 7 * lds));
+
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+  __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 0 * ldd), _mm256_permute2f128_ps(u0, u4, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 1 * ldd), _mm256_permute2f128_ps(u1, u5, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 2 * ldd), _mm256_permute2f128_ps(u2, u6, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 3 * ldd), _mm256_permute2f128_ps(u3, u7, 0x20));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 4 * ldd), _mm256_permute2f128_ps(u0, u4, 0x31));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 5 * ldd), _mm256_permute2f128_ps(u1, u5, 0x31));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 6 * ldd), _mm256_permute2f128_ps(u2, u6, 0x31));
+  _mm256_storeu_ps(reinterpret_cast<float *>(dst + 7 * ldd), _mm256_permute2f128_ps(u3, u7, 0x31));
+}
+
+/// Transposes an 8-by-8 tile of 16-bit elements: dst[i * ldd + j] = src[j * lds + i]
+CUTLASS_HOST_TARGET_AVX2
+inline void transpose_8x8_b16_avx2(uint16_t *dst, int64_t ldd, uint16_t const *src, int64_t lds) {
+
+  __m128i a[8];
+  for (int k = 0; k < 8; ++k) {
+    a[k] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + k * lds));
+  }
+
+  __m128i b0 = _mm_unpacklo_epi16(a[0], a[1]);
+  __m128i b1 = _mm_unpackhi_epi16(a[0], a[1]);
+  __m128i b2 = _mm_unpacklo_epi16(a[2], a[3]);
+  __m128i b3 = _mm_unpackhi_epi16(a[2], a[3]);
+  __m128i b4 = _mm_unpacklo_epi16(a[4], a[5]);
+  __m128i b5 = _mm_unpackhi_epi16(a[4], a[5]);
+  __m128i b6 = _mm_unpacklo_epi16(a[6], a[7]);
+  __m128i b7 = _mm_unpackhi_epi16(a[6], a[7]);
+
+  __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+  __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+  __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+  __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+  __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+  __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+  __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+  __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 0 * ldd), _mm_unpacklo_epi64(c0, c4));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 1 * ldd), _mm_unpackhi_epi64(c0, c4));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * ldd), _mm_unpacklo_epi64(c1, c5));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 3 * ldd), _mm_unpackhi_epi64(c1, c5));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 4 * ldd), _mm_unpacklo_epi64(c2, c6));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 5 * ldd), _mm_unpackhi_epi64(c2, c6));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 6 * ldd), _mm_unpacklo_epi64(c3, c7));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 7 * ldd), _mm_unpackhi_epi64(c3, c7));
+}
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Transposes the elements of [row_begin, rows) x [0, cols) and of [0, row_begin) x [col_begin, cols)
+template <typename T>
+void transpose_tile_remainder(
+  T *dst, int64_t ldd, T const *src, int64_t lds,
+  int rows, int cols, int row_begin, int col_begin) {
+
+  for (int i = 0; i < rows; ++i) {
+    for (int j = (i < row_begin ? col_begin : 0); j < cols; ++j) {
+      dst[i * ldd + j] = src[j * lds + i];
+    }
+  }
+}
+
+/// Transposes a tile of elements of any size
+template <typename T, typename Size>
+void transpose_tile(T *dst, int64_t ldd, T const *src, int64_t lds, int rows, int cols, Size) {
+  transpose_tile_remainder(dst, ldd, src, lds, rows, cols, 0, 0);
+}
+
+/// Transposes a tile of 32-bit elements
+template <typename T>
+void transpose_tile(
+  T *dst, int64_t ldd, T const *src, int64_t lds, int rows, int cols,
+  std::integral_constant<int, 4>) {
+
+  int row_begin = 0;
+  int col_begin = 0;
+
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    row_begin = rows & ~7;
+    col_begin = cols & ~7;
+    for (int i = 0; i < row_begin; i += 8) {
+      for (int j = 0; j < col_begin; j += 8) {
+        transpose_8x8_b32_avx2(
+          reinterpret_cast<uint32_t *>(dst + i * ldd + j), ldd,
+          reinterpret_cast<uint32_t const *>(src + j * lds + i), lds);
+      }
+    }
+  }
+#endif
+
+  transpose_tile_remainder(dst, ldd, src, lds, rows, cols, row_begin, col_begin);
+}
+
+/// Transposes a tile of 16-bit elements
+template <typename T>
+void transpose_tile(
+  T *dst, int64_t ldd, T const *src, int64_t lds, int rows, int cols,
+  std::integral_constant<int, 2>) {
+
+  int row_begin = 0;
+  int col_begin = 0;
+
+#if CUTLASS_HOST_SIMD_X86
+  if (CpuFeatures::instance().avx2) {
+    row_begin = rows & ~7;
+    col_begin = cols & ~7;
+    for (int i = 0; i < row_begin; i += 8) {
+      for (int j = 0; j < col_begin; j += 8) {
+        transpose_8x8_b16_avx2(
+          reinterpret_cast<uint16_t *>(dst + i * ldd + j), ldd,
+          reinterpret_cast<uint16_t const *>(src + j * lds + i), lds);
+      }
+    }
+  }
+#endif
+
+  transpose_tile_remainder(dst, ldd, src, lds, rows, cols, row_begin, col_begin);
+}
+
+/// Transposes a rows-by-cols tile: dst[i * ldd + j] = src[j * lds + i]
+template <typename T>
+void transpose_tile(T *dst, int64_t ldd, T const *src, int64_t lds, int rows, int cols) {
+  transpose_tile(dst, ldd, src, lds, rows, cols, std::integral_constant<int, int(sizeof(T))>());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace host
+} // namespace reference
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,336 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Reference implementation for Blocked-Ellpack (ELL) block-sparse GEMM in host-side code.
+
+    Operand A is consumed in the Blocked-ELL format used by the device EllGemm: an ellValue matrix
+    of a_rows-by-ell_num_columns elements holding the stored blocks of each block row, and an
+    ellColInd matrix holding the block column of each stored block, or -1 for padding. Only stored
+    blocks are multiplied.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "cutlass/coord.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/functional.h"
+#include "cutlass/numeric_conversion.h"
+
+#include "cutlass/tensor_view.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/arch/mma.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/detail/gemm_engine.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Decoder of a GEMM operand whose reduction index is gathered through a table, for use with
+/// FactoredOperand
+template <typename ComputeType, typename Load>
+struct EllGemmGather {
+
+  using IndexCoord = int;
+  using ReductionCoord = int;
+
+  Load load;
+  int const *reduction_map;
+
+  int index(int idx) const {
+    return idx;
+  }
+
+  int reduction(int k) const {
+    return reduction_map[k];
+  }
+
+  ComputeType operator()(int idx, int k) const {
+    return load(idx, k);
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a general matrix product whose operand A is stored in the Blocked-ELL format.
+/// 'problem_size' is the extent of the uncompressed problem, tensor_a is the ellValue matrix of
+/// problem_size.m()-by-ell_num_columns elements, and ell_idx holds the block column of each stored
+/// block.
+///
+/// Stored blocks of each block row are accumulated in increasing order of their block column with
+/// the same arithmetic as a dense GEMM of the uncompressed operand, which produces identical
+/// results whenever B is finite. Block columns of a block row must be distinct, and M must be a
+/// multiple of ell_blocksize.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ElementIdx,
+  typename LayoutIdx,
+  typename InnerProductOp = multiply_add<ComputeType>,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void compute_ell_gemm(
+  gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementIdx, LayoutIdx> ell_idx,
+  int ell_num_columns,
+  int ell_blocksize,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  TensorRef<ElementC, LayoutC> tensor_d,
+  ComputeType initial_accum) {
+
+  static_assert(
+    LayoutA::kRank == 2 &&
+    LayoutB::kRank == 2 &&
+    LayoutC::kRank == 2, "Tensors must be of rank 2");
+
+  using Microkernel = detail::GemmMicrokernel<ComputeType, InnerProductOp>;
+  using OperandA = detail::GemmOperand<ComputeType, ElementA, LayoutA, false>;
+  using OperandB = detail::GemmOperand<ComputeType, ElementB, LayoutB, true>;
+  using GatherA = detail::EllGemmGather<ComputeType, typename OperandA::Type>;
+  using GatherB = detail::EllGemmGather<ComputeType, typename OperandB::Type>;
+
+  int const M = problem_size.m();
+  int const N = problem_size.n();
+  int const K = problem_size.k();
+
+  int const block_rows = M / ell_blocksize;
+  int const block_columns = ell_num_columns / ell_blocksize;
+
+  if (block_rows <= 0 || N <= 0) {
+    return;
+  }
+
+  //
+  // Map the reduction over the stored blocks of each block row to columns of the ellValue matrix
+  // and to rows of B
+  //
+
+  std::vector<int> reduction_count(block_rows);
+  std::vector<int> reduction_a(size_t(block_rows) * ell_num_columns);
+  std::vector<int> reduction_b(size_t(block_rows) * ell_num_columns);
+
+  detail::parallel_for_range(block_rows, 1, [&](int64_t begin, int64_t end) {
+
+    std::vector<std::pair<int, int>> blocks;
+
+    for (int r = int(begin); r < int(end); ++r) {
+
+      blocks.clear();
+      for (int c = 0; c < block_columns; ++c) {
+        int idx = int(ell_idx.at(MatrixCoord(r, c)));
+        if (idx != -1) {
+          blocks.push_back(std::make_pair(idx, c));
+        }
+      }
+
+      std::sort(blocks.begin(), blocks.end());
+
+      int *map_a = reduction_a.data() + size_t(r) * ell_num_columns;
+      int *map_b = reduction_b.data() + size_t(r) * ell_num_columns;
+
+      for (size_t block = 0; block < blocks.size(); ++block) {
+        for (int i = 0; i < ell_blocksize; ++i) {
+          map_a[block * ell_blocksize + i] = blocks[block].second * ell_blocksize + i;
+          map_b[block * ell_blocksize + i] = blocks[block].first * ell_blocksize + i;
+        }
+      }
+
+      reduction_count[r] = int(blocks.size()) * ell_blocksize;
+    }
+  });
+
+  //
+  // Each block row is a dense GEMM over its stored blocks. Output tiles of every block row are
+  // computed in parallel.
+  //
+
+  // The dense engine computes small problems with InnerProductOp and larger ones with the inner
+  // kernel selected for this host. Matching its choice keeps the arithmetic of each term equal.
+  Microkernel const kernel =
+    (int64_t(M) * N * std::max(K, 1) <= detail::GemmBlocking<ComputeType>::kUnblockedVolume) ?
+      Microkernel::portable() :
+      Microkernel::get();
+
+  typename OperandA::Type load_a = OperandA::make(tensor_a);
+  typename OperandB::Type load_b = OperandB::make(tensor_b);
+
+  detail::GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp> epilogue{
+    tensor_c, tensor_d, alpha, beta};
+
+  detail::GemmTiling tiling =
+    detail::GemmTiling::make<ComputeType>(ell_blocksize, N, kernel.mr, kernel.nr, block_rows);
+
+  detail::parallel_for(block_rows * tiling.count(), [&](int64_t idx) {
+    int r = int(idx / tiling.count());
+    int64_t tile = idx % tiling.count();
+    int row_begin = r * ell_blocksize + int(tile % tiling.tiles_m) * tiling.tile_m;
+    int col_begin = int(tile / tiling.tiles_m) * tiling.tile_n;
+    int row_end = std::min(row_begin + tiling.tile_m, (r + 1) * ell_blocksize);
+    int col_end = std::min(col_begin + tiling.tile_n, N);
+
+    detail::FactoredOperand<GatherA> gather_a{
+      GatherA{load_a, reduction_a.data() + size_t(r) * ell_num_columns}};
+
+    detail::FactoredOperand<GatherB> gather_b{
+      GatherB{load_b, reduction_b.data() + size_t(r) * ell_num_columns}};
+
+    detail::gemm_tile(
+      kernel,
+      row_begin,
+      row_end,
+      col_begin,
+      col_end,
+      0,
+      reduction_count[r],
+      gather_a,
+      gather_b,
+      epilogue,
+      initial_accum);
+  });
+}
+
+/// Computes a general matrix product whose operand A is stored in the Blocked-ELL format,
+/// updating C in place
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ElementIdx,
+  typename LayoutIdx,
+  typename InnerProductOp = multiply_add<ComputeType>,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void compute_ell_gemm(
+  gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementIdx, LayoutIdx> ell_idx,
+  int ell_num_columns,
+  int ell_blocksize,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  ComputeType initial_accum) {
+
+  compute_ell_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                   ScalarType, ComputeType, ElementIdx, LayoutIdx, InnerProductOp, ConvertOp>(
+    problem_size, alpha, tensor_a, ell_idx, ell_num_columns, ell_blocksize,
+    tensor_b, beta, tensor_c, tensor_c, initial_accum);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a general matrix product whose operand A is stored in the Blocked-ELL format
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename InnerProductOp = cutlass::arch::OpMultiplyAdd
+>
+struct EllGemm;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Partial specialization for multiply-add
+template <typename ElementA, typename LayoutA, typename ElementB,
+          typename LayoutB, typename ElementC, typename LayoutC,
+          typename ScalarType, typename ComputeType>
+struct EllGemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ScalarType,
+               ComputeType, arch::OpMultiplyAdd> {
+
+  template <typename ElementIdx, typename LayoutIdx>
+  void operator()(gemm::GemmCoord problem_size, ScalarType alpha,
+                  TensorRef<ElementA, LayoutA> tensor_a,
+                  TensorRef<ElementIdx, LayoutIdx> ell_idx,
+                  int ell_num_columns, int ell_blocksize,
+                  TensorRef<ElementB, LayoutB> tensor_b, ScalarType beta,
+                  TensorRef<ElementC, LayoutC> tensor_c,
+                  ComputeType initial_accum = ComputeType(0)) {
+
+    compute_ell_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                     ScalarType, ComputeType, ElementIdx, LayoutIdx, multiply_add<ComputeType>>(
+        problem_size, alpha, tensor_a, ell_idx, ell_num_columns, ell_blocksize,
+        tensor_b, beta, tensor_c, initial_accum);
+  }
+
+  template <typename ElementIdx, typename LayoutIdx>
+  void operator()(gemm::GemmCoord problem_size, ScalarType alpha,
+                  TensorRef<ElementA, LayoutA> tensor_a,
+                  TensorRef<ElementIdx, LayoutIdx> ell_idx,
+                  int ell_num_columns, int ell_blocksize,
+                  TensorRef<ElementB, LayoutB> tensor_b, ScalarType beta,
+                  TensorRef<ElementC, LayoutC> tensor_c,
+                  TensorRef<ElementC, LayoutC> tensor_d,
+                  ComputeType initial_accum = ComputeType(0)) {
+
+    compute_ell_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                     ScalarType, ComputeType, ElementIdx, LayoutIdx, multiply_add<ComputeType>>(
+        problem_size, alpha, tensor_a, ell_idx, ell_num_columns, ell_blocksize,
+        tensor_b, beta, tensor_c, tensor_d, initial_accum);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace host
+} // namespace reference
+} // namespace cutlass
@@ -32,9 +32,15 @@
 #pragma once
 
 #include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
 #include "cutlass/util/reference/host/tensor_reduce.h"
 #include "cutlass/core_io.h"
 
@@ -42,6 +48,405 @@ namespace cutlass  {
 namespace reference {
 namespace host {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Error metrics of a computed tensor with respect to a reference tensor
+struct ErrorMetrics {
+
+  /// Number of bins of the histogram of distances in units in the last place (ULPs). Bin 0 counts
+  /// equal elements, bin i of 0 < i < kUlpBins - 1 counts distances in [2^(i-1), 2^i), and the last
+  /// bin counts larger distances and comparisons involving NaN.
+  static int const kUlpBins = 16;
+
+  int64_t count;                    ///< number of elements compared
+  double computed_sum_squares;      ///< sum of squared magnitudes of the computed elements
+  double reference_sum_squares;     ///< sum of squared magnitudes of the reference elements
+  double diff_sum_squares;          ///< sum of squared magnitudes of the differences
+  double max_abs_error;             ///< largest magnitude of a difference. NaN if any is NaN.
+  double max_rel_error;             ///< largest difference relative to a finite, nonzero reference
+  int64_t ulp_histogram[kUlpBins];  ///< distances of elements of floating-point or integer type
+  int64_t computed_nan_count;
+  int64_t computed_inf_count;
+  int64_t reference_nan_count;
+  int64_t reference_inf_count;
+
+  ErrorMetrics():
+    count(0),
+    computed_sum_squares(0), reference_sum_squares(0), diff_sum_squares(0),
+    max_abs_error(0), max_rel_error(0),
+    computed_nan_count(0), computed_inf_count(0), reference_nan_count(0), reference_inf_count(0) {
+
+    for (int bin = 0; bin < kUlpBins; ++bin) {
+      ulp_histogram[bin] = 0;
+    }
+  }
+
+  double computed_norm() const {
+    return std::sqrt(computed_sum_squares);
+  }
+
+  double reference_norm() const {
+    return std::sqrt(reference_sum_squares);
+  }
+
+  double diff_norm() const {
+    return std::sqrt(diff_sum_squares);
+  }
+
+  /// Norm of the difference relative to the norm of the reference
+  double relative_error() const {
+    return diff_norm() / reference_norm();
+  }
+
+  /// Histogram bin of a distance in ULPs
+  static int ulp_bin(uint64_t distance) {
+    int bin = 0;
+    while (distance && bin < kUlpBins - 1) {
+      distance >>= 1;
+      ++bin;
+    }
+    return bin;
+  }
+
+  /// Accumulates the metrics of another set of elements
+  void merge(ErrorMetrics const &other) {
+
+    count += other.count;
+    computed_sum_squares += other.computed_sum_squares;
+    reference_sum_squares += other.reference_sum_squares;
+    diff_sum_squares += other.diff_sum_squares;
+
+    if (other.max_abs_error > max_abs_error || std::isnan(other.max_abs_error)) {
+      max_abs_error = other.max_abs_error;
+    }
+
+    if (other.max_rel_error > max_rel_error || std::isnan(other.max_rel_error)) {
+      max_rel_error = other.max_rel_error;
+    }
+
+    for (int bin = 0; bin < kUlpBins; ++bin) {
+      ulp_histogram[bin] += other.ulp_histogram[bin];
+    }
+
+    computed_nan_count += other.computed_nan_count;
+    computed_inf_count += other.computed_inf_count;
+    reference_nan_count += other.reference_nan_count;
+    reference_inf_count += other.reference_inf_count;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Number of consecutive elements accumulated by one block of TensorErrorMetrics()
+static int64_t const kErrorMetricsBlock = (int64_t(1) << 14);
+
+/// Distance of two sign-magnitude encodings, saturating at the largest uint64_t
+template <typename Storage>
+uint64_t ulp_distance_bits(Storage lhs, Storage rhs) {
+
+  Storage const kSign = Storage(Storage(1) << (sizeof(Storage) * 8 - 1));
+
+  uint64_t lhs_magnitude = uint64_t(Storage(lhs & Storage(~kSign)));
+  uint64_t rhs_magnitude = uint64_t(Storage(rhs & Storage(~kSign)));
+
+  if ((lhs & kSign) == (rhs & kSign)) {
+    return lhs_magnitude > rhs_magnitude ? lhs_magnitude - rhs_magnitude : rhs_magnitude - lhs_magnitude;
+  }
+
+  uint64_t distance = lhs_magnitude + rhs_magnitude;
+  return distance < lhs_magnitude ? ~uint64_t(0) : distance;
+}
+
+/// Distance of two values in ULPs of their type. Comparisons involving NaN have the largest
+/// distance. 'kEnabled' is false for types without a defined distance.
+template <typename T, typename Enable = void>
+struct ErrorMetricsUlp {
+
+  static bool const kEnabled = false;
+
+  static uint64_t distance(T const &, T const &) {
+    return 0;
+  }
+};
+
+template <typename T>
+struct ErrorMetricsUlp<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+
+  static bool const kEnabled = true;
+
+  static uint64_t distance(T const &lhs, T const &rhs) {
+    return lhs > rhs ? uint64_t(lhs) - uint64_t(rhs) : uint64_t(rhs) - uint64_t(lhs);
+  }
+};
+
+template <>
+struct ErrorMetricsUlp<float> {
+
+  static bool const kEnabled = true;
+
+  static uint64_t distance(float const &lhs, float const &rhs) {
+    if (std::isnan(lhs) || std::isnan(rhs)) {
+      return ~uint64_t(0);
+    }
+    uint32_t lhs_bits;
+    uint32_t rhs_bits;
+    std::memcpy(&lhs_bits, &lhs, sizeof(float));
+    std::memcpy(&rhs_bits, &rhs, sizeof(float));
+    return ulp_distance_bits(lhs_bits, rhs_bits);
+  }
+};
+
+template <>
+struct ErrorMetricsUlp<double> {
+
+  static bool const kEnabled = true;
+
+  static uint64_t distance(double const &lhs, double const &rhs) {
+    if (std::isnan(lhs) || std::isnan(rhs)) {
+      return ~uint64_t(0);
+    }
+    uint64_t lhs_bits;
+    uint64_t rhs_bits;
+    std::memcpy(&lhs_bits, &lhs, sizeof(double));
+    std::memcpy(&rhs_bits, &rhs, sizeof(double));
+    return ulp_distance_bits(lhs_bits, rhs_bits);
+  }
+};
+
+template <>
+struct ErrorMetricsUlp<half_t> {
+
+  static bool const kEnabled = true;
+
+  static uint64_t distance(half_t const &lhs, half_t const &rhs) {
+    if (isnan(lhs) || isnan(rhs)) {
+      return ~uint64_t(0);
+    }
+    return ulp_distance_bits(lhs.raw(), rhs.raw());
+  }
+};
+
+template <>
+struct ErrorMetricsUlp<bfloat16_t> {
+
+  static bool const kEnabled = true;
+
+  static uint64_t distance(bfloat16_t const &lhs, bfloat16_t const &rhs) {
+    if (isnan(lhs) || isnan(rhs)) {
+      return ~uint64_t(0);
+    }
+    return ulp_distance_bits(lhs.raw(), rhs.raw());
+  }
+};
+
+/// Distance in ULPs of the 10-bit mantissa. Ignored mantissa bits are not compared.
+template <>
+struct ErrorMetricsUlp<tfloat32_t> {
+
+  static bool const kEnabled = true;
+
+  static uint64_t distance(tfloat32_t const &lhs, tfloat32_t const &rhs) {
+    if (isnan(lhs) || isnan(rhs)) {
+      return ~uint64_t(0);
+    }
+    uint32_t const kMask = ~uint32_t(0x1fff);
+    return ulp_distance_bits(lhs.raw() & kMask, rhs.raw() & kMask) >> 13;
+  }
+};
+
+/// Larger of the distances of the real and imaginary parts
+template <typename T>
+struct ErrorMetricsUlp<complex<T> > {
+
+  static bool const kEnabled = ErrorMetricsUlp<T>::kEnabled;
+
+  static uint64_t distance(complex<T> const &lhs, complex<T> const &rhs) {
+    return std::max(
+      ErrorMetricsUlp<T>::distance(lhs.real(), rhs.real()),
+      ErrorMetricsUlp<T>::distance(lhs.imag(), rhs.imag()));
+  }
+};
+
+/// Magnitudes and classification of elements in double precision
+template <typename T>
+struct ErrorMetricsValue {
+
+  static double magnitude(T const &x) {
+    return std::abs(double(x));
+  }
+
+  static double difference(T const &lhs, T const &rhs) {
+    return std::abs(double(lhs) - double(rhs));
+  }
+
+  static bool is_nan(T const &x) {
+    return std::isnan(double(x));
+  }
+
+  static bool is_inf(T const &x) {
+    return std::isinf(double(x));
+  }
+};
+
+template <typename T>
+struct ErrorMetricsValue<complex<T> > {
+
+  static double magnitude(complex<T> const &x) {
+    return std::hypot(double(x.real()), double(x.imag()));
+  }
+
+  static double difference(complex<T> const &lhs, complex<T> const &rhs) {
+    return std::hypot(double(lhs.real()) - double(rhs.real()), double(lhs.imag()) - double(rhs.imag()));
+  }
+
+  static bool is_nan(complex<T> const &x) {
+    return std::isnan(double(x.real())) || std::isnan(double(x.imag()));
+  }
+
+  static bool is_inf(complex<T> const &x) {
+    return !is_nan(x) && (std::isinf(double(x.real())) || std::isinf(double(x.imag())));
+  }
+};
+
+/// Accumulates the error metrics of a sequence of elements with compensated sums
+template <typename Element>
+struct ErrorMetricsFunc {
+
+  using Value = ErrorMetricsValue<Element>;
+  using Ulp = ErrorMetricsUlp<Element>;
+  using Accumulator = TensorReduceAccumulator<double, plus<double>, true>;
+
+  ErrorMetrics metrics;
+  Accumulator computed_sum_squares;
+  Accumulator reference_sum_squares;
+  Accumulator diff_sum_squares;
+  plus<double> reduce;
+
+  ErrorMetricsFunc() {
+    computed_sum_squares.init(0);
+    reference_sum_squares.init(0);
+    diff_sum_squares.init(0);
+  }
+
+  void operator()(Element const &computed, Element const &reference) {
+
+    double computed_magnitude = Value::magnitude(computed);
+    double reference_magnitude = Value::magnitude(reference);
+    double error = Value::difference(computed, reference);
+
+    computed_sum_squares.add(reduce, computed_magnitude * computed_magnitude);
+    reference_sum_squares.add(reduce, reference_magnitude * reference_magnitude);
+    diff_sum_squares.add(reduce, error * error);
+
+    if (error > metrics.max_abs_error || std::isnan(error)) {
+      metrics.max_abs_error = error;
+    }
+
+    if (reference_magnitude > 0 && reference_magnitude < HUGE_VAL) {
+      double relative = error / reference_magnitude;
+      if (relative > metrics.max_rel_error || std::isnan(relative)) {
+        metrics.max_rel_error = relative;
+      }
+    }
+
+    if (Ulp::kEnabled) {
+      ++metrics.ulp_histogram[ErrorMetrics::ulp_bin(Ulp::distance(computed, reference))];
+    }
+
+    metrics.computed_nan_count += Value::is_nan(computed);
+    metrics.computed_inf_count += Value::is_inf(computed);
+    metrics.reference_nan_count += Value::is_nan(reference);
+    metrics.reference_inf_count += Value::is_inf(reference);
+
+    ++metrics.count;
+  }
+
+  ErrorMetrics result() const {
+    ErrorMetrics r = metrics;
+    r.computed_sum_squares = computed_sum_squares.result();
+    r.reference_sum_squares = reference_sum_squares.result();
+    r.diff_sum_squares = diff_sum_squares.result();
+    return r;
+  }
+};
+
+/// Accumulates the error metrics of the elements at visited coordinates
+template <typename Element, typename Layout>
+struct ErrorMetricsCoordFunc {
+
+  TensorView<Element, Layout> computed;
+  TensorView<Element, Layout> reference;
+  ErrorMetricsFunc<Element> &func;
+
+  void operator()(Coord<Layout::kRank> const &coord) {
+    func(computed.at(coord), reference.at(coord));
+  }
+};
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes the error metrics of a computed tensor with respect to a reference tensor in a single
+/// pass. Blocks of elements are accumulated in parallel, and views packed with the same strides
+/// are read in memory order. The result does not depend on the number of threads.
+template <
+  typename Element,
+  typename Layout
+>
+ErrorMetrics TensorErrorMetrics(
+  TensorView<Element, Layout> view_computed,
+  TensorView<Element, Layout> view_reference) {
+
+  if (view_computed.extent() != view_reference.extent()) {
+    throw std::runtime_error("Tensor extents must match.");
+  }
+
+  int64_t count = view_computed.size();
+  int64_t blocks = (count + detail::kErrorMetricsBlock - 1) / detail::kErrorMetricsBlock;
+
+  bool packed = detail::tensor_reduce_packed(view_computed) &&
+    detail::tensor_reduce_packed(view_reference) &&
+    view_computed.stride() == view_reference.stride();
+
+  Element const *ptr_computed = view_computed.data();
+  Element const *ptr_reference = view_reference.data();
+
+  std::vector<ErrorMetrics> partial(static_cast<size_t>(blocks));
+
+  detail::parallel_for_range(blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t block = begin; block < end; ++block) {
+
+      int64_t block_begin = block * detail::kErrorMetricsBlock;
+      int64_t block_end = std::min(count, block_begin + detail::kErrorMetricsBlock);
+
+      detail::ErrorMetricsFunc<Element> func;
+
+      if (packed) {
+        for (int64_t idx = block_begin; idx < block_end; ++idx) {
+          func(ptr_computed[idx], ptr_reference[idx]);
+        }
+      }
+      else {
+        detail::ErrorMetricsCoordFunc<Element, Layout> coord_func{view_computed, view_reference, func};
+        detail::TensorForEachRange(coord_func, view_computed.extent(), block_begin, block_end);
+      }
+
+      partial[size_t(block)] = func.result();
+    }
+  });
+
+  ErrorMetrics metrics;
+
+  for (ErrorMetrics const &block_metrics : partial) {
+    metrics.merge(block_metrics);
+  }
+
+  return metrics;
+}
+
 /// Helper to compute the relative error metric for tensor A_computed  w.r.t. to tensor A_reference
 template <
   typename Element,
@@ -54,8 +459,10 @@ ComputeType TensorRelativeErrorMetric(
   ComputeType identity = ComputeType()
 ) {
 
-  return cutlass::reference::host::TensorNormDiff(view_A_computed, view_B_reference, identity) /
-   cutlass::reference::host::TensorNorm(view_B_reference, identity);
+  ErrorMetrics metrics = TensorErrorMetrics(view_A_computed, view_B_reference);
+
+  return ComputeType(std::sqrt(double(identity) + metrics.diff_sum_squares)) /
+    ComputeType(std::sqrt(double(identity) + metrics.reference_sum_squares));
 }
 
 
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "cutlass/coord.h"
 #include "cutlass/numeric_types.h"
 #include "cutlass/functional.h"
@@ -42,7 +44,9 @@
 #include "cutlass/tensor_view.h"
 #include "cutlass/gemm/gemm.h"
 #include "cutlass/arch/mma.h"
+#include "cutlass/layout/matrix.h"
 #include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/detail/gemm_engine.h"
 
 namespace cutlass {
 namespace reference {
@@ -79,6 +83,113 @@ Out cast_if_scalar(In in) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Converts an element of a GEMM operand to the compute type
+template <typename ComputeType, typename Element>
+struct GemmOperandCast {
+  ComputeType operator()(Element const &x) const {
+    return ComputeType(cast_if_scalar<ComputeType>(x));
+  }
+};
+
+/// Element strides of a matrix along its rows and columns
+template <typename Layout>
+struct GemmOperandStrides;
+
+template <>
+struct GemmOperandStrides<layout::ColumnMajor> {
+  static int64_t row(layout::ColumnMajor const &) { return 1; }
+  static int64_t column(layout::ColumnMajor const &layout) { return layout.stride(0); }
+};
+
+template <>
+struct GemmOperandStrides<layout::RowMajor> {
+  static int64_t row(layout::RowMajor const &layout) { return layout.stride(0); }
+  static int64_t column(layout::RowMajor const &) { return 1; }
+};
+
+/// Loads an element of a GEMM operand through TensorRef::at(). Operand A is addressed as
+/// (row, k) and operand B, which is transposed, as (column, k).
+template <typename ComputeType, typename Element, typename Layout, bool kTransposed, typename Convert>
+struct GemmOperandRef {
+
+  TensorRef<Element, Layout> ref;
+  Convert convert;
+
+  ComputeType operator()(int idx, int k) const {
+    Element x = ref.at(kTransposed ? MatrixCoord(k, idx) : MatrixCoord(idx, k));
+    return convert(x);
+  }
+};
+
+/// Constructs the loader for a GEMM operand. Operands of at least eight bits in a row-major or
+/// column-major layout are addressed directly so that packing converts contiguous runs in bulk.
+template <
+  typename ComputeType,
+  typename Element,
+  typename Layout,
+  bool kTransposed,
+  typename Convert = GemmOperandCast<ComputeType, typename platform::remove_const<Element>::type>,
+  bool kDense = (sizeof_bits<typename platform::remove_const<Element>::type>::value >= 8)
+>
+struct GemmOperand {
+
+  using Type = GemmOperandRef<ComputeType, Element, Layout, kTransposed, Convert>;
+
+  static Type make(TensorRef<Element, Layout> ref, Convert convert = Convert()) {
+    return Type{ref, convert};
+  }
+};
+
+template <typename ComputeType, typename Element, typename Layout, bool kTransposed, typename Convert>
+struct GemmOperandDense {
+
+  using Type = DenseOperand<Element, ComputeType, Convert>;
+
+  static Type make(TensorRef<Element, Layout> ref, Convert convert = Convert()) {
+    int64_t stride_row = GemmOperandStrides<Layout>::row(ref.layout());
+    int64_t stride_column = GemmOperandStrides<Layout>::column(ref.layout());
+
+    return Type{
+      ref.data(),
+      kTransposed ? stride_column : stride_row,
+      kTransposed ? stride_row : stride_column,
+      convert};
+  }
+};
+
+template <typename ComputeType, typename Element, bool kTransposed, typename Convert>
+struct GemmOperand<ComputeType, Element, layout::ColumnMajor, kTransposed, Convert, true> :
+  public GemmOperandDense<ComputeType, Element, layout::ColumnMajor, kTransposed, Convert> { };
+
+template <typename ComputeType, typename Element, bool kTransposed, typename Convert>
+struct GemmOperand<ComputeType, Element, layout::RowMajor, kTransposed, Convert, true> :
+  public GemmOperandDense<ComputeType, Element, layout::RowMajor, kTransposed, Convert> { };
+
+/// Epilogue computing D = alpha * accum + beta * C for each element of a GEMM output
+template <typename ElementC, typename LayoutC, typename ScalarType, typename ConvertOp>
+struct GemmEpilogue {
+
+  TensorRef<ElementC, LayoutC> tensor_c;
+  TensorRef<ElementC, LayoutC> tensor_d;
+  ScalarType alpha;
+  ScalarType beta;
+
+  template <typename ComputeType>
+  void operator()(int row, int col, ComputeType const &accum) const {
+    ConvertOp convert_op;
+    MatrixCoord coord = MatrixCoord(row, col);
+    tensor_d.at(coord) = convert_op(
+      alpha * ScalarType(accum) +
+      beta * ScalarType(tensor_c.at(coord)));
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
 template <
@@ -114,59 +225,14 @@ void compute_gemm(
   int const N = problem_size.n();
   int const K = problem_size.k();
 
-  // Blocking necessary to speedup reference implementation
-  int const Mblock = 16;
-  int const Nblock = 16;
-
-  ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-
-  for (int row_block = 0; row_block < M; row_block += Mblock) {
-    for (int col_block = 0; col_block < N; col_block += Nblock) {
-
-      ComputeType accum[Mblock][Nblock];
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          accum[i][j] = initial_accum;
-        }
-      }
-
-      for (int k_block = 0; k_block < K; ++k_block) {
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
-
-            if (row < M && col < N) {
-              ElementA a = tensor_a.at(MatrixCoord(row, k_block));
-              ElementB b = tensor_b.at(MatrixCoord(k_block, col));
-
-              ComputeType compute_a(cast_if_scalar<ComputeType>(a));
-              ComputeType compute_b(cast_if_scalar<ComputeType>(b));
-
-              accum[i][j] = inner_product_op(compute_a, compute_b, accum[i][j]);
-            }
-          }
-        }
-      }
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          int row = row_block + i;
-          int col = col_block + j;
-
-          MatrixCoord coord = MatrixCoord(row, col);
-
-          if (row < M && col < N) {
-            tensor_d.at(coord) = convert_op(
-              alpha * ScalarType(accum[i][j]) +
-              beta * ScalarType(tensor_c.at(coord)));
-          }
-        }
-      }
-    }
-  }
+  // Operands are converted to ComputeType once while packing, and output tiles are computed
+  // in parallel by the host GEMM engine.
+  detail::gemm_engine<ComputeType, InnerProductOp>(
+    M, N, K,
+    detail::GemmOperand<ComputeType, ElementA, LayoutA, false>::make(tensor_a),
+    detail::GemmOperand<ComputeType, ElementB, LayoutB, true>::make(tensor_b),
+    detail::GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp>{tensor_c, tensor_d, alpha, beta},
+    initial_accum);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -378,6 +444,150 @@ struct Gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ScalarType,
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Computes a batch of GEMMs of common dimension whose operands are given for each problem by
+///
+///   refs_a(batch) -> TensorRef<ElementA, LayoutA>
+///   refs_b(batch) -> TensorRef<ElementB, LayoutB>
+///   refs_c(batch) -> TensorRef<ElementC, LayoutC>
+///   refs_d(batch) -> TensorRef<ElementC, LayoutC>
+///
+/// Output tiles of all problems are computed in parallel by the host GEMM engine.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename InnerProductOp,
+  typename ConvertOp,
+  typename RefsA,
+  typename RefsB,
+  typename RefsC,
+  typename RefsD
+>
+void compute_gemm_batched(
+  gemm::GemmCoord problem_size,
+  int batch_count,
+  ScalarType alpha,
+  RefsA const &refs_a,
+  RefsB const &refs_b,
+  ScalarType beta,
+  RefsC const &refs_c,
+  RefsD const &refs_d,
+  ComputeType initial_accum) {
+
+  using OperandA = GemmOperand<ComputeType, ElementA, LayoutA, false>;
+  using OperandB = GemmOperand<ComputeType, ElementB, LayoutB, true>;
+  using Epilogue = GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp>;
+
+  gemm_engine_batched<ComputeType, InnerProductOp>(
+    batch_count,
+    problem_size.m(),
+    problem_size.n(),
+    problem_size.k(),
+    [&](int batch) -> typename OperandA::Type {
+      return OperandA::make(refs_a(batch));
+    },
+    [&](int batch) -> typename OperandB::Type {
+      return OperandB::make(refs_b(batch));
+    },
+    [&](int batch) -> Epilogue {
+      return Epilogue{refs_c(batch), refs_d(batch), alpha, beta};
+    },
+    initial_accum);
+}
+
+/// Offsets a TensorRef by a constant stride for each problem of a batch
+template <typename Element, typename Layout>
+struct GemmBatchStrided {
+
+  TensorRef<Element, Layout> ref;
+  int64_t batch_stride;
+
+  TensorRef<Element, Layout> operator()(int batch) const {
+    TensorRef<Element, Layout> batch_ref = ref;
+    batch_ref.add_pointer_offset(batch * batch_stride);
+    return batch_ref;
+  }
+};
+
+/// Indexes TensorRefs gathered from a TensorRefCollection
+template <typename Element, typename Layout>
+struct GemmBatchGathered {
+
+  std::vector<TensorRef<Element, Layout>> refs;
+
+  template <typename TensorRefCollection>
+  GemmBatchGathered(TensorRefCollection const &collection, int batch_count) {
+    typename TensorRefCollection::ConstIterator it = collection.begin();
+    for (int batch = 0; batch < batch_count; ++batch, ++it) {
+      refs.push_back(*it);
+    }
+  }
+
+  TensorRef<Element, Layout> operator()(int batch) const {
+    return refs[batch];
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a batch of GEMMs over matrices of common dimension separated in memory by a constant
+/// stride for each operand. The (batch, tile) work items of all problems are distributed across
+/// the host threads, and small problems are computed without blocking.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename InnerProductOp = multiply_add<ComputeType>,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void BatchedGemm(
+  gemm::GemmCoord problem_size,
+  int batch_count,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  int64_t batch_stride_A,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  int64_t batch_stride_B,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  int64_t batch_stride_C,
+  TensorRef<ElementC, LayoutC> tensor_d,
+  int64_t batch_stride_D,
+  ComputeType initial_accum) {
+
+  static_assert(
+    LayoutA::kRank == 2 &&
+    LayoutB::kRank == 2 &&
+    LayoutC::kRank == 2, "Tensors must be of rank 2");
+
+  detail::compute_gemm_batched<
+    ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+    ScalarType, ComputeType, InnerProductOp, ConvertOp>(
+      problem_size,
+      batch_count,
+      alpha,
+      detail::GemmBatchStrided<ElementA, LayoutA>{tensor_a, batch_stride_A},
+      detail::GemmBatchStrided<ElementB, LayoutB>{tensor_b, batch_stride_B},
+      beta,
+      detail::GemmBatchStrided<ElementC, LayoutC>{tensor_c, batch_stride_C},
+      detail::GemmBatchStrided<ElementC, LayoutC>{tensor_d, batch_stride_D},
+      initial_accum);
+}
+
 /// Computes a batch of GEMMs over a set of matrices of common dimension.
 //
 // TensorRefCollection* is a type satisfying the TensorRefCollection concept.
@@ -399,27 +609,30 @@ void BatchedGemm(
   TensorRefCollectionC &tensor_c,
   AccumulatorType initial_accum) {
 
-  typename TensorRefCollectionA::ConstIterator tensor_a_it = tensor_a.begin();
-  typename TensorRefCollectionB::ConstIterator tensor_b_it = tensor_b.begin();
-  typename TensorRefCollectionC::ConstIterator tensor_c_it = tensor_c.begin();
-
-  for (int batch = 0;
-    batch < batch_count;
-    ++batch, ++tensor_a_it, ++tensor_b_it, ++tensor_c_it) {
-    
-    Gemm<typename TensorRefCollectionA::Element,
-         typename TensorRefCollectionA::Layout,
-         typename TensorRefCollectionB::Element,
-         typename TensorRefCollectionB::Layout,
-         typename TensorRefCollectionC::Element,
-         typename TensorRefCollectionC::Layout,
-         typename TensorRefCollectionC::Element,
-         typename TensorRefCollectionC::Element>
-        gemm;
-
-    gemm(problem_size, alpha, *tensor_a_it, *tensor_b_it, beta, *tensor_c_it,
-         initial_accum);
-  }
+  using ElementA = typename TensorRefCollectionA::Element;
+  using LayoutA = typename TensorRefCollectionA::Layout;
+  using ElementB = typename TensorRefCollectionB::Element;
+  using LayoutB = typename TensorRefCollectionB::Layout;
+  using ElementC = typename TensorRefCollectionC::Element;
+  using LayoutC = typename TensorRefCollectionC::Layout;
+
+  // Problems are gathered from the collections up front so that they may be computed in parallel
+  detail::GemmBatchGathered<ElementA, LayoutA> refs_a(tensor_a, batch_count);
+  detail::GemmBatchGathered<ElementB, LayoutB> refs_b(tensor_b, batch_count);
+  detail::GemmBatchGathered<ElementC, LayoutC> refs_c(tensor_c, batch_count);
+
+  detail::compute_gemm_batched<
+    ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+    ElementC, ElementC, multiply_add<ElementC>, NumericConverter<ElementC, ElementC>>(
+      problem_size,
+      batch_count,
+      ElementC(alpha),
+      refs_a,
+      refs_b,
+      ElementC(beta),
+      refs_c,
+      refs_c,
+      ElementC(initial_accum));
 }
 
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
@@ -43,6 +43,7 @@
 
 #include "cutlass/tensor_view.h"
 #include "cutlass/gemm/gemm.h"
+#include "cutlass/util/reference/host/gemm.h"
 
 namespace cutlass {
 namespace reference {
@@ -50,6 +51,28 @@ namespace host {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Converts an element of a complex GEMM operand to the compute type and applies its
+/// ComplexTransform, such that packed panels hold the transformed operand.
+template <typename ComputeType, typename Element>
+struct GemmComplexOperandCast {
+
+  ComplexTransform transform;
+
+  ComputeType operator()(Element const &x) const {
+    ComputeType y = ComputeType(x);
+    if (transform == ComplexTransform::kConjugate) {
+      y = conj(y);
+    }
+    return y;
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
 ///
@@ -91,84 +114,38 @@ void GemmComplex(
     LayoutB::kRank == 2 &&
     LayoutC::kRank == 2, "Tensors must be of rank 2");
 
-  // Note: batch is ignored.
   int const M = problem_size.m();
   int const N = problem_size.n();
   int const K = problem_size.k();
 
-  // Blocking necessary to speedup reference implementation
-  int const Mblock = 16;
-  int const Nblock = 16;
-
-  ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-
-  for (int batch_idx = 0; batch_idx < batch_count; ++batch_idx) {
-
-    // Compute matrix product using blocks
-    for (int row_block = 0; row_block < M; row_block += Mblock) {
-      for (int col_block = 0; col_block < N; col_block += Nblock) {
-
-        ComputeType accum[Mblock][Nblock];
-
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            accum[i][j] = initial_accum;
-          }
-        }
-
-        for (int k_block = 0; k_block < K; ++k_block) {
-          for (int j = 0; j < Nblock; j++) {
-            for (int i = 0; i < Mblock; i++) {
-              int row = row_block + i;
-              int col = col_block + j;
-
-              if (row < M && col < N) {
-                ElementA a = tensor_a.at(MatrixCoord(row, k_block));
-                ElementB b = tensor_b.at(MatrixCoord(k_block, col));
-
-                ComputeType a_ik = ComputeType(a);
-                ComputeType b_kj = ComputeType(b);
-
-                if (transform_a == ComplexTransform::kConjugate) {
-                  a_ik = conj(a_ik);
-                }
-
-                if (transform_b == ComplexTransform::kConjugate) {
-                  b_kj = conj(b_kj);
-                }
-
-                accum[i][j] = inner_product_op(a_ik, b_kj,  accum[i][j]);
-              }
-            }
-          }
-        }
-
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
-
-            MatrixCoord coord = MatrixCoord(row, col);
-
-            if (row < M && col < N) {
-
-              tensor_d.at(coord) = convert_op(
-                alpha * ScalarType(accum[i][j]) + 
-                beta * ScalarType(tensor_c.at(coord)));
-            }
-          }
-        }
-
-      } // for (col_block)
-    } // for (row_block)
-
-    tensor_a.add_pointer_offset(batch_stride_A);
-    tensor_b.add_pointer_offset(batch_stride_B);
-    tensor_c.add_pointer_offset(batch_stride_C);
-    tensor_d.add_pointer_offset(batch_stride_D);
-
-  } // for (batch_idx)
+  using ConvertA = detail::GemmComplexOperandCast<ComputeType, ElementA>;
+  using ConvertB = detail::GemmComplexOperandCast<ComputeType, ElementB>;
+
+  using OperandA = detail::GemmOperand<ComputeType, ElementA, LayoutA, false, ConvertA>;
+  using OperandB = detail::GemmOperand<ComputeType, ElementB, LayoutB, true, ConvertB>;
+
+  // Complex transforms are applied once per element while packing, and the output tiles of all
+  // problems in the batch are computed in parallel by the host GEMM engine.
+  detail::gemm_engine_batched<ComputeType, InnerProductOp>(
+    batch_count, M, N, K,
+    [&](int batch_idx) -> typename OperandA::Type {
+      TensorRef<ElementA, LayoutA> ref_a = tensor_a;
+      ref_a.add_pointer_offset(batch_idx * batch_stride_A);
+      return OperandA::make(ref_a, ConvertA{transform_a});
+    },
+    [&](int batch_idx) -> typename OperandB::Type {
+      TensorRef<ElementB, LayoutB> ref_b = tensor_b;
+      ref_b.add_pointer_offset(batch_idx * batch_stride_B);
+      return OperandB::make(ref_b, ConvertB{transform_b});
+    },
+    [&](int batch_idx) -> detail::GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp> {
+      TensorRef<ElementC, LayoutC> ref_c = tensor_c;
+      TensorRef<ElementC, LayoutC> ref_d = tensor_d;
+      ref_c.add_pointer_offset(batch_idx * batch_stride_C);
+      ref_d.add_pointer_offset(batch_idx * batch_stride_D);
+      return {ref_c, ref_d, alpha, beta};
+    },
+    initial_accum);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
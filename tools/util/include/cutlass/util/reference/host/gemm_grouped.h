@@ -0,0 +1,164 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Reference implementation for grouped GEMM in host-side code.
+
+    Problems of a group are described by the same arrays of problem sizes, pointers and leading
+    dimensions as the arguments of cutlass::gemm::device::GemmGrouped. The output tiles of all
+    problems are scheduled together across the host threads, largest first.
+*/
+
+#pragma once
+
+#include "cutlass/coord.h"
+#include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/functional.h"
+#include "cutlass/numeric_conversion.h"
+
+#include "cutlass/tensor_ref.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/util/reference/host/gemm_complex.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes D_i = alpha * op(A_i) * op(B_i) + beta * C_i for each problem i of a group, where
+/// op() is the complex transform of each operand. Every matrix is addressed through its pointer
+/// and leading dimension, as in the arguments of the device-side grouped GEMM.
+///
+/// Each element is computed as GemmComplex() would compute it for the problem alone.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>,
+  typename InnerProductOp = multiply_add<ComputeType>
+>
+void GemmGrouped(
+  gemm::GemmCoord const *problem_sizes,
+  int problem_count,
+  ScalarType alpha,
+  ElementA * const *ptr_A,
+  int64_t const *lda,
+  ComplexTransform transform_a,
+  ElementB * const *ptr_B,
+  int64_t const *ldb,
+  ComplexTransform transform_b,
+  ScalarType beta,
+  ElementC * const *ptr_C,
+  int64_t const *ldc,
+  ElementC * const *ptr_D,
+  int64_t const *ldd,
+  ComputeType initial_accum) {
+
+  static_assert(
+    LayoutA::kRank == 2 &&
+    LayoutB::kRank == 2 &&
+    LayoutC::kRank == 2, "Tensors must be of rank 2");
+
+  using ConvertA = detail::GemmComplexOperandCast<ComputeType, ElementA>;
+  using ConvertB = detail::GemmComplexOperandCast<ComputeType, ElementB>;
+
+  using OperandA = detail::GemmOperand<ComputeType, ElementA, LayoutA, false, ConvertA>;
+  using OperandB = detail::GemmOperand<ComputeType, ElementB, LayoutB, true, ConvertB>;
+
+  detail::gemm_engine_grouped<ComputeType, InnerProductOp>(
+    problem_count,
+    problem_sizes,
+    [&](int problem) -> typename OperandA::Type {
+      TensorRef<ElementA, LayoutA> ref_a(ptr_A[problem], LayoutA(lda[problem]));
+      return OperandA::make(ref_a, ConvertA{transform_a});
+    },
+    [&](int problem) -> typename OperandB::Type {
+      TensorRef<ElementB, LayoutB> ref_b(ptr_B[problem], LayoutB(ldb[problem]));
+      return OperandB::make(ref_b, ConvertB{transform_b});
+    },
+    [&](int problem) -> detail::GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp> {
+      TensorRef<ElementC, LayoutC> ref_c(ptr_C[problem], LayoutC(ldc[problem]));
+      TensorRef<ElementC, LayoutC> ref_d(ptr_D[problem], LayoutC(ldd[problem]));
+      return {ref_c, ref_d, alpha, beta};
+    },
+    initial_accum);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes D_i = alpha * A_i * B_i + beta * C_i for each problem i of a group.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType
+>
+void GemmGrouped(
+  gemm::GemmCoord const *problem_sizes,
+  int problem_count,
+  ScalarType alpha,
+  ElementA * const *ptr_A,
+  int64_t const *lda,
+  ElementB * const *ptr_B,
+  int64_t const *ldb,
+  ScalarType beta,
+  ElementC * const *ptr_C,
+  int64_t const *ldc,
+  ElementC * const *ptr_D,
+  int64_t const *ldd,
+  ComputeType initial_accum) {
+
+  GemmGrouped<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ScalarType, ComputeType>(
+    problem_sizes, problem_count,
+    alpha,
+    ptr_A, lda, ComplexTransform::kNone,
+    ptr_B, ldb, ComplexTransform::kNone,
+    beta,
+    ptr_C, ldc,
+    ptr_D, ldd,
+    initial_accum);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace host
+} // namespace reference
+} // namespace cutlass
@@ -43,6 +43,8 @@
 
 #include "cutlass/tensor_view.h"
 #include "cutlass/gemm/gemm.h"
+#include "cutlass/arch/mma.h"
+#include "cutlass/util/reference/host/gemm.h"
 
 namespace cutlass {
 namespace reference {
@@ -50,6 +52,67 @@ namespace host {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Loads an element of a planar complex GEMM operand and applies its ComplexTransform. Operand A
+/// is addressed as (row, k) and operand B, which is transposed, as (column, k).
+template <typename ComputeType, typename Element, typename Layout, bool kTransposed>
+struct GemmPlanarComplexOperand {
+
+  TensorRefPlanarComplex<Element, Layout> ref;
+  ComplexTransform transform;
+
+  complex<ComputeType> operator()(int idx, int k) const {
+    complex<Element> x = ref.at(kTransposed ? MatrixCoord(k, idx) : MatrixCoord(idx, k));
+
+    complex<ComputeType> y{ComputeType(x.real()), ComputeType(x.imag())};
+
+    if (transform == ComplexTransform::kConjugate) {
+      y = conj(y);
+    }
+    return y;
+  }
+};
+
+/// Stores the accumulators of a real-valued GEMM into a column-major matrix
+template <typename ComputeType>
+struct GemmStoreAccumulator {
+
+  ComputeType *ptr;
+  int ldm;
+
+  void operator()(int row, int col, ComputeType const &accum) const {
+    ptr[row + int64_t(col) * ldm] = accum;
+  }
+};
+
+/// Forms the sum of the real and imaginary parts of a planar complex operand, with the imaginary
+/// part negated if the operand is conjugated, stored contiguously along its output dimension.
+template <typename ComputeType, typename Element, typename Layout, bool kTransposed>
+std::vector<ComputeType> gemm_planar_complex_sum(
+  TensorRefPlanarComplex<Element, Layout> ref,
+  ComplexTransform transform,
+  int extent,
+  int K) {
+
+  std::vector<ComputeType> sum(size_t(extent) * K);
+
+  ComputeType sign_imag = ComputeType(transform == ComplexTransform::kConjugate ? -1 : 1);
+
+  parallel_for(K, [&](int64_t k) {
+    for (int idx = 0; idx < extent; ++idx) {
+      complex<Element> x = ref.at(kTransposed ? MatrixCoord(int(k), idx) : MatrixCoord(idx, int(k)));
+      sum[size_t(k) * extent + idx] = ComputeType(x.real()) + sign_imag * ComputeType(x.imag());
+    }
+  });
+
+  return sum;
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
 ///
@@ -86,8 +149,6 @@ void GemmPlanarComplex(
     LayoutB::kRank == 2 &&
     LayoutC::kRank == 2, "Tensors must be of rank 2");
 
-  using ComplexA = typename TensorRefPlanarComplex<ElementA, LayoutA>::ComplexElement;
-  using ComplexB = typename TensorRefPlanarComplex<ElementB, LayoutB>::ComplexElement;
   using ComplexC = typename TensorRefPlanarComplex<ElementC, LayoutC>::ComplexElement;
 
   // Note: batch is ignored.
@@ -95,91 +156,162 @@ void GemmPlanarComplex(
   int const N = problem_size.n();
   int const K = problem_size.k();
 
-  // Blocking necessary to speedup reference implementation
-  int const Mblock = 16;
-  int const Nblock = 16;
-
   ConvertOp convert_op;
-  InnerProductOp inner_product_op;
 
-  for (int row_block = 0; row_block < M; row_block += Mblock) {
-    for (int col_block = 0; col_block < N; col_block += Nblock) {
+  detail::gemm_engine<complex<ComputeType>, InnerProductOp>(
+    M, N, K,
+    detail::GemmPlanarComplexOperand<ComputeType, ElementA, LayoutA, false>{tensor_a, transform_a},
+    detail::GemmPlanarComplexOperand<ComputeType, ElementB, LayoutB, true>{tensor_b, transform_b},
+    [&](int row, int col, complex<ComputeType> const &accum) {
 
-      complex<ComputeType> accum[Mblock][Nblock];
+      MatrixCoord coord = MatrixCoord(row, col);
 
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          accum[i][j] = initial_accum;
-        }
-      }
+      complex<ScalarType> acc{
+        ScalarType(accum.real()),
+        ScalarType(accum.imag())
+      };
 
-      for (int k_block = 0; k_block < K; ++k_block) {
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
+      ComplexC d_ij = tensor_c.at(coord);
 
-            if (row < M && col < N) {
+      complex<ScalarType> src{
+        ScalarType(d_ij.real()),
+        ScalarType(d_ij.imag())
+      };
 
-              ComplexA a_ik = tensor_a.at(MatrixCoord(row, k_block));
-              ComplexB b_kj = tensor_b.at(MatrixCoord(k_block, col));
+      complex<ScalarType> result = alpha * acc + beta * src;
 
-              complex<ComputeType> a = complex<ComputeType>{
-                ComputeType(a_ik.real()),
-                ComputeType(a_ik.imag())
-              };
+      d_ij.real() = convert_op(result.real());
+      d_ij.imag() = convert_op(result.imag());
 
-              complex<ComputeType> b = complex<ComputeType>{
-                ComputeType(b_kj.real()),
-                ComputeType(b_kj.imag())
-              };
+      tensor_d.at(coord) = d_ij;
+    },
+    initial_accum);
+}
 
-              if (transform_a == ComplexTransform::kConjugate) {
-                a = conj(a);
-              }
+/// Computes a planar complex GEMM as three real-valued GEMMs using the 3M (Gaussian) method.
+///
+///   T1 = Ar * Br,  T2 = Ai * Bi,  T3 = (Ar + Ai) * (Br + Bi)
+///
+///   Re(A * B) = T1 - T2,  Im(A * B) = T3 - T1 - T2
+///
+/// This performs three quarters of the real multiplications of the conventional product and uses
+/// the vectorized real-valued kernels of the host GEMM engine. Because the imaginary part is
+/// formed by subtraction, results may differ from the conventional product by rounding.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void GemmPlanarComplex(
+  gemm::GemmCoord problem_size,
+  complex<ScalarType> alpha,
+  TensorRefPlanarComplex<ElementA, LayoutA> tensor_a,
+  ComplexTransform transform_a,
+  TensorRefPlanarComplex<ElementB, LayoutB> tensor_b,
+  ComplexTransform transform_b,
+  complex<ScalarType> beta,
+  TensorRefPlanarComplex<ElementC, LayoutC> tensor_c,
+  TensorRefPlanarComplex<ElementC, LayoutC> tensor_d,
+  complex<ComputeType> initial_accum,
+  arch::OpMultiplyAddGaussianComplex) {
 
-              if (transform_b == ComplexTransform::kConjugate) {
-                b = conj(b);
-              }
+  static_assert(
+    LayoutA::kRank == 2 &&
+    LayoutB::kRank == 2 &&
+    LayoutC::kRank == 2, "Tensors must be of rank 2");
 
-              accum[i][j] = inner_product_op(a, b,  accum[i][j]);
-            }
-          }
-        }
-      }
+  using ComplexC = typename TensorRefPlanarComplex<ElementC, LayoutC>::ComplexElement;
 
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          int row = row_block + i;
-          int col = col_block + j;
+  using InnerProductOp = multiply_add<ComputeType>;
 
-          MatrixCoord coord = MatrixCoord(row, col);
+  using OperandA = detail::GemmOperand<ComputeType, ElementA, LayoutA, false>;
+  using OperandB = detail::GemmOperand<ComputeType, ElementB, LayoutB, true>;
 
-          if (row < M && col < N) {
+  using OperandSum = detail::DenseOperand<
+    ComputeType, ComputeType, detail::GemmOperandCast<ComputeType, ComputeType>>;
 
-            complex<ScalarType> acc{
-              ScalarType(accum[i][j].real()),
-              ScalarType(accum[i][j].imag())
-            };
+  int const M = problem_size.m();
+  int const N = problem_size.n();
+  int const K = problem_size.k();
 
-            ComplexC d_ij = tensor_c.at(coord);
+  if (M <= 0 || N <= 0) {
+    return;
+  }
 
-            complex<ScalarType> src{
-              ScalarType(d_ij.real()),
-              ScalarType(d_ij.imag())
-            };
+  // Conjugation negates the imaginary part of an operand. T1 and T2 are computed from the
+  // untransformed parts, and the sign of T2 is applied when the products are combined.
+  ComputeType sign_t2 = ComputeType(
+    (transform_a == ComplexTransform::kConjugate) == (transform_b == ComplexTransform::kConjugate) ? 1 : -1);
 
-            complex<ScalarType> result = alpha * acc + beta * src;
+  // T1 and T2 are computed as a batch of two real GEMMs
+  std::vector<ComputeType> products(size_t(2) * M * N);
 
-            d_ij.real() = convert_op(result.real());
-            d_ij.imag() = convert_op(result.imag());
+  typename OperandA::Type parts_a[2] = {
+    OperandA::make(tensor_a.ref_real()), OperandA::make(tensor_a.ref_imag())};
 
-            tensor_d.at(coord) = d_ij;
-          }
-        }
-      }
-    }
-  }
+  typename OperandB::Type parts_b[2] = {
+    OperandB::make(tensor_b.ref_real()), OperandB::make(tensor_b.ref_imag())};
+
+  detail::gemm_engine_batched<ComputeType, InnerProductOp>(
+    2, M, N, K,
+    [&](int part) -> typename OperandA::Type const & { return parts_a[part]; },
+    [&](int part) -> typename OperandB::Type const & { return parts_b[part]; },
+    [&](int part) -> detail::GemmStoreAccumulator<ComputeType> {
+      return {products.data() + size_t(part) * M * N, M};
+    },
+    ComputeType());
+
+  ComputeType const *t1 = products.data();
+  ComputeType const *t2 = products.data() + size_t(M) * N;
+
+  std::vector<ComputeType> sum_a =
+    detail::gemm_planar_complex_sum<ComputeType, ElementA, LayoutA, false>(tensor_a, transform_a, M, K);
+
+  std::vector<ComputeType> sum_b =
+    detail::gemm_planar_complex_sum<ComputeType, ElementB, LayoutB, true>(tensor_b, transform_b, N, K);
+
+  ConvertOp convert_op;
+
+  // T3 is computed last, and its epilogue combines the three products
+  detail::gemm_engine<ComputeType, InnerProductOp>(
+    M, N, K,
+    OperandSum{sum_a.data(), 1, M, detail::GemmOperandCast<ComputeType, ComputeType>()},
+    OperandSum{sum_b.data(), 1, N, detail::GemmOperandCast<ComputeType, ComputeType>()},
+    [&](int row, int col, ComputeType const &t3) {
+
+      MatrixCoord coord = MatrixCoord(row, col);
+
+      size_t idx = size_t(row) + size_t(col) * M;
+
+      ComputeType real_part = t1[idx] - sign_t2 * t2[idx];
+      ComputeType imag_part = t3 - t1[idx] - sign_t2 * t2[idx];
+
+      complex<ScalarType> acc{
+        ScalarType(initial_accum.real() + real_part),
+        ScalarType(initial_accum.imag() + imag_part)
+      };
+
+      ComplexC d_ij = tensor_c.at(coord);
+
+      complex<ScalarType> src{
+        ScalarType(d_ij.real()),
+        ScalarType(d_ij.imag())
+      };
+
+      complex<ScalarType> result = alpha * acc + beta * src;
+
+      d_ij.real() = convert_op(result.real());
+      d_ij.imag() = convert_op(result.imag());
+
+      tensor_d.at(coord) = d_ij;
+    },
+    ComputeType());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -219,6 +351,42 @@ void GemmPlanarComplex(
     complex<ScalarType>());
 }
 
+/// Computes a planar complex GEMM using the 3M (Gaussian) method.
+///
+/// This assumes the accumulator type is the same type as the scalars.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType
+>
+void GemmPlanarComplex(
+  gemm::GemmCoord problem_size,
+  complex<ScalarType> alpha,
+  TensorRefPlanarComplex<ElementA, LayoutA> tensor_a,
+  ComplexTransform transform_a,
+  TensorRefPlanarComplex<ElementB, LayoutB> tensor_b,
+  ComplexTransform transform_b,
+  complex<ScalarType> beta,
+  TensorRefPlanarComplex<ElementC, LayoutC> tensor_c,
+  TensorRefPlanarComplex<ElementC, LayoutC> tensor_d,
+  arch::OpMultiplyAddGaussianComplex op) {
+
+  GemmPlanarComplex(
+    problem_size,
+    alpha,
+    tensor_a, transform_a,
+    tensor_b, transform_b,
+    beta,
+    tensor_c,
+    tensor_d,
+    complex<ScalarType>(),
+    op);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 } // namespace host
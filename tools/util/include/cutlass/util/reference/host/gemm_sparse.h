@@ -0,0 +1,418 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Reference implementation for structured sparse GEMM in host-side code.
+
+    Operand A is consumed in the compressed form used by the sparse tensor core kernels, holding
+    the nonzero half of each row, together with its metadata in the order produced by
+    reorder_meta(). Pruned elements of A are skipped rather than multiplied by zero.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "cutlass/coord.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/functional.h"
+#include "cutlass/numeric_conversion.h"
+
+#include "cutlass/tensor_view.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/arch/mma.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/util/host_reorder.h"
+#include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/detail/gemm_engine.h"
+
+namespace cutlass {
+namespace reference {
+namespace host {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Sparsity structure of operand A, as interpreted by uncompress(). Each 4-bit field of the
+/// metadata holds two 2-bit indices selecting the nonzero elements among kGroup consecutive
+/// elements of a row. Indices address vectors of kVector elements.
+template <typename ElementA>
+struct SparseGemmStructure {
+
+  static int const kBits = sizeof_bits<ElementA>::value;
+
+  static_assert(kBits == 4 || kBits == 8 || kBits == 16 || kBits == 32,
+    "Structured sparsity is defined for 4-bit, 8-bit, 16-bit and 32-bit elements");
+
+  /// Elements of A described by one element of metadata
+  static int const kElementsPerElementE = 256 / kBits;
+
+  /// Elements of A described by one 4-bit field of metadata
+  static int const kGroup = (kBits == 4 ? 8 : (kBits == 32 ? 2 : 4));
+
+  /// Nonzero elements in each group
+  static int const kNonzeros = kGroup / 2;
+
+  /// Elements selected by each index
+  static int const kVector = (kBits == 4 ? 2 : 1);
+};
+
+/// Decodes the metadata of one row of A into the reduction indices of its nonzero elements and
+/// their columns in compressed A, in increasing order of the reduction index. Returns the number
+/// of nonzero elements, which is at most K / 2.
+template <typename ElementA, typename ElementE, typename LayoutE>
+int sparse_gemm_decode_row(
+  int *k_index,
+  int *compressed_index,
+  TensorRef<ElementE, LayoutE> tensor_e,
+  int row,
+  int K) {
+
+  using Structure = SparseGemmStructure<ElementA>;
+
+  int const kGroup = Structure::kGroup;
+  int const kNonzeros = Structure::kNonzeros;
+  int const kVector = Structure::kVector;
+
+  int count = 0;
+
+  for (int c = 0; c < K / Structure::kElementsPerElementE; ++c) {
+
+    ElementE meta = tensor_e.at(reorder_meta_coord<ElementE>(row, c));
+
+    for (int i = 0; i < Structure::kElementsPerElementE; i += kGroup) {
+
+      int e = (meta >> (i / kGroup * 4)) & 0xf;
+      int idx0 = e & 0x3;
+      int idx1 = e >> 2;
+
+      if (kNonzeros == 1) {
+        idx0 = idx0 / 2;
+      }
+
+      int group_begin = c * Structure::kElementsPerElementE + i;
+      int compressed_begin = group_begin / kGroup * kNonzeros;
+
+      for (int ii = 0; ii < kGroup; ii += kVector) {
+
+        int source;
+
+        if (ii == idx0 * kVector) {
+          source = compressed_begin;
+        }
+        else if (ii == idx1 * kVector && kNonzeros != 1) {
+          source = compressed_begin + kVector;
+        }
+        else {
+          continue;
+        }
+
+        for (int v = 0; v < kVector; ++v, ++count) {
+          k_index[count] = group_begin + ii + v;
+          compressed_index[count] = source + v;
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a general matrix product whose operand A has 2:4 structured sparsity (1:2 for 32-bit
+/// and 4:8 for 4-bit elements). 'problem_size' is the extent of the uncompressed problem, so
+/// tensor_a is M-by-K/2 and tensor_e holds the metadata as reordered by reorder_meta(). K must be
+/// a multiple of the elements of A described by one element of metadata.
+///
+/// Terms are accumulated in increasing order of k with the same arithmetic as a dense GEMM of the
+/// uncompressed operand, which produces identical results whenever B is finite and initial_accum
+/// is not -0. Where B holds Inf or NaN, the dense GEMM multiplies it by pruned zeros of A and
+/// produces NaN, whereas pruned elements do not contribute here.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ElementE,
+  typename LayoutE,
+  typename InnerProductOp = multiply_add<ComputeType>,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void compute_sparse_gemm(
+  gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  TensorRef<ElementE, LayoutE> tensor_e,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  TensorRef<ElementC, LayoutC> tensor_d,
+  ComputeType initial_accum) {
+
+  static_assert(
+    LayoutA::kRank == 2 &&
+    LayoutB::kRank == 2 &&
+    LayoutC::kRank == 2, "Tensors must be of rank 2");
+
+  using Microkernel = detail::GemmMicrokernel<ComputeType, InnerProductOp>;
+
+  int const M = problem_size.m();
+  int const N = problem_size.n();
+  int const K = problem_size.k();
+
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+
+  int const kc_max = detail::GemmBlocking<ComputeType>::kK;
+  int const nonzeros_max = K / 2;
+
+  //
+  // Each output tile decodes the metadata of its rows, packs a panel of B and accumulates one row
+  // of A at a time
+  //
+
+  // The dense engine computes small problems with InnerProductOp and larger ones with the inner
+  // kernel selected for this host. Matching its choice keeps the arithmetic of each term equal.
+  typename Microkernel::RowFunction row_function =
+    (int64_t(M) * N * std::max(K, 1) <= detail::GemmBlocking<ComputeType>::kUnblockedVolume) ?
+      &Microkernel::generic_row : Microkernel::get().row_function;
+
+  int const alignment = Microkernel::kRowAlignment;
+
+  auto load_b = detail::GemmOperand<ComputeType, ElementB, LayoutB, true>::make(tensor_b);
+
+  detail::GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp> epilogue{
+    tensor_c, tensor_d, alpha, beta};
+
+  detail::GemmTiling tiling = detail::GemmTiling::make<ComputeType>(M, N, 1, alignment);
+
+  detail::parallel_for(tiling.count(), [&](int64_t tile) {
+
+    int row_begin = int(tile % tiling.tiles_m) * tiling.tile_m;
+    int col_begin = int(tile / tiling.tiles_m) * tiling.tile_n;
+    int row_end = std::min(row_begin + tiling.tile_m, M);
+    int col_end = std::min(col_begin + tiling.tile_n, N);
+
+    int const rows = row_end - row_begin;
+    int const ldm = (col_end - col_begin + alignment - 1) / alignment * alignment;
+
+    // Nonzero elements of the tile's rows of A, converted to the compute type
+    std::vector<int> nonzeros(rows);
+    std::vector<int> k_index(size_t(rows) * nonzeros_max);
+    std::vector<ComputeType> values(size_t(rows) * nonzeros_max);
+    std::vector<int> compressed_index(nonzeros_max);
+
+    detail::GemmOperandCast<ComputeType, ElementA> convert_a;
+
+    for (int i = 0; i < rows; ++i) {
+
+      size_t offset = size_t(i) * nonzeros_max;
+
+      nonzeros[i] = detail::sparse_gemm_decode_row<ElementA>(
+        k_index.data() + offset, compressed_index.data(), tensor_e, row_begin + i, K);
+
+      for (int e = 0; e < nonzeros[i]; ++e) {
+        ElementA a = tensor_a.at(MatrixCoord(row_begin + i, compressed_index[e]));
+        values[offset + e] = convert_a(a);
+      }
+    }
+
+    std::vector<ComputeType> accum(size_t(rows) * ldm, initial_accum);
+    std::vector<ComputeType> packed_b(size_t(ldm) * std::min(K, kc_max));
+    std::vector<int> next(rows, 0);
+
+    for (int k = 0; k < K; k += kc_max) {
+
+      int const kc = std::min(kc_max, K - k);
+
+      // A single strip holds every column of the tile for each k
+      detail::pack_panel(packed_b.data(), load_b, col_begin, col_end, ldm, k, kc);
+
+      for (int i = 0; i < rows; ++i) {
+
+        size_t offset = size_t(i) * nonzeros_max;
+        int const count = nonzeros[i];
+
+        int &e = next[i];
+        for (; e < count && k_index[offset + e] < k + kc; ++e) {
+          row_function(
+            ldm,
+            values[offset + e],
+            packed_b.data() + size_t(k_index[offset + e] - k) * ldm,
+            accum.data() + size_t(i) * ldm);
+        }
+      }
+    }
+
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < col_end - col_begin; ++j) {
+        epilogue(row_begin + i, col_begin + j, accum[size_t(i) * ldm + j]);
+      }
+    }
+  });
+}
+
+/// Computes a general matrix product whose operand A has structured sparsity, updating C in place
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ElementE,
+  typename LayoutE,
+  typename InnerProductOp = multiply_add<ComputeType>,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void compute_sparse_gemm(
+  gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  TensorRef<ElementE, LayoutE> tensor_e,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  ComputeType initial_accum) {
+
+  compute_sparse_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                      ScalarType, ComputeType, ElementE, LayoutE, InnerProductOp, ConvertOp>(
+    problem_size, alpha, tensor_a, tensor_b, tensor_e, beta, tensor_c, tensor_c, initial_accum);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a general matrix product whose operand A has structured sparsity
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ElementE,
+  typename LayoutE,
+  typename InnerProductOp = cutlass::arch::OpMultiplyAdd
+>
+struct SparseGemm;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Partial specialization for multiply-add
+template <typename ElementA, typename LayoutA, typename ElementB,
+          typename LayoutB, typename ElementC, typename LayoutC,
+          typename ScalarType, typename ComputeType,
+          typename ElementE, typename LayoutE>
+struct SparseGemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ScalarType,
+                  ComputeType, ElementE, LayoutE, arch::OpMultiplyAdd> {
+
+  void operator()(gemm::GemmCoord problem_size, ScalarType alpha,
+                  TensorRef<ElementA, LayoutA> tensor_a,
+                  TensorRef<ElementB, LayoutB> tensor_b,
+                  TensorRef<ElementE, LayoutE> tensor_e, ScalarType beta,
+                  TensorRef<ElementC, LayoutC> tensor_c,
+                  ComputeType initial_accum = ComputeType(0)) {
+
+    compute_sparse_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                        ScalarType, ComputeType, ElementE, LayoutE, multiply_add<ComputeType>>(
+        problem_size, alpha, tensor_a, tensor_b, tensor_e, beta, tensor_c, initial_accum);
+  }
+
+  void operator()(gemm::GemmCoord problem_size, ScalarType alpha,
+                  TensorRef<ElementA, LayoutA> tensor_a,
+                  TensorRef<ElementB, LayoutB> tensor_b,
+                  TensorRef<ElementE, LayoutE> tensor_e, ScalarType beta,
+                  TensorRef<ElementC, LayoutC> tensor_c,
+                  TensorRef<ElementC, LayoutC> tensor_d,
+                  ComputeType initial_accum = ComputeType(0)) {
+
+    compute_sparse_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                        ScalarType, ComputeType, ElementE, LayoutE, multiply_add<ComputeType>>(
+        problem_size, alpha, tensor_a, tensor_b, tensor_e, beta, tensor_c, tensor_d, initial_accum);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Partial specialization for multiply-add-saturate
+template <typename ElementA, typename LayoutA, typename ElementB,
+          typename LayoutB, typename ElementC, typename LayoutC,
+          typename ScalarType, typename ComputeType,
+          typename ElementE, typename LayoutE>
+struct SparseGemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ScalarType,
+                  ComputeType, ElementE, LayoutE, arch::OpMultiplyAddSaturate> {
+
+  void operator()(gemm::GemmCoord problem_size, ScalarType alpha,
+                  TensorRef<ElementA, LayoutA> tensor_a,
+                  TensorRef<ElementB, LayoutB> tensor_b,
+                  TensorRef<ElementE, LayoutE> tensor_e, ScalarType beta,
+                  TensorRef<ElementC, LayoutC> tensor_c,
+                  ComputeType initial_accum = ComputeType(0)) {
+
+    compute_sparse_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                        ScalarType, ComputeType, ElementE, LayoutE, multiply_add<ComputeType>,
+                        NumericConverterClamp<ElementC, ScalarType>>(
+        problem_size, alpha, tensor_a, tensor_b, tensor_e, beta, tensor_c, initial_accum);
+  }
+
+  void operator()(gemm::GemmCoord problem_size, ScalarType alpha,
+                  TensorRef<ElementA, LayoutA> tensor_a,
+                  TensorRef<ElementB, LayoutB> tensor_b,
+                  TensorRef<ElementE, LayoutE> tensor_e, ScalarType beta,
+                  TensorRef<ElementC, LayoutC> tensor_c,
+                  TensorRef<ElementC, LayoutC> tensor_d,
+                  ComputeType initial_accum = ComputeType(0)) {
+
+    compute_sparse_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                        ScalarType, ComputeType, ElementE, LayoutE, multiply_add<ComputeType>,
+                        NumericConverterClamp<ElementC, ScalarType>>(
+        problem_size, alpha, tensor_a, tensor_b, tensor_e, beta, tensor_c, tensor_d, initial_accum);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace host
+} // namespace reference
+} // namespace cutlass
@@ -51,6 +51,37 @@ namespace host {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Interleaves the terms of two matrix products along the reduction. Even indices k load
+/// element k/2 of 'first' and odd indices load element k/2 of 'second'.
+template <typename ComputeType, typename First, typename Second>
+struct Rank2KInterleavedOperand {
+
+  First first;
+  Second second;
+
+  ComputeType operator()(int idx, int k) const {
+    return (k & 1) ? second(idx, k >> 1) : first(idx, k >> 1);
+  }
+};
+
+/// Skips output tiles which lie entirely outside the triangle of a rank 2k update
+template <FillMode kFillMode>
+struct Rank2KTileBounds {
+
+  GemmTileBounds operator()(int row_begin, int row_end, int col_begin, int col_end, int K) const {
+    bool active = (kFillMode == FillMode::kLower ?
+      (row_end - 1 >= col_begin) : (row_begin <= col_end - 1));
+
+    return GemmTileBounds{active, 0, K};
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
 template <
@@ -96,74 +127,35 @@ void compute_rank2k(
   int const N = problem_size.n();
   int const K = problem_size.k();
 
-  // Blocking necessary to speedup reference implementation
-  int const Nblock = 16;
-
-  ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-  CompareOp compare_op;
-
-  for (int row_block = 0; row_block < N; row_block += Nblock) {
-    for (int col_block = 0; col_block < N; col_block += Nblock) {
-
-      ComputeType accum[Nblock][Nblock];
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Nblock; i++) {
-          accum[i][j] = initial_accum;
-        }
+  using OperandA = detail::GemmOperand<ComputeType, ElementA, LayoutA, false>;
+  using OperandB = detail::GemmOperand<ComputeType, ElementB, LayoutB, false>;
+
+  // A * B^T + B * A^T is computed as a single product with a reduction of length 2K, whose terms
+  // alternate between the two products.
+  detail::Rank2KInterleavedOperand<
+    ComputeType, typename OperandA::Type, typename OperandB::Type> interleaved_a{
+      OperandA::make(tensor_a), OperandB::make(tensor_b)};
+
+  detail::Rank2KInterleavedOperand<
+    ComputeType, typename OperandB::Type, typename OperandA::Type> interleaved_b{
+      OperandB::make(tensor_b), OperandA::make(tensor_a)};
+
+  // Only tiles intersecting the triangle of C are computed
+  detail::gemm_engine<ComputeType, InnerProductOp>(
+    N, N, 2 * K,
+    interleaved_a,
+    interleaved_b,
+    [&](int row, int col, ComputeType const &accum) {
+      if (CompareOp()(row, col)) {
+        ConvertOp convert_op;
+        MatrixCoord coord = MatrixCoord(row, col);
+        tensor_d.at(coord) = convert_op(
+          alpha * ScalarType(accum) +
+          beta * ScalarType(tensor_c.at(coord)));
       }
-
-      for (int k_block = 0; k_block < K; ++k_block) {
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Nblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
-
-            if (row < N && col < N && compare_op(row, col)) 
-            {
-
-              // A x B^T
-              ElementA a = tensor_a.at(MatrixCoord(row, k_block));
-              ElementB b_t = tensor_b.at(MatrixCoord(col, k_block));
-
-              ComputeType compute_a(cast_if_scalar<ComputeType>(a));
-              ComputeType compute_b_t(cast_if_scalar<ComputeType>(b_t));
-
-              accum[i][j] = inner_product_op(compute_a, compute_b_t, accum[i][j]);
-
-              // B x A^T
-              ElementB b = tensor_b.at(MatrixCoord(row, k_block));
-              ElementA a_t = tensor_a.at(MatrixCoord(col, k_block));
-
-              ComputeType compute_b(cast_if_scalar<ComputeType>(b));
-              ComputeType compute_a_t(cast_if_scalar<ComputeType>(a_t));
-
-              accum[i][j] = inner_product_op(compute_b, compute_a_t, accum[i][j]);
-            }
-          }
-        }
-      }
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Nblock; i++) {
-          int row = row_block + i;
-          int col = col_block + j;
-
-          MatrixCoord coord = MatrixCoord(row, col);
-
-          if (row < N && col < N && 
-              ( (FillModeC == FillMode::kLower && row >= col) || 
-                (FillModeC == FillMode::kUpper && row <= col) )
-          ) {
-            tensor_d.at(coord) = convert_op(
-              alpha * ScalarType(accum[i][j]) +
-              beta * ScalarType(tensor_c.at(coord)));
-          }
-        }
-      }
-    }
-  }
+    },
+    initial_accum,
+    detail::Rank2KTileBounds<FillModeC>());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +52,30 @@ namespace host {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Loads the symmetric operand of a SYMM. Elements of the triangle selected by CompareOp are read
+/// from memory, and elements of the opposite triangle are read from their mirror image. The
+/// symmetric matrix is operand A of a left-side SYMM, addressed as (row, k), and operand B of a
+/// right-side SYMM, addressed as (column, k).
+template <typename ComputeType, typename Load, typename CompareOp, bool kTransposed>
+struct SymmSymmetricOperand {
+
+  /// Loads element (row, column) of the stored triangle
+  Load load;
+
+  ComputeType operator()(int idx, int k) const {
+    int row = (kTransposed ? k : idx);
+    int col = (kTransposed ? idx : k);
+
+    return CompareOp()(row, col) ? load(row, col) : load(col, row);
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
 template <
@@ -93,7 +117,6 @@ void compute_symm(
     "Fill Mode can either be Lower or Upper.");
 
   using CompareOp_w_diag =  typename TrMatrixCompareOp<FillModeA, DiagType::kNonUnit>::Type;
-  using CompareOp_wo_diag = typename TrMatrixCompareOp<FillModeA, DiagType::kZero>::Type;
 
   // Note: batch is ignored.
   int const M = problem_size.m();
@@ -101,89 +124,30 @@ void compute_symm(
   // Assuming correct k-dimension value is passed
   int const K = problem_size.k();
 
-  // Blocking necessary to speedup reference implementation
-  int const Mblock = 16;
-  int const Nblock = 16;
-
-  ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-  CompareOp_w_diag compare_op_1;
-  CompareOp_wo_diag compare_op_2;
-
-  for (int row_block = 0; row_block < M; row_block += Mblock) {
-    for (int col_block = 0; col_block < N; col_block += Nblock) {
-
-      ComputeType accum[Mblock][Nblock];
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          accum[i][j] = initial_accum;
-        }
-      }
-
-      for (int k_block = 0; k_block < K; ++k_block) {
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
-
-            if (row < M && col < N) {
-              ElementA a_1 = ElementA();
-              ElementB b_1 = ElementB();
-              ElementA a_2 = ElementA();
-              ElementB b_2 = ElementB();
-
-              // A x B or B x A (with diagonal)
-              if (SideModeA == SideMode::kLeft) {
-                a_1 = (compare_op_1(row, k_block)) ? 
-                      (tensor_a.at(MatrixCoord(row, k_block))) : ElementA();
-                b_1 = tensor_b.at(MatrixCoord(k_block, col));
-              } else if (SideModeA == SideMode::kRight) {
-                a_1 = tensor_b.at(MatrixCoord(row, k_block));
-                b_1 = (compare_op_1(k_block, col)) ? 
-                      tensor_a.at(MatrixCoord(k_block, col)) : ElementA();
-              }
-
-              ComputeType compute_a_1(cast_if_scalar<ComputeType>(a_1));
-              ComputeType compute_b_1(cast_if_scalar<ComputeType>(b_1));
-
-              accum[i][j] = inner_product_op(compute_a_1, compute_b_1, accum[i][j]);
-
-              // A^T x B or B x A^T (without diagonal)
-              if (SideModeA == SideMode::kLeft) {
-                a_2 = (compare_op_2(k_block, row)) ? 
-                      (tensor_a.at(MatrixCoord(k_block, row))) : ElementA();
-                b_2 = tensor_b.at(MatrixCoord(k_block, col));
-              } else if (SideModeA == SideMode::kRight) {
-                a_2 = tensor_b.at(MatrixCoord(row, k_block));
-                b_2 = (compare_op_2(col, k_block)) ? 
-                      tensor_a.at(MatrixCoord(col, k_block)) : ElementA();
-              }
-
-              ComputeType compute_a_2(cast_if_scalar<ComputeType>(a_2));
-              ComputeType compute_b_2(cast_if_scalar<ComputeType>(b_2));
-
-              accum[i][j] = inner_product_op(compute_a_2, compute_b_2, accum[i][j]);
-            }
-          }
-        }
-      }
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          int row = row_block + i;
-          int col = col_block + j;
-
-          MatrixCoord coord = MatrixCoord(row, col);
-
-          if (row < M && col < N) {
-            tensor_d.at(coord) = convert_op(
-              alpha * ScalarType(accum[i][j]) +
-              beta * ScalarType(tensor_c.at(coord)));
-          }
-        }
-      }
-    }
+  // The symmetric matrix is operand A on the left side and operand B on the right side
+  static bool const kLeft = (SideModeA == SideMode::kLeft);
+
+  using OperandStored = detail::GemmOperand<ComputeType, ElementA, LayoutA, false>;
+  using OperandGeneral = detail::GemmOperand<ComputeType, ElementB, LayoutB, kLeft>;
+
+  using Symmetric = detail::SymmSymmetricOperand<
+    ComputeType, typename OperandStored::Type, CompareOp_w_diag, !kLeft>;
+
+  // Each element of the symmetric matrix contributes a single product to the reduction, read
+  // either from the stored triangle or from its mirror image.
+  Symmetric symmetric{OperandStored::make(tensor_a)};
+  typename OperandGeneral::Type general = OperandGeneral::make(tensor_b);
+
+  detail::GemmEpilogue<ElementC, LayoutC, ScalarType, ConvertOp> epilogue{
+    tensor_c, tensor_d, alpha, beta};
+
+  if (kLeft) {
+    detail::gemm_engine<ComputeType, InnerProductOp>(
+      M, N, K, symmetric, general, epilogue, initial_accum);
+  }
+  else {
+    detail::gemm_engine<ComputeType, InnerProductOp>(
+      M, N, K, general, symmetric, epilogue, initial_accum);
   }
 }
 
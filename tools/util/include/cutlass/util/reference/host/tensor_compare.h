@@ -35,15 +35,25 @@
 #pragma once
 
 // Standard Library includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 // Cutlass includes
 #include "cutlass/cutlass.h"
+#include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/relatively_equal.h"
 #include "cutlass/tensor_view.h"
 #include "cutlass/tensor_view_planar_complex.h"
 
 #include "cutlass/util/distribution.h"
 //#include "cutlass/util/type_traits.h"
+#include "cutlass/util/reference/host/detail/compare_array.h"
+#include "cutlass/util/reference/host/detail/pack_array.h"
 #include "tensor_foreach.h"
 
 namespace cutlass {
@@ -55,46 +65,177 @@ namespace host {
 
 namespace detail {
 
-template <
-  typename Element,               ///< Element type
-  typename Layout>                ///< Layout function
-struct TensorEqualsFunc {
+/// Number of elements compared by a thread between checks for mismatches found by other threads
+static int64_t const kTensorCompareBlock = (int64_t(1) << 16);
 
-  //
-  // Data members
-  //
+/// Mismatch of elements which are not equal
+template <typename Element>
+struct TensorNotEqualFunc {
 
-  TensorView<Element, Layout> lhs;
-  TensorView<Element, Layout> rhs;
-  bool result;
+  bool operator()(Element const &lhs, Element const &rhs) const {
+    return lhs != rhs;
+  }
 
-  /// Ctor
-  TensorEqualsFunc(): result(true) { }
+  /// Returns the index of the first mismatch of contiguous arrays in [begin, end), or 'end'
+  int64_t find(Element const *lhs, Element const *rhs, int64_t begin, int64_t end) const {
+    return find(lhs, rhs, begin, end,
+      std::integral_constant<bool, PackArrayElement<Element>::kSubbyte>());
+  }
 
-  /// Ctor
-  TensorEqualsFunc(
-    TensorView<Element, Layout> const &lhs_,
-    TensorView<Element, Layout> const &rhs_
-  ) :
-    lhs(lhs_), rhs(rhs_), result(true) { }
+  int64_t find(
+    Element const *lhs, Element const *rhs, int64_t begin, int64_t end, std::false_type) const {
 
-  /// Visits a coordinate
-  void operator()(Coord<Layout::kRank> const &coord) {
+    return begin + find_mismatch(lhs + begin, rhs + begin, end - begin);
+  }
 
-    Element lhs_ = lhs.at(coord);
-    Element rhs_ = rhs.at(coord);
-    
-    if (lhs_ != rhs_) {
-      result = false;
-    }  
+  /// Compares the bytes holding sub-byte elements and the elements of partial bytes one at a time
+  int64_t find(
+    Element const *lhs, Element const *rhs, int64_t begin, int64_t end, std::true_type) const {
+
+    int64_t const kPerByte = 8 / sizeof_bits<Element>::value;
+
+    auto element_find = [&](int64_t i, int64_t last) {
+      for (; i < last; ++i) {
+        if (Element(ReferenceFactory<Element>::get(lhs, i)) !=
+            Element(ReferenceFactory<Element>::get(rhs, i))) {
+          break;
+        }
+      }
+      return i;
+    };
+
+    int64_t first = std::min(end, (begin + kPerByte - 1) / kPerByte * kPerByte);
+    int64_t i = element_find(begin, first);
+
+    if (i < first) {
+      return i;
+    }
+
+    int64_t bytes = (end - first) / kPerByte;
+    i = first + kPerByte * find_mismatch(
+      reinterpret_cast<uint8_t const *>(lhs) + first / kPerByte,
+      reinterpret_cast<uint8_t const *>(rhs) + first / kPerByte,
+      bytes);
+
+    return element_find(i, end);
   }
+};
 
-  /// Returns true if equal
-  operator bool() const {
-    return result;
+/// Mismatch of elements which are not relatively equal
+template <typename Element>
+struct TensorNotRelativelyEqualFunc {
+
+  Element epsilon;
+  Element nonzero_floor;
+
+  bool operator()(Element const &lhs, Element const &rhs) const {
+    return !relatively_equal(lhs, rhs, epsilon, nonzero_floor);
+  }
+
+  /// Returns the index of the first mismatch of contiguous arrays in [begin, end), or 'end'
+  int64_t find(Element const *lhs, Element const *rhs, int64_t begin, int64_t end) const {
+    for (int64_t i = begin; i < end; ++i) {
+      if ((*this)(
+          Element(ReferenceFactory<Element>::get(lhs, i)),
+          Element(ReferenceFactory<Element>::get(rhs, i)))) {
+        return i;
+      }
+    }
+    return end;
+  }
+};
+
+/// Magnitude of the difference of two elements
+template <typename Element>
+double tensor_compare_error(Element const &lhs, Element const &rhs) {
+  return std::abs(double(lhs) - double(rhs));
+}
+
+template <typename T>
+double tensor_compare_error(complex<T> const &lhs, complex<T> const &rhs) {
+  return std::hypot(double(lhs.real()) - double(rhs.real()), double(lhs.imag()) - double(rhs.imag()));
+}
+
+/// Returns true if two views of equal extent may be compared as contiguous arrays
+template <typename Element, typename Layout>
+bool tensor_compare_packed(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs) {
+
+  return (sizeof_bits<Element>::value == int(sizeof(Element)) * 8 ||
+      PackArrayElement<Element>::kSubbyte) &&
+    int64_t(lhs.capacity()) == int64_t(lhs.size()) &&
+    int64_t(rhs.capacity()) == int64_t(rhs.size()) &&
+    lhs.stride() == rhs.stride();
+}
+
+/// Records whether any element in a range of coordinates mismatches
+template <typename Element, typename Layout, typename Mismatch>
+struct TensorFindMismatchFunc {
+
+  TensorView<Element, Layout> lhs;
+  TensorView<Element, Layout> rhs;
+  Mismatch mismatch;
+  bool found;
+
+  TensorFindMismatchFunc(
+    TensorView<Element, Layout> const &lhs_,
+    TensorView<Element, Layout> const &rhs_,
+    Mismatch const &mismatch_
+  ):
+    lhs(lhs_), rhs(rhs_), mismatch(mismatch_), found(false) { }
+
+  void operator()(Coord<Layout::kRank> const &coord) {
+    if (!found && mismatch(lhs.at(coord), rhs.at(coord))) {
+      found = true;
+    }
   }
 };
 
+/// Returns true if no element of 'lhs' mismatches the element of 'rhs' at the same coordinate.
+/// Blocks of elements are compared in parallel, and all threads stop at the first mismatch found.
+template <typename Element, typename Layout, typename Mismatch>
+bool tensor_compare_all(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Mismatch const &mismatch) {
+
+  bool packed = tensor_compare_packed(lhs, rhs);
+  Element const *lhs_ptr = lhs.data();
+  Element const *rhs_ptr = rhs.data();
+
+  std::atomic<bool> found(false);
+
+  parallel_for_range(lhs.size(), kTensorCompareBlock, [&](int64_t begin, int64_t end) {
+
+    for (int64_t block = begin; block < end; block += kTensorCompareBlock) {
+
+      if (found.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      int64_t block_end = std::min(end, block + kTensorCompareBlock);
+      bool block_found;
+
+      if (packed) {
+        block_found = (mismatch.find(lhs_ptr, rhs_ptr, block, block_end) != block_end);
+      }
+      else {
+        TensorFindMismatchFunc<Element, Layout, Mismatch> func(lhs, rhs, mismatch);
+        TensorForEachRange(func, lhs.extent(), block, block_end);
+        block_found = func.found;
+      }
+
+      if (block_found) {
+        found.store(true, std::memory_order_relaxed);
+        return;
+      }
+    }
+  });
+
+  return !found.load();
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -112,13 +253,7 @@ bool TensorEquals(
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> func(lhs, rhs);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
-
-  return bool(func);
+  return detail::tensor_compare_all(lhs, rhs, detail::TensorNotEqualFunc<Element>());
 }
 
 /// Returns true if two tensor views are equal.
@@ -134,31 +269,17 @@ bool TensorEquals(
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> real_func(
-    {lhs.data(), lhs.layout(), lhs.extent()}, 
-    {rhs.data(), rhs.layout(), rhs.extent()}
-  );
-
-  TensorForEach(
-    lhs.extent(),
-    real_func
-  );
+  TensorView<Element, Layout> lhs_real(lhs.data(), lhs.layout(), lhs.extent());
+  TensorView<Element, Layout> rhs_real(rhs.data(), rhs.layout(), rhs.extent());
 
-  if (!bool(real_func)) {
+  if (!TensorEquals(lhs_real, rhs_real)) {
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> imag_func(
-    {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()}, 
-    {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()}
-    );
+  TensorView<Element, Layout> lhs_imag(lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent());
+  TensorView<Element, Layout> rhs_imag(rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent());
 
-  TensorForEach(
-    lhs.extent(),
-    imag_func
-  );
-
-  return bool(imag_func);
+  return TensorEquals(lhs_imag, rhs_imag);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -172,18 +293,7 @@ bool TensorNotEquals(
   TensorView<Element, Layout> const &lhs, 
   TensorView<Element, Layout> const &rhs) {
 
-  // Extents must be identical
-  if (lhs.extent() != rhs.extent()) {
-    return true;
-  }
-
-  detail::TensorEqualsFunc<Element, Layout> func(lhs, rhs);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
-
-  return !bool(func);
+  return !TensorEquals(lhs, rhs);
 }
 
 /// Returns true if two tensor views are equal.
@@ -200,6 +310,186 @@ bool TensorNotEquals(
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Returns true if each element of two tensor views is relatively equal to the other, as defined
+/// by cutlass::relatively_equal().
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+bool TensorRelativelyEquals(
+  TensorView<Element, Layout> const &lhs, 
+  TensorView<Element, Layout> const &rhs,
+  Element epsilon,
+  Element nonzero_floor) {
+
+  // Extents must be identical
+  if (lhs.extent() != rhs.extent()) {
+    return false;
+  }
+
+  detail::TensorNotRelativelyEqualFunc<Element> mismatch;
+  mismatch.epsilon = epsilon;
+  mismatch.nonzero_floor = nonzero_floor;
+
+  return detail::tensor_compare_all(lhs, rhs, mismatch);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Mismatching elements of two tensors
+template <int Rank>
+struct TensorCompareResult {
+
+  /// Number of mismatching elements
+  int64_t mismatch_count;
+
+  /// Largest magnitude of the difference of mismatching elements. NaN if any difference is NaN.
+  double max_error;
+
+  /// Coordinates of the first mismatching elements in lexicographic order
+  std::vector<Coord<Rank> > mismatches;
+
+  TensorCompareResult(): mismatch_count(0), max_error(0) { }
+
+  /// Returns true if no element mismatches
+  bool equal() const {
+    return !mismatch_count;
+  }
+};
+
+namespace detail {
+
+/// Accumulates the mismatches in a range of coordinates
+template <typename Element, typename Layout, typename Mismatch>
+struct TensorCompareFunc {
+
+  TensorView<Element, Layout> lhs;
+  TensorView<Element, Layout> rhs;
+  Mismatch mismatch;
+  int64_t max_mismatches;
+  TensorCompareResult<Layout::kRank> result;
+
+  TensorCompareFunc(
+    TensorView<Element, Layout> const &lhs_,
+    TensorView<Element, Layout> const &rhs_,
+    Mismatch const &mismatch_,
+    int64_t max_mismatches_
+  ):
+    lhs(lhs_), rhs(rhs_), mismatch(mismatch_), max_mismatches(max_mismatches_) { }
+
+  void operator()(Coord<Layout::kRank> const &coord) {
+
+    Element lhs_ = lhs.at(coord);
+    Element rhs_ = rhs.at(coord);
+
+    if (mismatch(lhs_, rhs_)) {
+
+      double error = tensor_compare_error(lhs_, rhs_);
+      if (error > result.max_error || std::isnan(error)) {
+        result.max_error = error;
+      }
+
+      if (result.mismatch_count < max_mismatches) {
+        result.mismatches.push_back(coord);
+      }
+
+      ++result.mismatch_count;
+    }
+  }
+};
+
+/// Compares every element of two views of equal extent. Equal views are recognized by
+/// tensor_compare_all(), and blocks of elements of unequal views are compared in parallel.
+template <typename Element, typename Layout, typename Mismatch>
+TensorCompareResult<Layout::kRank> tensor_compare(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Mismatch const &mismatch,
+  int64_t max_mismatches) {
+
+  TensorCompareResult<Layout::kRank> result;
+
+  if (lhs.extent() != rhs.extent()) {
+    throw std::runtime_error("Tensor extents must match.");
+  }
+
+  if (tensor_compare_all(lhs, rhs, mismatch)) {
+    return result;
+  }
+
+  int64_t count = lhs.size();
+  int64_t blocks = (count + kTensorCompareBlock - 1) / kTensorCompareBlock;
+
+  std::vector<TensorCompareResult<Layout::kRank> > partial(static_cast<size_t>(blocks));
+
+  parallel_for_range(blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t block = begin; block < end; ++block) {
+      TensorCompareFunc<Element, Layout, Mismatch> func(lhs, rhs, mismatch, max_mismatches);
+      TensorForEachRange(
+        func,
+        lhs.extent(),
+        block * kTensorCompareBlock,
+        std::min(count, (block + 1) * kTensorCompareBlock));
+      partial[size_t(block)] = std::move(func.result);
+    }
+  });
+
+  for (TensorCompareResult<Layout::kRank> const &block_result : partial) {
+
+    result.mismatch_count += block_result.mismatch_count;
+
+    if (block_result.max_error > result.max_error || std::isnan(block_result.max_error)) {
+      result.max_error = block_result.max_error;
+    }
+
+    for (Coord<Layout::kRank> const &coord : block_result.mismatches) {
+      if (int64_t(result.mismatches.size()) < max_mismatches) {
+        result.mismatches.push_back(coord);
+      }
+    }
+  }
+
+  return result;
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Compares two tensor views of equal extent and reports their mismatching elements
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+TensorCompareResult<Layout::kRank> TensorCompare(
+  TensorView<Element, Layout> const &lhs, 
+  TensorView<Element, Layout> const &rhs,
+  int64_t max_mismatches = 16) {  ///< maximum number of mismatching coordinates reported
+
+  return detail::tensor_compare(lhs, rhs, detail::TensorNotEqualFunc<Element>(), max_mismatches);
+}
+
+/// Compares two tensor views of equal extent with cutlass::relatively_equal() and reports their
+/// mismatching elements
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+TensorCompareResult<Layout::kRank> TensorCompareRelatively(
+  TensorView<Element, Layout> const &lhs, 
+  TensorView<Element, Layout> const &rhs,
+  Element epsilon,
+  Element nonzero_floor,
+  int64_t max_mismatches = 16) {  ///< maximum number of mismatching coordinates reported
+
+  detail::TensorNotRelativelyEqualFunc<Element> mismatch;
+  mismatch.epsilon = epsilon;
+  mismatch.nonzero_floor = nonzero_floor;
+
+  return detail::tensor_compare(lhs, rhs, mismatch, max_mismatches);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 namespace detail {
 
 template <
@@ -35,10 +35,22 @@
 #pragma once
 
 // Standard Library includes
+#include <algorithm>
+#include <cstdlib>
+#include <type_traits>
 #include <utility>
 
 // Cutlass includes
 #include "cutlass/cutlass.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/numeric_conversion.h"
+#include "cutlass/tensor_view.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/pitch_linear.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/util/reference/host/detail/convert_array.h"
+#include "cutlass/util/reference/host/detail/pack_array.h"
+#include "cutlass/util/reference/host/detail/transpose_tile.h"
 #include "tensor_foreach.h"
 
 namespace cutlass {
@@ -76,6 +88,9 @@ struct TensorCopyIf {
   using DstTensorView = TensorView<DstElement, DstLayout>;
   using SrcTensorView = TensorView<SrcElement, SrcLayout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<DstElement>::value >= 8);
+
   //
   // Data members
   //
@@ -103,6 +118,629 @@ struct TensorCopyIf {
   }
 };
 
+/// Layouts whose offsets are linear functions of the coordinate
+template <typename Layout>
+struct TensorCopyLinearLayout {
+  static bool const value = false;
+};
+
+template <> struct TensorCopyLinearLayout<layout::RowMajor> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::ColumnMajor> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::PitchLinear> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::AffineRank2RowMajor> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::AffineRank2ColumnMajor> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::TensorNHWC> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::TensorNCHW> { static bool const value = true; };
+template <> struct TensorCopyLinearLayout<layout::TensorNDHWC> { static bool const value = true; };
+
+template <int Rank>
+struct TensorCopyLinearLayout<layout::AffineRankN<Rank> > {
+  static bool const value = true;
+};
+
+/// Copies which may move the bits of each element unchanged
+template <typename DstElement, typename SrcElement, typename F>
+struct TensorCopyBitwise {
+  static bool const value = false;
+};
+
+template <typename Element>
+struct TensorCopyBitwise<Element, Element, TrivialConvert<Element, Element> > {
+  static bool const value = true;
+};
+
+/// Copies whose functor is a numeric conversion between the element types, which may use the
+/// bulk conversions of convert_array()
+template <typename DstElement, typename SrcElement, typename F>
+struct TensorCopyNumeric {
+  static bool const value = false;
+};
+
+template <typename DstElement, typename SrcElement>
+struct TensorCopyNumeric<DstElement, SrcElement, TrivialConvert<DstElement, SrcElement> > {
+  static bool const value = true;
+};
+
+template <typename DstElement, typename SrcElement, FloatRoundStyle Round>
+struct TensorCopyNumeric<DstElement, SrcElement, NumericConverter<DstElement, SrcElement, Round> > {
+  static bool const value = true;
+};
+
+/// Converts a contiguous row with a transformation functor
+template <typename DstElement, typename SrcElement, typename F>
+void tensor_copy_row(DstElement *dst, SrcElement const *src, int64_t count, F &convert, std::false_type) {
+  for (int64_t i = 0; i < count; ++i) {
+    dst[i] = convert(src[i]);
+  }
+}
+
+/// Converts a contiguous row with the numeric conversion between element types
+template <typename DstElement, typename SrcElement, typename F>
+void tensor_copy_row(DstElement *dst, SrcElement const *src, int64_t count, F &convert, std::true_type) {
+  convert_array(dst, src, count, convert);
+}
+
+/// Minimum number of elements of the tiles of a copy which does not transpose
+static int64_t const kTensorCopyRowTile = 4096;
+
+/// Edge length of the square tiles of a copy which transposes
+static int const kTensorCopyTransposeTile = 32;
+
+/// Cache-blocked copy between tensors of possibly different layouts. The index space is
+/// partitioned into tiles spanning the dimensions of unit stride in the destination and the
+/// source, and tiles are copied by the host threads.
+template <
+  typename DstElement,
+  typename DstLayout,
+  typename SrcElement,
+  typename SrcLayout,
+  typename F
+>
+struct TensorCopyBlocked {
+
+  static int const kRank = DstLayout::kRank;
+
+  static bool const kLinear =
+    TensorCopyLinearLayout<DstLayout>::value && TensorCopyLinearLayout<SrcLayout>::value;
+
+  using TensorCoord = typename DstLayout::TensorCoord;
+
+  using Bitwise = std::integral_constant<bool, TensorCopyBitwise<DstElement, SrcElement, F>::value>;
+
+  using Numeric = std::integral_constant<bool, TensorCopyNumeric<DstElement, SrcElement, F>::value>;
+
+  //
+  // Data members
+  //
+
+  TensorView<DstElement, DstLayout> dst;
+  TensorView<SrcElement, SrcLayout> src;
+  F const &convert;
+
+  Coord<kRank> extent;
+  int64_t dst_stride[kRank];
+  int64_t src_stride[kRank];
+
+  int dim_row;            ///< dimension of unit stride in the source, or of the second smallest
+                          ///  destination stride if it is the same as dim_col
+  int dim_col;            ///< dimension of unit stride in the destination
+  int tile_rows;
+  int tile_cols;
+  int64_t tiles_row;
+  int64_t tiles_col;
+  int64_t tile_count;
+
+  //
+  // Methods
+  //
+
+  /// Offsets of unit coordinates, which are the strides of a linear layout
+  template <typename Layout>
+  static void measure_strides(Layout const &layout, int64_t *stride) {
+    typename Layout::TensorCoord coord;
+    for (int i = 0; i < kRank; ++i) {
+      coord[i] = 0;
+    }
+    int64_t origin = int64_t(layout(coord));
+    for (int i = 0; i < kRank; ++i) {
+      coord[i] = 1;
+      stride[i] = int64_t(layout(coord)) - origin;
+      coord[i] = 0;
+    }
+  }
+
+  /// Dimension of smallest stride magnitude among those of extent greater than one, excluding 'skip'
+  int fastest_dimension(int64_t const *stride, int skip) const {
+    int dim = -1;
+    for (int i = kRank - 1; i >= 0; --i) {
+      if (i == skip || extent[i] <= 1) {
+        continue;
+      }
+      if (dim < 0 || std::abs(stride[i]) < std::abs(stride[dim])) {
+        dim = i;
+      }
+    }
+    return dim;
+  }
+
+  TensorCopyBlocked(
+    TensorView<DstElement, DstLayout> const &dst_,
+    TensorView<SrcElement, SrcLayout> const &src_,
+    F const &convert_
+  ):
+    dst(dst_), src(src_), convert(convert_) {
+
+    for (int i = 0; i < kRank; ++i) {
+      extent[i] = std::max(std::min(dst.extent()[i], src.extent()[i]), 0);
+    }
+
+    measure_strides(dst.layout(), dst_stride);
+    measure_strides(src.layout(), src_stride);
+
+    dim_col = std::max(fastest_dimension(dst_stride, -1), 0);
+    dim_row = fastest_dimension(src_stride, -1);
+
+    if (dim_row < 0 || dim_row == dim_col) {
+
+      // Tiles are runs of consecutive elements of the destination
+      dim_row = fastest_dimension(dst_stride, dim_col);
+      if (dim_row < 0) {
+        dim_row = (dim_col + 1) % kRank;
+      }
+
+      tile_cols = int(std::min<int64_t>(std::max(extent[dim_col], 1), kTensorCopyRowTile));
+      tile_rows = int(std::min<int64_t>(std::max(extent[dim_row], 1), kTensorCopyRowTile / tile_cols));
+    }
+    else {
+      tile_rows = kTensorCopyTransposeTile;
+      tile_cols = kTensorCopyTransposeTile;
+    }
+
+    tiles_row = (extent[dim_row] + tile_rows - 1) / tile_rows;
+    tiles_col = (extent[dim_col] + tile_cols - 1) / tile_cols;
+
+    tile_count = tiles_row * tiles_col;
+    for (int i = 0; i < kRank; ++i) {
+      if (i != dim_row && i != dim_col) {
+        tile_count *= extent[i];
+      }
+    }
+  }
+
+  /// Copies tiles [begin, end)
+  void operator()(int64_t begin, int64_t end) const {
+
+    F convert_op(convert);
+
+    for (int64_t tile = begin; tile < end; ++tile) {
+
+      // Tiles are numbered with the destination column fastest
+      TensorCoord coord;
+      int64_t residual = tile;
+
+      coord[dim_col] = int((residual % tiles_col) * tile_cols);
+      residual /= tiles_col;
+      coord[dim_row] = int((residual % tiles_row) * tile_rows);
+      residual /= tiles_row;
+
+      for (int i = kRank - 1; i >= 0; --i) {
+        if (i != dim_row && i != dim_col) {
+          coord[i] = int(residual % extent[i]);
+          residual /= extent[i];
+        }
+      }
+
+      int rows = std::min(tile_rows, extent[dim_row] - coord[dim_row]);
+      int cols = std::min(tile_cols, extent[dim_col] - coord[dim_col]);
+
+      copy_tile(coord, rows, cols, convert_op, std::integral_constant<bool, kLinear>());
+    }
+  }
+
+  /// Copies a tile of layouts with arbitrary offsets one element at a time
+  void copy_tile(TensorCoord coord, int rows, int cols, F &convert_op, std::false_type) const {
+
+    int row_begin = coord[dim_row];
+    int col_begin = coord[dim_col];
+
+    for (int i = 0; i < rows; ++i) {
+      coord[dim_row] = row_begin + i;
+      for (int j = 0; j < cols; ++j) {
+        coord[dim_col] = col_begin + j;
+        dst.at(coord) = convert_op(src.at(coord));
+      }
+    }
+  }
+
+  /// Transposes a tile of unconverted elements
+  static void copy_transposed(
+    DstElement *dst_ptr, int64_t ldd, SrcElement const *src_ptr, int64_t lds,
+    int rows, int cols, F &, std::true_type) {
+
+    transpose_tile(dst_ptr, ldd, src_ptr, lds, rows, cols);
+  }
+
+  /// Transposes and converts a tile
+  static void copy_transposed(
+    DstElement *dst_ptr, int64_t ldd, SrcElement const *src_ptr, int64_t lds,
+    int rows, int cols, F &convert_op, std::false_type) {
+
+    convert_transposed(dst_ptr, ldd, src_ptr, lds, rows, cols, convert_op, Numeric());
+  }
+
+  /// Transposes a tile into a local buffer and converts its rows in bulk
+  static void convert_transposed(
+    DstElement *dst_ptr, int64_t ldd, SrcElement const *src_ptr, int64_t lds,
+    int rows, int cols, F &convert_op, std::true_type) {
+
+    SrcElement buffer[kTensorCopyTransposeTile * kTensorCopyTransposeTile];
+
+    transpose_tile(buffer, kTensorCopyTransposeTile, src_ptr, lds, rows, cols);
+
+    for (int i = 0; i < rows; ++i) {
+      convert_array(dst_ptr + i * ldd, buffer + i * kTensorCopyTransposeTile, cols, convert_op);
+    }
+  }
+
+  /// Transposes and converts a tile one element at a time
+  static void convert_transposed(
+    DstElement *dst_ptr, int64_t ldd, SrcElement const *src_ptr, int64_t lds,
+    int rows, int cols, F &convert_op, std::false_type) {
+
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        dst_ptr[i * ldd + j] = convert_op(src_ptr[j * lds + i]);
+      }
+    }
+  }
+
+  /// Copies a tile of linear layouts
+  void copy_tile(TensorCoord const &coord, int rows, int cols, F &convert_op, std::true_type) const {
+
+    DstElement *dst_ptr = dst.data() + dst.layout()(coord);
+    SrcElement const *src_ptr = src.data() + src.layout()(coord);
+
+    int64_t dst_row = dst_stride[dim_row];
+    int64_t dst_col = dst_stride[dim_col];
+    int64_t src_row = src_stride[dim_row];
+    int64_t src_col = src_stride[dim_col];
+
+    if (dst_col == 1 && src_col == 1) {
+      for (int i = 0; i < rows; ++i) {
+        tensor_copy_row(dst_ptr + i * dst_row, src_ptr + i * src_row, cols, convert_op, Numeric());
+      }
+    }
+    else if (dst_col == 1 && src_row == 1) {
+      copy_transposed(dst_ptr, dst_row, src_ptr, src_col, rows, cols, convert_op, Bitwise());
+    }
+    else {
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+          dst_ptr[i * dst_row + j * dst_col] = convert_op(src_ptr[i * src_row + j * src_col]);
+        }
+      }
+    }
+  }
+};
+
+/// Conversions of ranges of elements of which either type is a packed sub-byte integer
+enum class TensorCopyPackedKind {
+  kGeneric,           ///< unpacks, converts each element and packs
+  kCopy,              ///< copies the storage of equal types
+  kPack,              ///< packs int8_t or uint8_t modulo 2^Bits
+  kPackSaturate,      ///< packs int8_t or uint8_t with saturation
+  kUnpack             ///< unpacks to the unpacked type of the source
+};
+
+template <typename T, bool = PackArrayElement<T>::kSubbyte>
+struct TensorCopyUnpacked {
+  using type = void;
+};
+
+template <typename T>
+struct TensorCopyUnpacked<T, true> {
+  using type = typename PackArrayElement<T>::Unpacked;
+};
+
+template <typename T>
+struct TensorCopyPackedInteger {
+  static bool const value = false;
+};
+
+template <int Bits, bool Signed>
+struct TensorCopyPackedInteger<integer_subbyte<Bits, Signed> > {
+  static bool const value = true;
+};
+
+template <typename DstElement, typename SrcElement, typename F>
+struct TensorCopySaturate {
+  static bool const value = false;
+};
+
+template <typename DstElement, typename SrcElement>
+struct TensorCopySaturate<DstElement, SrcElement, NumericConverterClamp<DstElement, SrcElement> > {
+  static bool const value = true;
+};
+
+/// Selects the conversion of ranges of packed elements for a copy functor
+template <typename DstElement, typename SrcElement, typename F>
+struct TensorCopyPacked {
+
+  static bool const kNumeric = TensorCopyNumeric<DstElement, SrcElement, F>::value;
+
+  static bool const kFromBytes = TensorCopyPackedInteger<DstElement>::value &&
+    (std::is_same<SrcElement, int8_t>::value || std::is_same<SrcElement, uint8_t>::value);
+
+  static TensorCopyPackedKind const kKind =
+    (kNumeric && PackArrayElement<DstElement>::kSubbyte &&
+      std::is_same<DstElement, SrcElement>::value) ?
+      TensorCopyPackedKind::kCopy :
+    (kNumeric && kFromBytes) ?
+      TensorCopyPackedKind::kPack :
+    (TensorCopySaturate<DstElement, SrcElement, F>::value && kFromBytes) ?
+      TensorCopyPackedKind::kPackSaturate :
+    (kNumeric && std::is_same<DstElement, typename TensorCopyUnpacked<SrcElement>::type>::value) ?
+      TensorCopyPackedKind::kUnpack :
+      TensorCopyPackedKind::kGeneric;
+
+  using Kind = std::integral_constant<TensorCopyPackedKind, kKind>;
+};
+
+/// Elements of a range of a source array, unpacked if they are sub-byte integers
+template <typename Element, bool Packed = PackArrayElement<Element>::kSubbyte>
+struct TensorCopyPackedSource {
+
+  Element const *ptr;
+
+  TensorCopyPackedSource(Element const *ptr_, int64_t): ptr(ptr_) { }
+
+  Element operator[](int64_t i) const {
+    return ptr[i];
+  }
+};
+
+template <typename Element>
+struct TensorCopyPackedSource<Element, true> {
+
+  using Traits = PackArrayElement<Element>;
+
+  typename Traits::Unpacked buffer[kPackArrayChunk];
+
+  TensorCopyPackedSource(Element const *ptr, int64_t count) {
+    unpack_array(buffer, ptr, count);
+  }
+
+  Element operator[](int64_t i) const {
+    return Traits::element(buffer[i]);
+  }
+};
+
+/// Elements of a range of a destination array, packed when stored if they are sub-byte integers
+template <typename Element, bool Packed = PackArrayElement<Element>::kSubbyte>
+struct TensorCopyPackedDestination {
+
+  Element *ptr;
+
+  TensorCopyPackedDestination(Element *ptr_, int64_t): ptr(ptr_) { }
+
+  void set(int64_t i, Element x) {
+    ptr[i] = x;
+  }
+
+  void store() { }
+};
+
+template <typename Element>
+struct TensorCopyPackedDestination<Element, true> {
+
+  using Traits = PackArrayElement<Element>;
+
+  typename Traits::Unpacked buffer[kPackArrayChunk];
+  Element *ptr;
+  int64_t count;
+
+  TensorCopyPackedDestination(Element *ptr_, int64_t count_): ptr(ptr_), count(count_) { }
+
+  void set(int64_t i, Element x) {
+    buffer[i] = Traits::value(x);
+  }
+
+  void store() {
+    pack_array<false>(ptr, buffer, count);
+  }
+};
+
+/// Converts at most kPackArrayChunk elements one at a time
+template <typename DstElement, typename SrcElement, typename F>
+void convert_packed_range(
+  DstElement *dst, SrcElement const *src, int64_t count, F &convert,
+  std::integral_constant<TensorCopyPackedKind, TensorCopyPackedKind::kGeneric>) {
+
+  TensorCopyPackedSource<SrcElement> source(src, count);
+  TensorCopyPackedDestination<DstElement> destination(dst, count);
+
+  for (int64_t i = 0; i < count; ++i) {
+    destination.set(i, convert(source[i]));
+  }
+
+  destination.store();
+}
+
+/// Copies the bytes holding sub-byte elements and the elements of a final partial byte
+template <typename DstElement, typename SrcElement, typename F>
+void convert_packed_range(
+  DstElement *dst, SrcElement const *src, int64_t count, F &,
+  std::integral_constant<TensorCopyPackedKind, TensorCopyPackedKind::kCopy>) {
+
+  int64_t const kPerByte = 8 / sizeof_bits<DstElement>::value;
+  int64_t bytes = count / kPerByte;
+
+  std::memcpy(dst, src, size_t(bytes));
+
+  typename PackArrayElement<DstElement>::Unpacked tail[8];
+  unpack_array(tail, packed_array_advance(src, bytes * kPerByte), count - bytes * kPerByte);
+  pack_array<false>(packed_array_advance(dst, bytes * kPerByte), tail, count - bytes * kPerByte);
+}
+
+template <typename DstElement, typename SrcElement, typename F>
+void convert_packed_range(
+  DstElement *dst, SrcElement const *src, int64_t count, F &,
+  std::integral_constant<TensorCopyPackedKind, TensorCopyPackedKind::kPack>) {
+
+  pack_array<false>(dst, src, count);
+}
+
+template <typename DstElement, typename SrcElement, typename F>
+void convert_packed_range(
+  DstElement *dst, SrcElement const *src, int64_t count, F &,
+  std::integral_constant<TensorCopyPackedKind, TensorCopyPackedKind::kPackSaturate>) {
+
+  pack_array<true>(dst, src, count);
+}
+
+template <typename DstElement, typename SrcElement, typename F>
+void convert_packed_range(
+  DstElement *dst, SrcElement const *src, int64_t count, F &,
+  std::integral_constant<TensorCopyPackedKind, TensorCopyPackedKind::kUnpack>) {
+
+  unpack_array(dst, src, count);
+}
+
+/// Converts contiguous arrays of which either may hold packed sub-byte integers. Ranges of whole
+/// bytes are converted in parallel.
+template <typename DstElement, typename SrcElement, typename F>
+void convert_packed_array(DstElement *dst, SrcElement const *src, int64_t count, F const &convert) {
+
+  using Kind = typename TensorCopyPacked<DstElement, SrcElement, F>::Kind;
+
+  packed_for_range(count, [&](int64_t begin, int64_t end) {
+
+    F convert_op(convert);
+
+    for (int64_t chunk = begin; chunk < end; chunk += kPackArrayChunk) {
+      convert_packed_range(
+        packed_array_advance(dst, chunk),
+        packed_array_advance(src, chunk),
+        std::min(kPackArrayChunk, end - chunk),
+        convert_op,
+        Kind());
+    }
+  });
+}
+
+/// Returns true if two views map each coordinate to the same offset and cover their storage
+template <typename DstElement, typename SrcElement, typename Layout>
+bool tensor_copy_same_storage(
+  TensorView<DstElement, Layout> const &dst,
+  TensorView<SrcElement, Layout> const &src) {
+
+  return dst.extent() == src.extent() &&
+    dst.stride() == src.stride() &&
+    int64_t(dst.capacity()) == int64_t(dst.size()) &&
+    int64_t(src.capacity()) == int64_t(src.size());
+}
+
+template <typename DstElement, typename DstLayout, typename SrcElement, typename SrcLayout>
+bool tensor_copy_same_storage(
+  TensorView<DstElement, DstLayout> const &,
+  TensorView<SrcElement, SrcLayout> const &) {
+
+  return false;
+}
+
+/// Copies into a view of sub-byte elements through a buffer of unpacked elements
+template <
+  typename DstElement,
+  typename DstLayout,
+  typename SrcElement,
+  typename SrcLayout,
+  typename F
+>
+void tensor_copy_packed(
+  TensorView<DstElement, DstLayout> const &dst,
+  TensorView<SrcElement, SrcLayout> const &src,
+  F const &convert,
+  std::true_type) {
+
+  using Traits = PackArrayElement<DstElement>;
+
+  F convert_op(convert);
+
+  // Elements outside the source keep their value
+  auto update = [&](typename Traits::Unpacked *ptr, Coord<DstLayout::kRank> const &coord) {
+    *ptr = Traits::value(
+      src.contains(coord) ? DstElement(convert_op(src.at(coord))) : DstElement(dst.at(coord)));
+  };
+
+  tensor_update_packed(dst, update);
+}
+
+/// Copies sub-byte elements into a view of byte-addressable elements
+template <
+  typename DstElement,
+  typename DstLayout,
+  typename SrcElement,
+  typename SrcLayout,
+  typename F
+>
+void tensor_copy_packed(
+  TensorView<DstElement, DstLayout> const &dst,
+  TensorView<SrcElement, SrcLayout> const &src,
+  F const &convert,
+  std::false_type) {
+
+  TensorCopyIf<DstElement, DstLayout, SrcElement, SrcLayout, F> copy_if(dst, src, convert);
+  TensorForEach(dst.extent(), copy_if, TensorForEachPolicy::kParallel);
+}
+
+/// Copies between tensor views of byte-addressable elements with a cache-blocked, parallel
+/// traversal. Views of packed sub-byte integers are converted a range of bytes at a time.
+template <
+  typename DstElement,
+  typename DstLayout,
+  typename SrcElement,
+  typename SrcLayout,
+  typename F
+>
+void tensor_copy(
+  TensorView<DstElement, DstLayout> const &dst,
+  TensorView<SrcElement, SrcLayout> const &src,
+  F const &convert) {
+
+  if (PackArrayElement<DstElement>::kSubbyte || PackArrayElement<SrcElement>::kSubbyte) {
+
+    if (tensor_copy_same_storage(dst, src)) {
+      convert_packed_array(dst.data(), src.data(), int64_t(dst.capacity()), convert);
+    }
+    else {
+      tensor_copy_packed(dst, src, convert,
+        std::integral_constant<bool, PackArrayElement<DstElement>::kSubbyte>());
+    }
+    return;
+  }
+
+  if (sizeof_bits<DstElement>::value < 8 || sizeof_bits<SrcElement>::value < 8 || DstLayout::kRank < 2) {
+
+    TensorCopyIf<DstElement, DstLayout, SrcElement, SrcLayout, F> copy_if(dst, src, convert);
+    TensorForEach(dst.extent(), copy_if, TensorForEachPolicy::kParallel);
+    return;
+  }
+
+  TensorCopyBlocked<DstElement, DstLayout, SrcElement, SrcLayout, F> copy(dst, src, convert);
+
+  int64_t tile_volume = int64_t(copy.tile_rows) * copy.tile_cols;
+
+  if (copy.tile_count * tile_volume < kTensorForEachSerialVolume) {
+    copy(0, copy.tile_count);
+  }
+  else {
+    parallel_for_range(
+      copy.tile_count,
+      std::max<int64_t>(kTensorForEachMinChunk / tile_volume, 1),
+      copy);
+  }
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -120,16 +758,7 @@ void TensorCopy(
   TensorView<SrcElement, SrcLayout> src,
   F const &transform) {
 
-  using CopyIf = detail::TensorCopyIf<
-    DstElement,
-    DstLayout,
-    SrcElement,
-    SrcLayout,
-    F>;
-
-  CopyIf copy_if(dst, src, transform);
-
-  TensorForEach(dst.extent(), copy_if);
+  detail::tensor_copy(dst, src, transform);
 }
 
 
@@ -149,18 +778,9 @@ void TensorCopy(
   TensorRef<SrcElement, SrcLayout> src,
   F const &transform) {
 
-  using CopyIf = detail::TensorCopyIf<
-    DstElement,
-    DstLayout,
-    SrcElement,
-    SrcLayout,
-    F>;
-
   TensorView<SrcElement, SrcLayout> src_view(src, dst.extent());
 
-  CopyIf copy_if(dst, src_view, transform);
-
-  TensorForEach(dst.extent(), copy_if);
+  detail::tensor_copy(dst, src_view, transform);
 }
 
 /// Copies elements from a TensorRef into a TensorView. Assumes source tensor has sufficient extent
@@ -177,18 +797,9 @@ void TensorCopy(
   TensorView<SrcElement, SrcLayout> src,
   F const &transform) {
 
-  using CopyIf = detail::TensorCopyIf<
-    DstElement,
-    DstLayout,
-    SrcElement,
-    SrcLayout,
-    F>;
-
   TensorView<DstElement, DstLayout> dst_view(dst, src.extent());
 
-  CopyIf copy_if(dst_view, src, transform);
-
-  TensorForEach(src.extent(), copy_if);
+  detail::tensor_copy(dst_view, src, transform);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -251,6 +862,126 @@ void TensorCopy(
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Converts a block of contiguous elements with the numeric conversion of the given rounding
+/// style. Conversions between float, half_t and bfloat16_t, and from float to tfloat32_t,
+/// float_e4m3_t and float_e5m2_t are vectorized when host SIMD is enabled. Conversions from the
+/// 8-bit floating point types read a table. Blocks of packed sub-byte integers are packed and
+/// unpacked a range of bytes at a time. Tensors of other layouts may be converted with
+/// TensorCopy() and a NumericConverter.
+template <
+  FloatRoundStyle Round = FloatRoundStyle::round_to_nearest,
+  typename DstElement,
+  typename SrcElement
+>
+void BlockConvert(
+  DstElement *dst,                      ///< destination block
+  SrcElement const *src,                ///< source block
+  size_t capacity) {                    ///< number of elements
+
+  NumericConverter<DstElement, SrcElement, Round> convert;
+
+  if (detail::PackArrayElement<DstElement>::kSubbyte || detail::PackArrayElement<SrcElement>::kSubbyte) {
+    detail::convert_packed_array(dst, src, int64_t(capacity), convert);
+    return;
+  }
+
+  if (sizeof_bits<DstElement>::value < 8 || sizeof_bits<SrcElement>::value < 8) {
+    for (size_t i = 0; i < capacity; ++i) {
+      ReferenceFactory<DstElement>::get(dst, int64_t(i)) =
+        convert(SrcElement(ReferenceFactory<SrcElement>::get(src, int64_t(i))));
+    }
+    return;
+  }
+
+  auto convert_range = [&](int64_t begin, int64_t end) {
+    detail::convert_array(dst + begin, src + begin, end - begin, convert);
+  };
+
+  if (int64_t(capacity) < detail::kTensorForEachSerialVolume) {
+    convert_range(0, int64_t(capacity));
+  }
+  else {
+    detail::parallel_for_range(int64_t(capacity), detail::kTensorForEachMinChunk, convert_range);
+  }
+}
+
+/// Splits a block of floats into the big and small tfloat32_t parts of NumericConverterFastF32 in
+/// one pass. The big part rounds the source, and the small part rounds the remainder. Both are
+/// vectorized for all tfloat32_t rounding styles when host SIMD is enabled.
+template <
+  FloatRoundStyle RoundBig = FloatRoundStyle::round_toward_zero,
+  FloatRoundStyle RoundSmall = FloatRoundStyle::round_half_ulp_truncate
+>
+void BlockConvertFastF32(
+  tfloat32_t *big,                      ///< destination block of big parts
+  tfloat32_t *small,                    ///< destination block of small parts
+  float const *src,                     ///< source block
+  size_t capacity) {                    ///< number of elements
+
+  NumericConverterFastF32<RoundBig, RoundSmall> convert;
+
+  auto convert_range = [&](int64_t begin, int64_t end) {
+    detail::convert_array_split(big + begin, small + begin, src + begin, end - begin, convert);
+  };
+
+  if (int64_t(capacity) < detail::kTensorForEachSerialVolume) {
+    convert_range(0, int64_t(capacity));
+  }
+  else {
+    detail::parallel_for_range(int64_t(capacity), detail::kTensorForEachMinChunk, convert_range);
+  }
+}
+
+namespace detail {
+
+/// Splits each element of a tensor into big and small tfloat32_t parts
+template <FloatRoundStyle RoundBig, FloatRoundStyle RoundSmall, typename Layout>
+struct TensorConvertFastF32Func {
+
+  TensorView<tfloat32_t, Layout> big;
+  TensorView<tfloat32_t, Layout> small;
+  TensorView<float, Layout> src;
+
+  TensorConvertFastF32Func(
+    TensorView<tfloat32_t, Layout> const &big_,
+    TensorView<tfloat32_t, Layout> const &small_,
+    TensorView<float, Layout> const &src_
+  ): big(big_), small(small_), src(src_) { }
+
+  void operator()(Coord<Layout::kRank> const &coord) const {
+    Array<tfloat32_t, 2> parts = NumericConverterFastF32<RoundBig, RoundSmall>::convert(src.at(coord));
+    big.at(coord) = parts[0];
+    small.at(coord) = parts[1];
+  }
+};
+
+} // namespace detail
+
+/// Splits a float tensor into the big and small tfloat32_t parts of NumericConverterFastF32 in
+/// one pass. Views of the same extent and stride which cover their storage are converted as
+/// blocks.
+template <
+  FloatRoundStyle RoundBig = FloatRoundStyle::round_toward_zero,
+  FloatRoundStyle RoundSmall = FloatRoundStyle::round_half_ulp_truncate,
+  typename Layout
+>
+void TensorConvertFastF32(
+  TensorView<tfloat32_t, Layout> big,   ///< destination tensor of big parts
+  TensorView<tfloat32_t, Layout> small, ///< destination tensor of small parts
+  TensorView<float, Layout> src) {      ///< source tensor of the same extent
+
+  if (detail::tensor_copy_same_storage(big, src) && detail::tensor_copy_same_storage(small, src)) {
+    BlockConvertFastF32<RoundBig, RoundSmall>(big.data(), small.data(), src.data(), size_t(src.capacity()));
+    return;
+  }
+
+  detail::TensorConvertFastF32Func<RoundBig, RoundSmall, Layout> func(big, small, src);
+
+  TensorForEach(src.extent(), func, TensorForEachPolicy::kParallel);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace host
 } // namespace reference
 } // namespace cutlass
@@ -37,6 +37,7 @@
 // Cutlass includes
 #include "cutlass/cutlass.h"
 #include "cutlass/functional.h"
+#include "cutlass/numeric_types.h"
 
 #include "tensor_foreach.h"
 
@@ -62,6 +63,9 @@ template <
   typename BinaryFunc>
 struct TensorFuncBinaryOp {
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<ElementD>::value >= 8);
+
   //
   // Data members
   //
@@ -129,7 +133,8 @@ void TensorAdd(
 
   TensorForEach(
     d.extent(),
-    func); 
+    func,
+    TensorForEachPolicy::kParallel);
 }
 
 /// Adds a tensor in place: d = d .+ a
@@ -175,7 +180,8 @@ void TensorSub(
 
   TensorForEach(
     d.extent(),
-    func);
+    func,
+    TensorForEachPolicy::kParallel);
 }
 
 /// Subtracts two tensors in place: d = d .- a
@@ -224,7 +230,8 @@ void TensorMul(
 
   TensorForEach(
     d.extent(),
-    func);
+    func,
+    TensorForEachPolicy::kParallel);
 }
 
 /// Multiplies tensors in place: d = d .* a
@@ -270,7 +277,8 @@ void TensorDiv(
 
   TensorForEach(
     d.extent(),
-    func);
+    func,
+    TensorForEachPolicy::kParallel);
 }
 
 /// Divides tensors in place: d = d ./ a
@@ -317,7 +325,8 @@ void TensorModulus(
 
   TensorForEach(
     d.extent(),
-    func);
+    func,
+    TensorForEachPolicy::kParallel);
 }
 
 /// Divides tensors in place: d = d ./ a
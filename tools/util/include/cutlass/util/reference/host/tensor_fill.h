@@ -35,9 +35,11 @@
 #pragma once
 
 // Standard Library includes
+#include <algorithm>
 #include <utility>
 #include <cstdlib>
 #include <cmath>
+#include <type_traits>
 
 // Cutlass includes
 #include "cutlass/cutlass.h"
@@ -51,6 +53,9 @@
 #include "cutlass/blas3.h"
 
 #include "cutlass/util/distribution.h"
+#include "cutlass/util/reference/host/detail/convert_array.h"
+#include "cutlass/util/reference/host/detail/pack_array.h"
+#include "cutlass/util/reference/host/detail/philox.h"
 #include "tensor_foreach.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -71,6 +76,9 @@ struct TensorFillFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -92,25 +100,189 @@ struct TensorFillFunc {
   }
 };
 
+/// Returns the linear index of 'coord' within 'extent'. Random fills draw each element from the
+/// stream with this index, so results do not depend on the order in which elements are visited.
+template <int Rank>
+uint64_t random_stream_index(Coord<Rank> const &coord, Coord<Rank> const &extent) {
+  uint64_t index = 0;
+  for (int i = 0; i < Rank; ++i) {
+    index = index * uint64_t(extent[i]) + uint64_t(coord[i]);
+  }
+  return index;
+}
+
+/// Random fills of half_t and bfloat16_t compute their values in float and convert them in bulk.
+/// Both conversions from double are defined through float, so the values are unchanged.
+template <typename Element>
+struct BlockFillRandomNarrowing {
+  static bool const value = false;
+};
+
+template <>
+struct BlockFillRandomNarrowing<half_t> {
+  static bool const value = true;
+};
+
+template <>
+struct BlockFillRandomNarrowing<bfloat16_t> {
+  static bool const value = true;
+};
+
+/// How random fills write ranges of elements
+enum class BlockFillRandomKind {
+  kElement,           ///< writes each element
+  kNarrowing,         ///< converts values computed in float in bulk
+  kPacked             ///< packs sub-byte integers in bulk
+};
+
+template <typename Element>
+struct BlockFillRandomPath {
+
+  static BlockFillRandomKind const kKind =
+    PackArrayElement<Element>::kSubbyte ? BlockFillRandomKind::kPacked :
+    BlockFillRandomNarrowing<Element>::value ? BlockFillRandomKind::kNarrowing :
+      BlockFillRandomKind::kElement;
+
+  using Kind = std::integral_constant<BlockFillRandomKind, kKind>;
+};
+
+/// Number of elements computed in float before their conversion
+static int64_t const kBlockFillRandomChunk = 256;
+
+/// Writes 'random_func(i)' to elements [begin, end) of a buffer
+template <typename Element, typename RandomFunc>
+void block_fill_random_range(
+  Element *ptr, int64_t begin, int64_t end, RandomFunc const &random_func,
+  std::integral_constant<BlockFillRandomKind, BlockFillRandomKind::kElement>) {
+
+  for (int64_t i = begin; i < end; ++i) {
+    ReferenceFactory<Element>::get(ptr, i) = random_func(uint64_t(i));
+  }
+}
+
+/// Writes 'random_func(i)' to elements [begin, end) of a buffer of half_t or bfloat16_t
+template <typename Element, typename RandomFunc>
+void block_fill_random_range(
+  Element *ptr, int64_t begin, int64_t end, RandomFunc const &random_func,
+  std::integral_constant<BlockFillRandomKind, BlockFillRandomKind::kNarrowing>) {
+
+  float buffer[kBlockFillRandomChunk];
+
+  for (int64_t chunk = begin; chunk < end; chunk += kBlockFillRandomChunk) {
+    int64_t count = std::min(kBlockFillRandomChunk, end - chunk);
+    for (int64_t i = 0; i < count; ++i) {
+      buffer[i] = float(random_func.sample(uint64_t(chunk + i)));
+    }
+    convert_array(ptr + chunk, buffer, count, NumericConverter<Element, float>());
+  }
+}
+
+/// Writes 'random_func(i)' to elements [begin, end) of a buffer of packed sub-byte integers. The
+/// range begins on a byte boundary.
+template <typename Element, typename RandomFunc>
+void block_fill_random_range(
+  Element *ptr, int64_t begin, int64_t end, RandomFunc const &random_func,
+  std::integral_constant<BlockFillRandomKind, BlockFillRandomKind::kPacked>) {
+
+  using Traits = PackArrayElement<Element>;
+
+  typename Traits::Unpacked buffer[kPackArrayChunk];
+
+  for (int64_t chunk = begin; chunk < end; chunk += kPackArrayChunk) {
+    int64_t count = std::min(kPackArrayChunk, end - chunk);
+    for (int64_t i = 0; i < count; ++i) {
+      buffer[i] = Traits::value(random_func(uint64_t(chunk + i)));
+    }
+    pack_array<false>(packed_array_advance(ptr, chunk), buffer, count);
+  }
+}
+
+/// Writes 'random_func(i)' to element i of a buffer, in parallel unless the buffer is small.
+/// Sub-byte elements are written a range of whole bytes at a time.
+template <typename Element, typename RandomFunc>
+void block_fill_random(Element *ptr, size_t capacity, RandomFunc const &random_func) {
+
+  auto fill = [&](int64_t begin, int64_t end) {
+    block_fill_random_range(ptr, begin, end, random_func, typename BlockFillRandomPath<Element>::Kind());
+  };
+
+  if (PackArrayElement<Element>::kSubbyte) {
+    packed_for_range(int64_t(capacity), fill);
+  }
+  else if (sizeof_bits<Element>::value < 8 || int64_t(capacity) < kTensorForEachSerialVolume) {
+    fill(0, int64_t(capacity));
+  }
+  else {
+    parallel_for_range(int64_t(capacity), kTensorForEachMinChunk, fill);
+  }
+}
+
 /// Returns a pair of values of the Gaussian distribution generated by the Box Muller method 
 struct BoxMullerFunc {
 
   BoxMullerFunc() {}
 
   void operator()(
+    PhiloxStream &stream,            ///< Source of uniform random values
     double* rnd,                     ///< Size-2 vector to be filled with random values
     double  mean = 0,                ///< Mean of the Gaussian distribution
     double  stddev = 1,              ///< Standard deviation of the Gaussian distribution
     double  pi = std::acos(-1)) const {
 
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+    double u1 = stream.uniform_double();
+    double u2 = stream.uniform_double();
     rnd[0] = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
     rnd[1] = std::sqrt(-2 * std::log(u1)) * std::sin(2 * pi * u2);
     rnd[0] = mean + stddev * rnd[0];
     rnd[1] = mean + stddev * rnd[1];
   }
 };
+
+/// Fills a view of packed sub-byte integers with 'value'
+template <typename Element, typename Layout>
+void tensor_fill(TensorView<Element, Layout> const &view, Element value, std::true_type) {
+
+  using Traits = PackArrayElement<Element>;
+
+  if (int64_t(view.capacity()) == int64_t(view.size())) {
+    fill_packed_array(view.data(), value, int64_t(view.capacity()));
+    return;
+  }
+
+  typename Traits::Unpacked unpacked = Traits::value(value);
+
+  tensor_update_packed(view, [&](typename Traits::Unpacked *ptr, Coord<Layout::kRank> const &) {
+    *ptr = unpacked;
+  });
+}
+
+/// Fills a view with 'value'
+template <typename Element, typename Layout>
+void tensor_fill(TensorView<Element, Layout> const &view, Element value, std::false_type) {
+
+  TensorFillFunc<Element, Layout> func(view, value);
+
+  TensorForEach(view.extent(), func, TensorForEachPolicy::kParallel);
+}
+
+/// Fills a view of packed sub-byte integers with 'func.element(coord)'
+template <typename Element, typename Layout, typename Func>
+void tensor_fill_random(TensorView<Element, Layout> const &view, Func const &func, std::true_type) {
+
+  using Traits = PackArrayElement<Element>;
+
+  tensor_update_packed(view, [&](typename Traits::Unpacked *ptr, Coord<Layout::kRank> const &coord) {
+    *ptr = Traits::value(func.element(coord));
+  });
+}
+
+/// Fills a view with 'func.element(coord)'
+template <typename Element, typename Layout, typename Func>
+void tensor_fill_random(TensorView<Element, Layout> const &view, Func const &func, std::false_type) {
+
+  TensorForEach(view.extent(), func, TensorForEachPolicy::kParallel);
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -123,12 +295,8 @@ void TensorFill(
   TensorView<Element, Layout> dst,    ///< destination tensor 
   Element val = Element(0)) {               ///< value to uniformly fill it with
 
-  detail::TensorFillFunc<Element, Layout> func(dst, val);
-
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::tensor_fill(
+    dst, val, std::integral_constant<bool, detail::PackArrayElement<Element>::kSubbyte>());
 }
 
 /// Fills a tensor with a uniform value
@@ -155,6 +323,7 @@ struct RandomGaussianFunc {
   double mean;
   double stddev;
   int int_scale;
+  mutable uint64_t next_index;
   double pi;
 
   //
@@ -166,33 +335,37 @@ struct RandomGaussianFunc {
     double stddev_ = 1,
     int int_scale_ = -1
   ):
-    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)) {
-      std::srand((unsigned)seed);
-  }
+    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), next_index(0), pi(std::acos(-1)) { }
 
-  /// Compute random value and update RNG state
-  Element operator()() const {
+  /// Computes the random value of the element with the given index before its conversion
+  double sample(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
 
     // Box-Muller transform to generate random numbers with Normal distribution
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+    double u1 = stream.uniform_double();
+    double u2 = stream.uniform_double();
 
     // Compute Gaussian random value
     double rnd = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
     rnd = mean + stddev * rnd;
 
-    // Scale and convert final result
-    Element result;
-
+    // Scale the result
     if (int_scale >= 0) {
       rnd = double(int64_t(rnd * double(1 << int_scale))) / double(1 << int_scale);
-      result = static_cast<Element>(rnd);
-    }
-    else {
-      result = static_cast<Element>(rnd);
     }
 
-    return result;
+    return rnd;
+  }
+
+  /// Computes the random value of the element with the given index
+  Element operator()(uint64_t index) const {
+    return static_cast<Element>(sample(index));
+  }
+
+  /// Computes the random value of the next element in sequence
+  Element operator()() const {
+    return (*this)(next_index++);
   }
 };
 
@@ -204,6 +377,7 @@ struct RandomGaussianFunc<complex<Element> > {
   double mean;
   double stddev;
   int int_scale;
+  mutable uint64_t next_index;
   double pi;
 
   //
@@ -215,18 +389,18 @@ struct RandomGaussianFunc<complex<Element> > {
     double stddev_ = 1,
     int int_scale_ = -1
   ):
-    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)) {
-      std::srand((unsigned)seed);
-  }
+    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), next_index(0), pi(std::acos(-1)) { }
 
-  /// Compute random value and update RNG state
-  complex<Element> operator()() const {
+  /// Computes the random value of the element with the given index
+  complex<Element> operator()(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
 
     Element reals[2];
 
     double rnd[2];
     detail::BoxMullerFunc func;
-    func(rnd, mean, stddev, pi);
+    func(stream, rnd, mean, stddev, pi);
 
     if (int_scale >= 0) {
       rnd[0] = double(int(rnd[0] * double(1 << int_scale)));
@@ -240,6 +414,11 @@ struct RandomGaussianFunc<complex<Element> > {
 
     return complex<Element>(reals[0], reals[1]);
   }
+
+  /// Computes the random value of the next element in sequence
+  complex<Element> operator()() const {
+    return (*this)(next_index++);
+  }
 };
 
 /// Partial specialization for initializing a complex value.
@@ -250,6 +429,7 @@ struct RandomGaussianFunc<Quaternion<Element> > {
   double mean;
   double stddev;
   int int_scale;
+  mutable uint64_t next_index;
   double pi;
 
   //
@@ -261,20 +441,20 @@ struct RandomGaussianFunc<Quaternion<Element> > {
     double stddev_ = 1,
     int int_scale_ = -1
   ):
-    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)) {
-      std::srand((unsigned)seed);
-  }
+    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), next_index(0), pi(std::acos(-1)) { }
 
-  /// Compute random value and update RNG state
-  Quaternion<Element> operator()() const {
+  /// Computes the random value of the element with the given index
+  Quaternion<Element> operator()(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
 
     Element reals[4];
 
     double rnd1[2];
     double rnd2[2];
     detail::BoxMullerFunc func;
-    func(rnd1, mean, stddev, pi);
-    func(rnd2, mean, stddev, pi);
+    func(stream, rnd1, mean, stddev, pi);
+    func(stream, rnd2, mean, stddev, pi);
 
     if (int_scale >= 0) {
       rnd1[0] = double(int(rnd1[0] * double(1 << int_scale)));
@@ -295,6 +475,11 @@ struct RandomGaussianFunc<Quaternion<Element> > {
 
     return Quaternion<Element>(reals[0], reals[1], reals[2], reals[3]);
   }
+
+  /// Computes the random value of the next element in sequence
+  Quaternion<Element> operator()() const {
+    return (*this)(next_index++);
+  }
 };
 
 /// Computes a random Gaussian distribution
@@ -305,6 +490,9 @@ struct TensorFillGaussianFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -325,9 +513,14 @@ struct TensorFillGaussianFunc {
 
   }
 
+  /// Computes the random value of the element at 'coord'
+  Element element(Coord<Layout::kRank> const &coord) const {
+    return func(random_stream_index(coord, view.extent()));
+  }
+
   /// Compute random value and update RNG state
   void operator()(Coord<Layout::kRank> const &coord) const {
-    view.at(coord) = func();
+    view.at(coord) = element(coord);
   }
 };
 
@@ -339,6 +532,9 @@ struct TensorFillSymmetricGaussianFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -367,11 +563,11 @@ struct TensorFillSymmetricGaussianFunc {
     if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kLower &&
         coord[0] >= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(random_stream_index(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         coord[0] <= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(random_stream_index(coord, view.extent()));
     }
   }
 };
@@ -400,10 +596,8 @@ void TensorFillRandomGaussian(
     random_func
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::tensor_fill_random(
+    dst, func, std::integral_constant<bool, detail::PackArrayElement<Element>::kSubbyte>());
 }
 
 /// Fills a tensor with random values with a Gaussian distribution.
@@ -448,7 +642,8 @@ void TensorFillSymmetricRandomGaussian(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -471,9 +666,7 @@ void BlockFillRandomGaussian(
 
   detail::RandomGaussianFunc<Element> random_func(seed, mean, stddev, bits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ReferenceFactory<Element>::get(ptr, i) = random_func();
-  }
+  detail::block_fill_random(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -491,6 +684,7 @@ struct RandomUniformFunc {
   double range;
   double min;
   int int_scale;
+  mutable uint64_t next_index;
 
   //
   // Methods
@@ -502,31 +696,35 @@ struct RandomUniformFunc {
     double min_ = 0,
     int int_scale_ = -1
   ):
-    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
-    }
+    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_), next_index(0) { }
 
 
-  /// Compute random value and update RNG state
-  Element operator()() const {
+  /// Computes the random value of the element with the given index before its conversion
+  double sample(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
 
-    double rnd = double(std::rand()) / double(RAND_MAX);
+    double rnd = stream.uniform_double();
 
     rnd = min + range * rnd;
 
     // Random values are cast to integer after scaling by a power of two to facilitate error
     // testing
-    Element result;
-    
     if (int_scale >= 0) {
       rnd = double(int64_t(rnd * double(1 << int_scale))) / double(1 << int_scale);
-      result = static_cast<Element>(Real(rnd));
-    }
-    else {
-      result = static_cast<Element>(Real(rnd));
     }
 
-    return result;
+    return rnd;
+  }
+
+  /// Computes the random value of the element with the given index
+  Element operator()(uint64_t index) const {
+    return static_cast<Element>(Real(sample(index)));
+  }
+
+  /// Computes the random value of the next element in sequence
+  Element operator()() const {
+    return (*this)(next_index++);
   }
 };
 
@@ -540,6 +738,7 @@ struct RandomUniformFunc<complex<Element> > {
   double range;
   double min;
   int int_scale;
+  mutable uint64_t next_index;
 
   //
   // Methods
@@ -551,18 +750,18 @@ struct RandomUniformFunc<complex<Element> > {
     double min_ = 0,
     int int_scale_ = -1
   ):
-    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
-    }
+    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_), next_index(0) { }
 
 
-  /// Compute random value and update RNG state
-  complex<Element> operator()() const {
+  /// Computes the random value of the element with the given index
+  complex<Element> operator()(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
 
     Element reals[2];
 
     for (int i = 0; i < 2; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      double rnd = stream.uniform_double();
 
       rnd = min + range * rnd;
 
@@ -580,6 +779,11 @@ struct RandomUniformFunc<complex<Element> > {
 
     return complex<Element>(reals[0], reals[1]);
   }
+
+  /// Computes the random value of the next element in sequence
+  complex<Element> operator()() const {
+    return (*this)(next_index++);
+  }
 };
 
 /// Partial specialization for initializing a Quaternion value.
@@ -592,6 +796,7 @@ struct RandomUniformFunc<Quaternion<Element> > {
   double range;
   double min;
   int int_scale;
+  mutable uint64_t next_index;
 
   //
   // Methods
@@ -603,18 +808,18 @@ struct RandomUniformFunc<Quaternion<Element> > {
     double min_ = 0,
     int int_scale_ = -1
   ):
-    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
-    }
+    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_), next_index(0) { }
 
 
-  /// Compute random value and update RNG state
-  Quaternion<Element> operator()() const {
+  /// Computes the random value of the element with the given index
+  Quaternion<Element> operator()(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
 
     Element reals[4];
 
     for (int i = 0; i < 4; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      double rnd = stream.uniform_double();
 
       rnd = min + range * rnd;
 
@@ -632,6 +837,11 @@ struct RandomUniformFunc<Quaternion<Element> > {
 
     return make_Quaternion(reals[0], reals[1], reals[2], reals[3]);
   }
+
+  /// Computes the random value of the next element in sequence
+  Quaternion<Element> operator()() const {
+    return (*this)(next_index++);
+  }
 };
 
 /// Computes a random uniform distribution
@@ -642,6 +852,9 @@ struct TensorFillRandomUniformFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -662,10 +875,14 @@ struct TensorFillRandomUniformFunc {
 
   }
 
+  /// Computes the random value of the element at 'coord'
+  Element element(Coord<Layout::kRank> const &coord) const {
+    return func(random_stream_index(coord, view.extent()));
+  }
+
   /// Compute random value and update RNG state
   void operator()(Coord<Layout::kRank> const &coord) const {
-
-    view.at(coord) = func();
+    view.at(coord) = element(coord);
   }
 };
 
@@ -677,6 +894,9 @@ struct TensorFillSymmetricRandomUniformFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -705,11 +925,11 @@ struct TensorFillSymmetricRandomUniformFunc {
     if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kLower &&
         coord[0] >= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(random_stream_index(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         coord[0] <= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(random_stream_index(coord, view.extent()));
     }
   }
 };
@@ -722,6 +942,9 @@ struct TensorFillPadDiagonalRandomUniformFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -753,12 +976,12 @@ struct TensorFillPadDiagonalRandomUniformFunc {
         (fill_mode == cutlass::FillMode::kLower) &&
         (coord[0] >= coord[1]) || 
         ((coord[1] - coord[0]) >= alignment)) {
-      view.at(coord) = func();
+      view.at(coord) = func(random_stream_index(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         (coord[0] <= coord[1]) ||
         ((coord[0] - coord[1]) >= alignment)) {
-      view.at(coord) = func();
+      view.at(coord) = func(random_stream_index(coord, view.extent()));
     }
   }
 };
@@ -786,10 +1009,8 @@ void TensorFillRandomUniform(
     random_func
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::tensor_fill_random(
+    dst, func, std::integral_constant<bool, detail::PackArrayElement<Element>::kSubbyte>());
 }
 
 /// Fills a tensor with random values of a uniform random distribution.
@@ -831,7 +1052,8 @@ void TensorFillRandomUniform(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -861,7 +1083,8 @@ void TensorFillSymmetricRandomUniform(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -892,7 +1115,8 @@ void TensorFillPadDiagonalRandomUniform(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -914,9 +1138,7 @@ void BlockFillRandomUniform(
                                           ///  data.                 
   detail::RandomUniformFunc<Element> random_func(seed, max, min, bits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ReferenceFactory<Element>::get(ptr, i) = random_func();
-  }
+  detail::block_fill_random(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -930,6 +1152,9 @@ struct TensorFillDiagonalFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -985,7 +1210,8 @@ void TensorFillDiagonal(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -1033,6 +1259,9 @@ struct TensorUpdateOffDiagonalFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -1086,7 +1315,8 @@ void TensorUpdateOffDiagonal(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -1103,6 +1333,9 @@ struct TensorFillLinearFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -1160,7 +1393,8 @@ void TensorFillLinear(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -1284,7 +1518,6 @@ struct RandomSparseMetaFunc {
     int MetaSizeInBits_ = 2
   ):
     seed(seed_), MetaSizeInBits(MetaSizeInBits_) {
-      std::srand((unsigned)seed);
       if (MetaSizeInBits_ == 2) {
         range = 6;
       } else if (MetaSizeInBits_ == 4) {
@@ -1292,8 +1525,11 @@ struct RandomSparseMetaFunc {
       }
     }
 
-  /// Compute random value and update RNG state
-  Element operator()() const {
+  /// Computes the random value of the element with the given index
+  Element operator()(uint64_t index) const {
+
+    PhiloxStream stream(seed, index);
+
     Element FourToTwoMeta[6] = {0x4, 0x8, 0x9, 0xc, 0xd, 0xe};
     Element TwoToOneMeta[2] = {0x4, 0xe};
 
@@ -1302,7 +1538,7 @@ struct RandomSparseMetaFunc {
     Element result = 0x0;
 
     for (int i = 0; i < cutlass::sizeof_bits<Element>::value / 4; ++i) {
-      int rnd = std::rand() % range;
+      int rnd = int(stream() % uint32_t(range));
       Element meta = MetaArray[rnd];
 
       result = (Element)(result | ((Element)(meta << (i * 4))));
@@ -1320,6 +1556,9 @@ struct TensorFillRandomSparseMetaFunc {
 
   using TensorView = TensorView<Element, Layout>;
 
+  /// Sub-byte elements sharing storage must not be written concurrently
+  static bool const kThreadSafe = (sizeof_bits<Element>::value >= 8);
+
   //
   // Data members
   //
@@ -1343,7 +1582,7 @@ struct TensorFillRandomSparseMetaFunc {
   /// Compute random value and update RNG state
   void operator()(Coord<Layout::kRank> const &coord) const {
 
-    view.at(coord) = func();
+    view.at(coord) = func(random_stream_index(coord, view.extent()));
   }
 };
 
@@ -1369,7 +1608,8 @@ void TensorFillRandomSparseMeta(
 
   TensorForEach(
     dst.extent(),
-    func
+    func,
+    TensorForEachPolicy::kParallel
   );
 }
 
@@ -1387,9 +1627,7 @@ void BlockFillRandomSparseMeta(
 
   detail::RandomSparseMetaFunc<Element> random_func(seed, MetaSizeInBits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ptr[i] = random_func();
-  }
+  detail::block_fill_random(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1404,10 +1642,11 @@ void TensorFillRandomEllIdx(
   uint64_t seed,                                   ///< seed for RNG
   int rows, int ell_cols, int cols) {              ///< dimension of the matrix 
 
-  std::srand((unsigned)seed);
-
   for (int i = 0; i < rows; ++i) {
-    int col_idx = std::rand() % cols;
+
+    detail::PhiloxStream stream(seed, uint64_t(i));
+
+    int col_idx = int(stream() % uint32_t(cols));
    
     for (int j = 0; j < ell_cols; ++j) {
       dst.at({i, j}) = col_idx;
@@ -1416,7 +1655,7 @@ void TensorFillRandomEllIdx(
         if (col_idx == (cols - 1)) {
           col_idx = -1;
         } else {
-          col_idx = std::rand() % (cols - col_idx - 1) + col_idx + 1;
+          col_idx = int(stream() % uint32_t(cols - col_idx - 1)) + col_idx + 1;
         }
       }
     }
@@ -30,8 +30,12 @@
  **************************************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 #include "cutlass/cutlass.h"
+#include "cutlass/coord.h"
+#include "cutlass/util/reference/host/detail/thread_pool.h"
 
 namespace cutlass  {
 namespace reference {
@@ -82,10 +86,83 @@ struct TensorForEachHelper<Func, Rank, 0> {
   }
 };
 
+/// Index spaces with fewer points are visited on the calling thread
+static int64_t const kTensorForEachSerialVolume = (int64_t(1) << 14);
+
+/// Minimum number of points visited by each range of a parallel for-each
+static int64_t const kTensorForEachMinChunk = (int64_t(1) << 12);
+
+/// Functors may declare 'static bool const kThreadSafe = false' if their function call operator
+/// must not be invoked concurrently, for instance because it updates state of the functor or
+/// writes sub-byte elements which share storage with elements visited by other threads.
+template <typename Func, typename Enable = void>
+struct TensorForEachThreadSafe {
+  static bool const value = true;
+};
+
+template <typename T>
+struct TensorForEachVoid {
+  using type = void;
+};
+
+template <typename Func>
+struct TensorForEachThreadSafe<Func, typename TensorForEachVoid<decltype(Func::kThreadSafe)>::type> {
+  static bool const value = Func::kThreadSafe;
+};
+
+/// Visits the points of linear index [begin, end) of an index space in lexicographic order
+template <typename Func, int Rank>
+void TensorForEachRange(
+  Func &func,
+  Coord<Rank> const &extent,
+  int64_t begin,
+  int64_t end) {
+
+  Coord<Rank> coord;
+  int64_t residual = begin;
+
+  for (int rank = Rank - 1; rank >= 0; --rank) {
+    coord[rank] = int(residual % extent.at(rank));
+    residual /= extent.at(rank);
+  }
+
+  int const inner = extent.at(Rank - 1);
+
+  for (int64_t idx = begin; idx < end; ) {
+
+    int64_t run = std::min<int64_t>(end - idx, inner - coord[Rank - 1]);
+
+    for (int64_t i = 0; i < run; ++i) {
+      func(coord);
+      ++coord[Rank - 1];
+    }
+
+    idx += run;
+
+    // Advance the outer ranks
+    coord[Rank - 1] = 0;
+
+    for (int rank = Rank - 2; rank >= 0; --rank) {
+      if (++coord[rank] < extent.at(rank)) {
+        break;
+      }
+      coord[rank] = 0;
+    }
+  }
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Execution of a for-each over the index space of a tensor
+enum class TensorForEachPolicy {
+  kSerial,        ///< visits every point in order on the calling thread
+  kParallel       ///< partitions the index space into contiguous ranges visited by the host threads
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Iterates over the index space of a tensor
 template <
   typename Func,          ///< function applied to each point in a tensor's index space
@@ -108,6 +185,45 @@ void TensorForEachLambda(Coord<Rank> extent, Func func) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Iterates over the index space of a tensor. With TensorForEachPolicy::kParallel, points are
+/// visited concurrently by the host threads, and the function is invoked on the same functor
+/// object from each thread. Small index spaces and functors which are not thread-safe are visited
+/// serially.
+template <
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEach(Coord<Rank> extent, Func & func, TensorForEachPolicy policy) {
+
+  int64_t volume = 1;
+  for (int rank = 0; rank < Rank; ++rank) {
+    volume *= std::max(extent.at(rank), 0);
+  }
+
+  if (policy == TensorForEachPolicy::kSerial ||
+      !detail::TensorForEachThreadSafe<Func>::value ||
+      volume < detail::kTensorForEachSerialVolume) {
+
+    TensorForEach(extent, func);
+    return;
+  }
+
+  detail::parallel_for_range(volume, detail::kTensorForEachMinChunk,
+    [&](int64_t begin, int64_t end) {
+      detail::TensorForEachRange(func, extent, begin, end);
+    });
+}
+
+/// Iterates over the index space of a tensor and calls a C++ lambda, concurrently if 'policy' is
+/// TensorForEachPolicy::kParallel
+template <
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEachLambda(Coord<Rank> extent, Func func, TensorForEachPolicy policy) {
+  TensorForEach(extent, func, policy);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 template <typename Element, typename Func>
 struct BlockForEach {
 
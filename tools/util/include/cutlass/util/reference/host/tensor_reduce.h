@@ -30,13 +30,20 @@
  **************************************************************************************************/
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <vector>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/complex.h"
+#include "cutlass/functional.h"
+#include "cutlass/numeric_conversion.h"
+#include "cutlass/numeric_types.h"
 #include "cutlass/tensor_ref.h"
 
 #include "cutlass/util/reference/detail/linear_to_coordinate.h"
+#include "cutlass/util/reference/host/detail/thread_pool.h"
 #include "cutlass/core_io.h"
 
 namespace cutlass  {
@@ -45,8 +52,264 @@ namespace host {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Transform-reduce operation over the elements of a tensor. This helper allocates the device-side
-/// workspace
+/// Order in which TensorTransformReduce() combines the transformed elements of a tensor
+enum class TensorReducePolicy {
+  kSerial,        ///< folds elements into the identity one at a time in coordinate order
+  kPairwise,      ///< reduces blocks of elements in parallel and combines the partial results
+                  ///  pairwise. ReduceOp must be associative and commutative.
+  kKahan          ///< as kPairwise, with Kahan-compensated blocks if ReduceOp is plus<float> or
+                  ///  plus<double>
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Number of consecutive elements reduced by one block of a pairwise reduction
+static int64_t const kTensorReduceBlock = 512;
+
+/// Minimum number of blocks reduced by each thread
+static int64_t const kTensorReduceMinBlocks = 16;
+
+/// Number of independent accumulators of each block. Interleaving them shortens the dependency
+/// chain of the reduction and permits the compiler to vectorize it.
+static int const kTensorReduceLanes = 8;
+
+/// Selects Kahan summation for floating-point sums
+template <typename ComputeType, typename ReduceOp>
+struct TensorReduceCompensated {
+  static bool const value = false;
+};
+
+template <>
+struct TensorReduceCompensated<float, plus<float> > {
+  static bool const value = true;
+};
+
+template <>
+struct TensorReduceCompensated<double, plus<double> > {
+  static bool const value = true;
+};
+
+/// Accumulates values with 'reduce'
+template <typename ComputeType, typename ReduceOp, bool Compensated = false>
+struct TensorReduceAccumulator {
+
+  ComputeType sum;
+
+  void init(ComputeType x) {
+    sum = x;
+  }
+
+  void add(ReduceOp &reduce, ComputeType x) {
+    sum = reduce(sum, x);
+  }
+
+  ComputeType result() const {
+    return sum;
+  }
+};
+
+/// Accumulates a sum with Kahan's compensation of rounding errors. Once the sum is infinite or
+/// NaN, the compensation is held at zero so that it does not turn an infinite sum into NaN.
+template <typename ComputeType, typename ReduceOp>
+struct TensorReduceAccumulator<ComputeType, ReduceOp, true> {
+
+  ComputeType sum;
+  ComputeType compensation;
+
+  void init(ComputeType x) {
+    sum = x;
+    compensation = ComputeType(0);
+  }
+
+  void add(ReduceOp &, ComputeType x) {
+    ComputeType y = x - compensation;
+    ComputeType t = sum + y;
+    compensation = (std::isfinite(t) ? (t - sum) - y : ComputeType(0));
+    sum = t;
+  }
+
+  ComputeType result() const {
+    return sum;
+  }
+};
+
+/// Visits the elements of a packed tensor in memory order
+template <typename Element, typename ComputeType, typename TransformOp>
+struct TensorReducePackedCursor {
+
+  Element const *ptr;
+  TransformOp transform;
+
+  ComputeType next() {
+    return ComputeType(transform(*ptr++));
+  }
+};
+
+/// Visits the elements of a pair of packed tensors in memory order
+template <typename Element, typename ComputeType, typename TransformOp>
+struct TensorReducePackedPairCursor {
+
+  Element const *ptr_A;
+  Element const *ptr_B;
+  TransformOp transform;
+
+  ComputeType next() {
+    return ComputeType(transform(*ptr_A++, *ptr_B++));
+  }
+};
+
+/// Visits the elements of a tensor in coordinate order, starting from a linear index
+template <typename Element, typename Layout, typename ComputeType, typename TransformOp>
+struct TensorReduceCursor {
+
+  TensorView<Element, Layout> view;
+  typename Layout::TensorCoord coord;
+  TransformOp transform;
+
+  TensorReduceCursor(
+    TensorView<Element, Layout> const &view_,
+    int64_t idx,
+    TransformOp const &transform_
+  ): view(view_), transform(transform_) {
+    cutlass::reference::detail::LinearToCoordinate<Layout::kRank>()(coord, idx, view.extent());
+  }
+
+  ComputeType next() {
+    ComputeType x = ComputeType(transform(view.at(coord)));
+    advance(coord, view.extent());
+    return x;
+  }
+
+  /// Increments a coordinate in the order of LinearToCoordinate
+  static void advance(typename Layout::TensorCoord &coord, typename Layout::TensorCoord const &extent) {
+    for (int i = Layout::kRank - 1; i > 0; --i) {
+      if (++coord[i] < extent[i]) {
+        return;
+      }
+      coord[i] = 0;
+    }
+    ++coord[0];
+  }
+};
+
+/// Visits the elements of a pair of tensors in coordinate order, starting from a linear index
+template <typename Element, typename Layout, typename ComputeType, typename TransformOp>
+struct TensorReducePairCursor {
+
+  TensorView<Element, Layout> view_A;
+  TensorView<Element, Layout> view_B;
+  typename Layout::TensorCoord coord;
+  TransformOp transform;
+
+  TensorReducePairCursor(
+    TensorView<Element, Layout> const &view_A_,
+    TensorView<Element, Layout> const &view_B_,
+    int64_t idx,
+    TransformOp const &transform_
+  ): view_A(view_A_), view_B(view_B_), transform(transform_) {
+    cutlass::reference::detail::LinearToCoordinate<Layout::kRank>()(coord, idx, view_A.extent());
+  }
+
+  ComputeType next() {
+    ComputeType x = ComputeType(transform(view_A.at(coord), view_B.at(coord)));
+    TensorReduceCursor<Element, Layout, ComputeType, TransformOp>::advance(coord, view_A.extent());
+    return x;
+  }
+};
+
+/// Reduces the next 'count' elements of a cursor, count > 0
+template <bool Compensated, typename ComputeType, typename ReduceOp, typename Cursor>
+ComputeType tensor_reduce_block(Cursor cursor, int64_t count, ReduceOp reduce) {
+
+  using Accumulator = TensorReduceAccumulator<ComputeType, ReduceOp, Compensated>;
+
+  if (count < kTensorReduceLanes) {
+    Accumulator accum;
+    accum.init(cursor.next());
+    for (int64_t i = 1; i < count; ++i) {
+      accum.add(reduce, cursor.next());
+    }
+    return accum.result();
+  }
+
+  Accumulator accum[kTensorReduceLanes];
+
+  for (int lane = 0; lane < kTensorReduceLanes; ++lane) {
+    accum[lane].init(cursor.next());
+  }
+
+  int64_t i = kTensorReduceLanes;
+  for (; i + kTensorReduceLanes <= count; i += kTensorReduceLanes) {
+    for (int lane = 0; lane < kTensorReduceLanes; ++lane) {
+      accum[lane].add(reduce, cursor.next());
+    }
+  }
+
+  for (int lane = 0; i < count; ++i, ++lane) {
+    accum[lane].add(reduce, cursor.next());
+  }
+
+  ComputeType partial[kTensorReduceLanes];
+  for (int lane = 0; lane < kTensorReduceLanes; ++lane) {
+    partial[lane] = accum[lane].result();
+  }
+
+  for (int width = kTensorReduceLanes / 2; width > 0; width /= 2) {
+    for (int lane = 0; lane < width; ++lane) {
+      partial[lane] = reduce(partial[lane], partial[lane + width]);
+    }
+  }
+
+  return partial[0];
+}
+
+/// Reduces 'count' > 0 elements in blocks of consecutive elements, reducing blocks in parallel and
+/// combining their results pairwise. The result does not depend on the number of threads.
+/// 'make_cursor(idx)' returns a cursor positioned at linear index 'idx'.
+template <bool Compensated, typename ComputeType, typename ReduceOp, typename MakeCursor>
+ComputeType tensor_reduce_pairwise(int64_t count, ReduceOp const &reduce, MakeCursor const &make_cursor) {
+
+  int64_t blocks = (count + kTensorReduceBlock - 1) / kTensorReduceBlock;
+
+  std::vector<ComputeType> partial(static_cast<size_t>(blocks));
+
+  parallel_for_range(blocks, kTensorReduceMinBlocks, [&](int64_t begin, int64_t end) {
+    for (int64_t block = begin; block < end; ++block) {
+      int64_t idx = block * kTensorReduceBlock;
+      partial[size_t(block)] = tensor_reduce_block<Compensated, ComputeType>(
+        make_cursor(idx), std::min(kTensorReduceBlock, count - idx), reduce);
+    }
+  });
+
+  ReduceOp combine(reduce);
+
+  for (int64_t width = 1; width < blocks; width *= 2) {
+    for (int64_t block = 0; block + width < blocks; block += 2 * width) {
+      partial[size_t(block)] = combine(partial[size_t(block)], partial[size_t(block + width)]);
+    }
+  }
+
+  return partial[0];
+}
+
+/// Returns true if the elements of a view occupy exactly its capacity and may be visited in
+/// memory order
+template <typename Element, typename Layout>
+bool tensor_reduce_packed(TensorView<Element, Layout> const &view) {
+  return sizeof_bits<Element>::value >= 8 && 
+    int64_t(view.capacity()) == int64_t(view.size());
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Transform-reduce operation over the elements of a tensor.
+///
+/// With the kPairwise and kKahan policies, packed views are read in memory order and the
+/// transform and reduce functors are copied to each thread.
 template <
   typename Element,
   typename Layout,
@@ -58,24 +321,54 @@ ComputeType TensorTransformReduce(
   TensorView<Element, Layout> view,
   ComputeType identity,
   ReduceOp reduce,
-  TransformOp transform
+  TransformOp transform,
+  TensorReducePolicy policy = TensorReducePolicy::kSerial
 ) {
 
-  for (int64_t idx = 0; idx < view.size(); ++idx) {
-    typename Layout::TensorCoord coord;
-    cutlass::reference::detail::LinearToCoordinate<Layout::kRank>()(coord, idx, view.extent());
+  using Cursor = detail::TensorReduceCursor<Element, Layout, ComputeType, TransformOp>;
+  using PackedCursor = detail::TensorReducePackedCursor<Element, ComputeType, TransformOp>;
+
+  int64_t count = view.size();
+
+  if (count <= 0) {
+    return identity;
+  }
 
-    if (view.contains(coord)) {
-      Element x = view.at(coord);
-      identity = reduce(identity, transform(x));
+  if (policy == TensorReducePolicy::kSerial) {
+    Cursor cursor(view, 0, transform);
+    for (int64_t idx = 0; idx < count; ++idx) {
+      identity = reduce(identity, cursor.next());
     }
+    return identity;
+  }
+
+  bool const kCompensated = detail::TensorReduceCompensated<ComputeType, ReduceOp>::value;
+
+  ComputeType result;
+
+  if (detail::tensor_reduce_packed(view)) {
+    Element const *ptr = view.data();
+    result = policy == TensorReducePolicy::kKahan ?
+      detail::tensor_reduce_pairwise<kCompensated, ComputeType>(count, reduce,
+        [&](int64_t idx) -> PackedCursor { return PackedCursor{ptr + idx, transform}; }) :
+      detail::tensor_reduce_pairwise<false, ComputeType>(count, reduce,
+        [&](int64_t idx) -> PackedCursor { return PackedCursor{ptr + idx, transform}; });
+  }
+  else {
+    result = policy == TensorReducePolicy::kKahan ?
+      detail::tensor_reduce_pairwise<kCompensated, ComputeType>(count, reduce,
+        [&](int64_t idx) -> Cursor { return Cursor(view, idx, transform); }) :
+      detail::tensor_reduce_pairwise<false, ComputeType>(count, reduce,
+        [&](int64_t idx) -> Cursor { return Cursor(view, idx, transform); });
   }
 
-  return identity;
+  return reduce(identity, result);
 }
 
-/// Transform-reduce operation over the elements of a tensor. This helper allocates the device-side
-/// workspace
+/// Transform-reduce operation over the elements of a pair of tensors.
+///
+/// With the kPairwise and kKahan policies, views packed with the same strides are read in memory
+/// order and the transform and reduce functors are copied to each thread.
 template <
   typename Element,
   typename Layout,
@@ -88,25 +381,55 @@ ComputeType TensorTransformReduce(
   TensorView<Element, Layout> view_B,
   ComputeType identity,
   ReduceOp reduce,
-  TransformOp transform) {
+  TransformOp transform,
+  TensorReducePolicy policy = TensorReducePolicy::kSerial) {
   
   if (view_A.extent() != view_B.extent()) {
     throw std::runtime_error("Tensor extents must match.");
   }
 
-  for (int64_t idx = 0; idx < view_A.size(); ++idx) {
+  using Cursor = detail::TensorReducePairCursor<Element, Layout, ComputeType, TransformOp>;
+  using PackedCursor = detail::TensorReducePackedPairCursor<Element, ComputeType, TransformOp>;
 
-    typename Layout::TensorCoord coord;
-    cutlass::reference::detail::LinearToCoordinate<Layout::kRank>()(coord, idx, view_A.extent());
+  int64_t count = view_A.size();
 
-    if (view_A.contains(coord)) {
-      Element a = view_A.at(coord);
-      Element b = view_B.at(coord);
-      identity = reduce(identity, transform(a, b));
+  if (count <= 0) {
+    return identity;
+  }
+
+  if (policy == TensorReducePolicy::kSerial) {
+    Cursor cursor(view_A, view_B, 0, transform);
+    for (int64_t idx = 0; idx < count; ++idx) {
+      identity = reduce(identity, cursor.next());
     }
+    return identity;
+  }
+
+  bool const kCompensated = detail::TensorReduceCompensated<ComputeType, ReduceOp>::value;
+
+  ComputeType result;
+
+  if (detail::tensor_reduce_packed(view_A) && detail::tensor_reduce_packed(view_B) &&
+      view_A.stride() == view_B.stride()) {
+
+    Element const *ptr_A = view_A.data();
+    Element const *ptr_B = view_B.data();
+
+    result = policy == TensorReducePolicy::kKahan ?
+      detail::tensor_reduce_pairwise<kCompensated, ComputeType>(count, reduce,
+        [&](int64_t idx) -> PackedCursor { return PackedCursor{ptr_A + idx, ptr_B + idx, transform}; }) :
+      detail::tensor_reduce_pairwise<false, ComputeType>(count, reduce,
+        [&](int64_t idx) -> PackedCursor { return PackedCursor{ptr_A + idx, ptr_B + idx, transform}; });
+  }
+  else {
+    result = policy == TensorReducePolicy::kKahan ?
+      detail::tensor_reduce_pairwise<kCompensated, ComputeType>(count, reduce,
+        [&](int64_t idx) -> Cursor { return Cursor(view_A, view_B, idx, transform); }) :
+      detail::tensor_reduce_pairwise<false, ComputeType>(count, reduce,
+        [&](int64_t idx) -> Cursor { return Cursor(view_A, view_B, idx, transform); });
   }
 
-  return identity;
+  return reduce(identity, result);
 }
 
 /// Helper to compute the sum of the elements of a tensor
@@ -124,7 +447,7 @@ ComputeType TensorSum(
   NumericConverter<ComputeType, Element> transform;
 
   return TensorTransformReduce(
-    view, identity, reduce, transform);
+    view, identity, reduce, transform, TensorReducePolicy::kKahan);
 }
 
 /// Helper to compute the sum of the squares of the elements of a tensor
@@ -142,7 +465,7 @@ ComputeType TensorSumSq(
   magnitude_squared<Element, ComputeType> transform;
 
   return TensorTransformReduce(
-    view, identity, reduce, transform);
+    view, identity, reduce, transform, TensorReducePolicy::kKahan);
 }
 
 /// Helper to compute the norm of the elements of a tensor.
@@ -175,7 +498,7 @@ ComputeType TensorSumSqDiff(
   magnitude_squared_difference<Element, ComputeType> transform;
 
   return TensorTransformReduce(
-    view_A, view_B, identity, reduce, transform);
+    view_A, view_B, identity, reduce, transform, TensorReducePolicy::kKahan);
 }
 
 
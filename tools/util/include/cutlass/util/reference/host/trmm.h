@@ -49,6 +49,54 @@ namespace cutlass {
 namespace reference {
 namespace host {
 
+namespace detail {
+
+/// Loads the triangular operand of a TRMM. Elements outside the triangle selected by CompareOp
+/// are zero, and the diagonal of a unit triangular matrix is one. The triangular matrix is operand
+/// A of a left-side TRMM, addressed as (row, k), and operand B of a right-side TRMM, addressed as
+/// (column, k).
+template <typename ComputeType, typename Load, typename CompareOp, DiagType kDiagType, bool kTransposed>
+struct TrmmTriangularOperand {
+
+  Load load;
+
+  ComputeType operator()(int idx, int k) const {
+    int row = (kTransposed ? k : idx);
+    int col = (kTransposed ? idx : k);
+
+    if (kDiagType == DiagType::kUnit && row == col) {
+      return ComputeType(1);
+    }
+    return CompareOp()(row, col) ? load(idx, k) : ComputeType(0);
+  }
+};
+
+/// Restricts the reduction of each output tile of a TRMM to the triangle of its triangular
+/// operand
+template <SideMode kSideMode, FillMode kFillMode>
+struct TrmmTileBounds {
+
+  GemmTileBounds operator()(int row_begin, int row_end, int col_begin, int col_end, int K) const {
+
+    // Rows of a left-side and columns of a right-side triangular operand index the output tile
+    int idx_begin = (kSideMode == SideMode::kLeft ? row_begin : col_begin);
+    int idx_end = (kSideMode == SideMode::kLeft ? row_end : col_end);
+
+    // Nonzero elements satisfy k <= idx for a lower triangular A on the left or an upper
+    // triangular A on the right, and k >= idx otherwise.
+    bool k_below_idx = ((kSideMode == SideMode::kLeft) == (kFillMode == FillMode::kLower));
+
+    if (k_below_idx) {
+      return GemmTileBounds{true, 0, std::min(idx_end, K)};
+    }
+    return GemmTileBounds{true, std::min(idx_begin, K), K};
+  }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a Triangular Matrix Multiplication (tensors of rank=2) pointed to by TensorRef
 /// objects.
 template <
@@ -91,75 +139,34 @@ void compute_trmm(
   int const N = problem_size.n();
   // Assuming correct k-dimension value is passed
   int const K = problem_size.k();
- 
-  // Blocking necessary to speedup reference implementation
-  int const Mblock = 16;
-  int const Nblock = 16;
-
-  ConvertOp convert_op;
-  InnerProductOp inner_product_op;
-  CompareOp compare_op;
-
-  for (int row_block = 0; row_block < M; row_block += Mblock) {
-    for (int col_block = 0; col_block < N; col_block += Nblock) {
-
-      ComputeType accum[Mblock][Nblock];
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          accum[i][j] = initial_accum;
-        }
-      }
-
-      for (int k_block = 0; k_block < K; ++k_block) {
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
-
-            if (row < M && col < N) {
-              ElementA a = ElementA();
-              ElementB b = ElementB();
-
-              if (SideModeA == SideMode::kLeft) {
-                a = (compare_op(row, k_block)) ? 
-                            (tensor_a.at(MatrixCoord(row, k_block))) : ElementA(0);
-                if (row == k_block && DiagTypeA == DiagType::kUnit) {
-                  a = ElementA(1);
-                }
-                b = tensor_b.at(MatrixCoord(k_block, col));
-              } else if (SideModeA == SideMode::kRight) {
-                a = tensor_b.at(MatrixCoord(row, k_block));
-                b = (compare_op(k_block, col)) ? 
-                      tensor_a.at(MatrixCoord(k_block, col)) : ElementA(0);
-                if (k_block == col && DiagTypeA == DiagType::kUnit) {
-                  b = ElementA(1);
-                }
-              }
-                            
-              ComputeType compute_a(cast_if_scalar<ComputeType>(a));
-              ComputeType compute_b(cast_if_scalar<ComputeType>(b));
-
-              accum[i][j] = inner_product_op(compute_a, compute_b, accum[i][j]);
-            }
-          }
-        }
-      }
-
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          int row = row_block + i;
-          int col = col_block + j;
-
-          MatrixCoord coord = MatrixCoord(row, col);
-
-          if (row < M && col < N) {
-            tensor_d.at(coord) = convert_op(
-              alpha * ScalarType(accum[i][j]));
-          }
-        }
-      }
-    }
+
+  // The triangular matrix is operand A on the left side and operand B on the right side
+  static bool const kLeft = (SideModeA == SideMode::kLeft);
+
+  using OperandTriangular = detail::GemmOperand<ComputeType, ElementA, LayoutA, !kLeft>;
+  using OperandGeneral = detail::GemmOperand<ComputeType, ElementB, LayoutB, kLeft>;
+
+  using Triangular = detail::TrmmTriangularOperand<
+    ComputeType, typename OperandTriangular::Type, CompareOp, DiagTypeA, !kLeft>;
+
+  Triangular triangular{OperandTriangular::make(tensor_a)};
+  typename OperandGeneral::Type general = OperandGeneral::make(tensor_b);
+
+  auto epilogue = [&](int row, int col, ComputeType const &accum) {
+    ConvertOp convert_op;
+    tensor_d.at(MatrixCoord(row, col)) = convert_op(alpha * ScalarType(accum));
+  };
+
+  // Only the reduction over the nonzero triangle is computed for each output tile
+  if (kLeft) {
+    detail::gemm_engine<ComputeType, InnerProductOp>(
+      M, N, K, triangular, general, epilogue, initial_accum,
+      detail::TrmmTileBounds<SideModeA, FillModeA>());
+  }
+  else {
+    detail::gemm_engine<ComputeType, InnerProductOp>(
+      M, N, K, general, triangular, epilogue, initial_accum,
+      detail::TrmmTileBounds<SideModeA, FillModeA>());
   }
 }
 